@@ -17,6 +17,7 @@ audio_driver_t audio_null = {
 	NULL,
 	NULL,
 	NULL,
+	NULL,
 };
 
 audio_driver_t *audio_drivers[] = {
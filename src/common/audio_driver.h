@@ -10,6 +10,16 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+typedef struct audio_stats
+{
+	uint32_t frequency;		/* device rate */
+	uint32_t queued;		/* frames written but not played yet */
+	uint32_t target;		/* frames the driver keeps queued before blocking */
+	uint32_t capacity;		/* frames the queue can hold */
+	uint32_t underruns;		/* device asked for more than was queued */
+	uint32_t overruns;		/* writes that did not fit into the queue */
+} audio_stats_t;
+
 typedef struct audio_driver
 {
 	/* Human-readable identifier. */
@@ -27,6 +37,11 @@ typedef struct audio_driver
 	void (*srcOutputBlocking)(void *data, int32_t volume, void *buffer, uint32_t size);
 	void (*outputPannedBlocking)(void *data, int leftvol, int rightvol, void *buffer, uint32_t size);
 	void (*release)(void *data);
+	/* Fills queue statistics of the SRC channel.
+	*
+	* Returns: false if the driver does not queue output itself.
+	**/
+	bool (*stats)(void *data, audio_stats_t *stats);
 } audio_driver_t;
 
 
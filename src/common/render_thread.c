@@ -0,0 +1,152 @@
+/******************************************************************************
+
+	render_thread.c
+
+	Frame Composition Thread
+
+******************************************************************************/
+
+#include "emumain.h"
+#include "thread_driver.h"
+
+#define RENDER_THREAD_STACK		0x10000
+
+
+/******************************************************************************
+	Global Variables
+******************************************************************************/
+
+volatile bool render_thread_active;
+
+
+/******************************************************************************
+	Local Variables
+******************************************************************************/
+
+static void *render_thread;
+static void *render_done;
+static void (*render_execute)(void);
+static volatile int render_quit;
+static int render_busy;
+static int render_pending;		/* submitted frame not synced yet (emulation thread) */
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+/*--------------------------------------------------------
+	Render Thread
+--------------------------------------------------------*/
+
+static int32_t render_update_thread(uint32_t args, void *argp)
+{
+	while (1)
+	{
+		thread_driver->sleepThread(render_thread);
+
+		if (render_quit) break;
+
+		if (__atomic_load_n(&render_busy, __ATOMIC_ACQUIRE))
+		{
+			(*render_execute)();
+			__atomic_store_n(&render_busy, 0, __ATOMIC_RELEASE);
+			thread_driver->signalSema(render_done);
+		}
+	}
+
+	thread_driver->exitThread(render_thread, 0);
+
+	return 0;
+}
+
+
+/******************************************************************************
+	Global Functions
+******************************************************************************/
+
+/*--------------------------------------------------------
+	Start render thread
+--------------------------------------------------------*/
+
+bool render_thread_start(void (*execute)(void))
+{
+	render_execute = execute;
+	render_quit = 0;
+	render_busy = 0;
+	render_pending = 0;
+
+	if ((render_done = thread_driver->createSema()) == NULL)
+	{
+		render_thread_active = false;
+		return false;
+	}
+
+	render_thread = thread_driver->init();
+	if (!thread_driver->createThread(render_thread, "Render thread", render_update_thread, 0x11, RENDER_THREAD_STACK))
+	{
+		thread_driver->free(render_thread);
+		thread_driver->deleteSema(render_done);
+		render_thread = NULL;
+		render_done = NULL;
+		render_thread_active = false;
+		return false;
+	}
+
+	thread_driver->startThread(render_thread);
+	render_thread_active = true;
+
+	return true;
+}
+
+
+/*--------------------------------------------------------
+	Stop render thread
+--------------------------------------------------------*/
+
+void render_thread_stop(void)
+{
+	if (render_thread)
+	{
+		render_thread_sync();
+
+		render_quit = 1;
+		thread_driver->wakeupThread(render_thread);
+		thread_driver->waitThreadEnd(render_thread);
+		thread_driver->deleteThread(render_thread);
+		thread_driver->free(render_thread);
+		thread_driver->deleteSema(render_done);
+		render_thread = NULL;
+		render_done = NULL;
+	}
+	render_thread_active = false;
+}
+
+
+/*--------------------------------------------------------
+	Hand the recorded frame over to the render thread
+--------------------------------------------------------*/
+
+void render_thread_submit(void)
+{
+	render_pending = 1;
+	__atomic_store_n(&render_busy, 1, __ATOMIC_RELEASE);
+	thread_driver->wakeupThread(render_thread);
+}
+
+
+/*--------------------------------------------------------
+	Wait until the submitted frame has been composed
+
+	Every submitted frame posts render_done once, so
+	each one is waited for exactly once.
+--------------------------------------------------------*/
+
+void render_thread_sync(void)
+{
+	if (render_pending)
+	{
+		thread_driver->waitSema(render_done);
+		render_pending = 0;
+	}
+}
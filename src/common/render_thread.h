@@ -0,0 +1,35 @@
+/******************************************************************************
+
+	render_thread.h
+
+	Frame Composition Thread
+
+******************************************************************************/
+
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <stdbool.h>
+
+/*
+	Runs frame composition on a second thread so the CPU emulation of
+	frame N+1 overlaps the drawing of frame N.
+
+	The emulation thread records the frame (see the system's display
+	list), then calls render_thread_submit() once it has been handed
+	over. render_thread_sync() waits until the previous frame has been
+	composed; it must be called before the recorded data is reused and
+	before anything else touches the frame buffer or the texture caches.
+
+	Only CPU composition runs on this thread. Presenting the frame stays
+	on the emulation thread, as video drivers are not thread safe.
+*/
+
+extern volatile bool render_thread_active;
+
+bool render_thread_start(void (*execute)(void));
+void render_thread_stop(void);
+void render_thread_submit(void);
+void render_thread_sync(void);
+
+#endif /* RENDER_THREAD_H */
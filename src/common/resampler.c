@@ -0,0 +1,381 @@
+/******************************************************************************
+
+	resampler.c
+
+	Band-limited Sample Rate Conversion
+
+******************************************************************************/
+
+#include "emumain.h"
+
+#if SOUND_RESAMPLER_TAPS
+
+#include <math.h>
+
+#define RESAMPLER_PHASE_BITS	8
+#define RESAMPLER_PHASES	(1 << RESAMPLER_PHASE_BITS)	/* filter phases between two input samples */
+#define RESAMPLER_FRAC_BITS	(32 - RESAMPLER_PHASE_BITS)
+#define RESAMPLER_CUTOFF	0.90			/* passband edge relative to the lower Nyquist rate */
+#define RESAMPLER_BETA		8.0				/* Kaiser window shape (~80dB stopband) */
+
+/* accumulate 4 taps per step (SSE2 / NEON through GCC vectors) */
+#ifndef RESAMPLER_SIMD
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RESAMPLER_SIMD 1
+#else
+#define RESAMPLER_SIMD 0
+#endif
+#endif
+
+#if (SOUND_RESAMPLER_TAPS & 3)
+#error SOUND_RESAMPLER_TAPS must be a multiple of 4
+#endif
+
+#if RESAMPLER_SIMD
+typedef float RESAMPLER_VEC __attribute__((vector_size(16)));
+#endif
+
+
+/******************************************************************************
+	Local Variables
+******************************************************************************/
+
+static float ALIGN16_DATA filter_coef[RESAMPLER_PHASES + 1][SOUND_RESAMPLER_TAPS];
+static float ALIGN16_DATA filter_delta[RESAMPLER_PHASES][SOUND_RESAMPLER_TAPS];
+
+static float *history[2];
+static int history_length;
+static int history_channels;
+static uint64_t position;		/* 32.32 fixed point, relative to history[] */
+static uint64_t position_step;
+static uint64_t nominal_step;
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+/*--------------------------------------------------------
+	Modified Bessel function of the first kind (order 0)
+--------------------------------------------------------*/
+
+static double bessel_i0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	int k;
+
+	for (k = 1; k < 32; k++)
+	{
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+
+/*--------------------------------------------------------
+	Build Kaiser windowed sinc table
+
+	Row p holds the taps for an output sample p/PHASES
+	past the center input sample; each row has unity DC
+	gain. filter_delta[] is the step to the next row so
+	that the phase can be interpolated.
+--------------------------------------------------------*/
+
+static void build_filter(double cutoff)
+{
+	double x, w, sum;
+	int p, k;
+
+	for (p = 0; p <= RESAMPLER_PHASES; p++)
+	{
+		sum = 0.0;
+
+		for (k = 0; k < SOUND_RESAMPLER_TAPS; k++)
+		{
+			x = (k - (SOUND_RESAMPLER_TAPS / 2 - 1)) - (double)p / RESAMPLER_PHASES;
+
+			w = x / (SOUND_RESAMPLER_TAPS / 2);
+			w = (w <= -1.0 || w >= 1.0) ? 0.0 : bessel_i0(RESAMPLER_BETA * sqrt(1.0 - w * w)) / bessel_i0(RESAMPLER_BETA);
+
+			if (x == 0.0)
+				filter_coef[p][k] = w;
+			else
+				filter_coef[p][k] = w * sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+
+			sum += filter_coef[p][k];
+		}
+
+		for (k = 0; k < SOUND_RESAMPLER_TAPS; k++)
+			filter_coef[p][k] /= sum;
+	}
+
+	for (p = 0; p < RESAMPLER_PHASES; p++)
+		for (k = 0; k < SOUND_RESAMPLER_TAPS; k++)
+			filter_delta[p][k] = filter_coef[p + 1][k] - filter_coef[p][k];
+}
+
+
+/*--------------------------------------------------------
+	Convert float sample to 16bit
+--------------------------------------------------------*/
+
+static inline int16_t resampler_clip(float sample)
+{
+	int32_t val = lrintf(sample);
+
+	Limit(val, MAXOUT, MINOUT);
+	return val;
+}
+
+
+#if RESAMPLER_SIMD
+
+static inline RESAMPLER_VEC resampler_load(const float *p)
+{
+	RESAMPLER_VEC v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline float resampler_sum(RESAMPLER_VEC v)
+{
+	return (v[0] + v[2]) + (v[1] + v[3]);
+}
+
+#endif
+
+
+/*--------------------------------------------------------
+	Filter stereo history at the current position
+--------------------------------------------------------*/
+
+static void resampler_filter_stereo(int16_t *dst, int count)
+{
+	const float *srcL, *srcR, *coef, *delta;
+	float frac;
+	int i, k;
+
+	for (i = 0; i < count; i++)
+	{
+		srcL  = history[0] + (position >> 32);
+		srcR  = history[1] + (position >> 32);
+		coef  = filter_coef[(uint32_t)position >> RESAMPLER_FRAC_BITS];
+		delta = filter_delta[(uint32_t)position >> RESAMPLER_FRAC_BITS];
+		frac  = (float)((uint32_t)position & ((1 << RESAMPLER_FRAC_BITS) - 1)) * (1.0f / (1 << RESAMPLER_FRAC_BITS));
+
+#if RESAMPLER_SIMD
+		{
+			RESAMPLER_VEC c, accL = { 0 }, accR = { 0 };
+
+			for (k = 0; k < SOUND_RESAMPLER_TAPS; k += 4)
+			{
+				c = *(const RESAMPLER_VEC *)&coef[k] + *(const RESAMPLER_VEC *)&delta[k] * frac;
+				accL += c * resampler_load(&srcL[k]);
+				accR += c * resampler_load(&srcR[k]);
+			}
+
+			dst[0] = resampler_clip(resampler_sum(accL));
+			dst[1] = resampler_clip(resampler_sum(accR));
+		}
+#else
+		{
+			float c, accL = 0.0f, accR = 0.0f;
+
+			for (k = 0; k < SOUND_RESAMPLER_TAPS; k++)
+			{
+				c = coef[k] + delta[k] * frac;
+				accL += c * srcL[k];
+				accR += c * srcR[k];
+			}
+
+			dst[0] = resampler_clip(accL);
+			dst[1] = resampler_clip(accR);
+		}
+#endif
+
+		dst += 2;
+		position += position_step;
+	}
+}
+
+
+/*--------------------------------------------------------
+	Filter mono history at the current position
+--------------------------------------------------------*/
+
+static void resampler_filter_mono(int16_t *dst, int count)
+{
+	const float *src, *coef, *delta;
+	float frac;
+	int i, k;
+
+	for (i = 0; i < count; i++)
+	{
+		src   = history[0] + (position >> 32);
+		coef  = filter_coef[(uint32_t)position >> RESAMPLER_FRAC_BITS];
+		delta = filter_delta[(uint32_t)position >> RESAMPLER_FRAC_BITS];
+		frac  = (float)((uint32_t)position & ((1 << RESAMPLER_FRAC_BITS) - 1)) * (1.0f / (1 << RESAMPLER_FRAC_BITS));
+
+#if RESAMPLER_SIMD
+		{
+			RESAMPLER_VEC c, acc = { 0 };
+
+			for (k = 0; k < SOUND_RESAMPLER_TAPS; k += 4)
+			{
+				c = *(const RESAMPLER_VEC *)&coef[k] + *(const RESAMPLER_VEC *)&delta[k] * frac;
+				acc += c * resampler_load(&src[k]);
+			}
+
+			dst[0] = dst[1] = resampler_clip(resampler_sum(acc));
+		}
+#else
+		{
+			float c, acc = 0.0f;
+
+			for (k = 0; k < SOUND_RESAMPLER_TAPS; k++)
+			{
+				c = coef[k] + delta[k] * frac;
+				acc += c * src[k];
+			}
+
+			dst[0] = dst[1] = resampler_clip(acc);
+		}
+#endif
+
+		dst += 2;
+		position += position_step;
+	}
+}
+
+
+/******************************************************************************
+	Global Functions
+******************************************************************************/
+
+/*--------------------------------------------------------
+	Initialize resampler
+--------------------------------------------------------*/
+
+int resampler_init(int in_rate, int out_rate, int channels, int max_input)
+{
+	int i;
+
+	resampler_exit();
+
+	for (i = 0; i < channels; i++)
+	{
+		if ((history[i] = malloc((SOUND_RESAMPLER_TAPS + max_input + 1) * sizeof(float))) == NULL)
+		{
+			resampler_exit();
+			return 0;
+		}
+	}
+
+	history_channels = channels;
+	resampler_set_rate(in_rate, out_rate);
+
+	return 1;
+}
+
+
+/*--------------------------------------------------------
+	Change conversion rate (clears the history)
+--------------------------------------------------------*/
+
+void resampler_set_rate(int in_rate, int out_rate)
+{
+	double cutoff = RESAMPLER_CUTOFF;
+	int i;
+
+	if (out_rate < in_rate)
+		cutoff *= (double)out_rate / in_rate;
+
+	build_filter(cutoff);
+
+	/* first output sample is centered on the first input sample */
+	history_length = SOUND_RESAMPLER_TAPS / 2 - 1;
+	position       = 0;
+	nominal_step   = ((uint64_t)in_rate << 32) / out_rate;
+	position_step  = nominal_step;
+
+	for (i = 0; i < history_channels; i++)
+		memset(history[i], 0, history_length * sizeof(float));
+}
+
+
+/*--------------------------------------------------------
+	Fine tune the rate set by resampler_set_rate()
+	(ppm > 0 gives more output samples per input)
+--------------------------------------------------------*/
+
+void resampler_adjust(int ppm)
+{
+	position_step = nominal_step - (int64_t)nominal_step * ppm / 1000000;
+}
+
+
+/*--------------------------------------------------------
+	Free resampler
+--------------------------------------------------------*/
+
+void resampler_exit(void)
+{
+	free(history[0]);
+	free(history[1]);
+	history[0] = NULL;
+	history[1] = NULL;
+	history_channels = 0;
+}
+
+
+/*--------------------------------------------------------
+	Resample a block (returns output frames)
+--------------------------------------------------------*/
+
+int resampler_process(int32_t **src, int length, int16_t *dst)
+{
+	int i, ch, count, used;
+	float *hist;
+
+	if (!history_channels) return 0;
+
+	for (ch = 0; ch < history_channels; ch++)
+	{
+		hist = history[ch] + history_length;
+
+		for (i = 0; i < length; i++)
+			hist[i] = src[ch][i];
+	}
+	history_length += length;
+
+	/* outputs whose taps are all in the history */
+	count = 0;
+	if (history_length >= SOUND_RESAMPLER_TAPS)
+	{
+		uint64_t last = (uint64_t)(history_length - SOUND_RESAMPLER_TAPS) << 32;
+
+		if (position <= last)
+			count = (int)((last - position) / position_step) + 1;
+	}
+
+	if (history_channels == 2)
+		resampler_filter_stereo(dst, count);
+	else
+		resampler_filter_mono(dst, count);
+
+	/* drop the samples that are behind the filter */
+	used = position >> 32;
+	if (used > history_length) used = history_length;
+
+	for (ch = 0; ch < history_channels; ch++)
+		memmove(history[ch], history[ch] + used, (history_length - used) * sizeof(float));
+
+	history_length -= used;
+	position -= (uint64_t)used << 32;
+
+	return count;
+}
+
+#endif /* SOUND_RESAMPLER_TAPS */
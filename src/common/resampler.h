@@ -0,0 +1,34 @@
+/******************************************************************************
+
+	resampler.h
+
+	Band-limited Sample Rate Conversion
+
+******************************************************************************/
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <stdint.h>
+
+/*
+	Converts the chip output from its native rate to the audio device rate
+	with a polyphase windowed-sinc filter (SOUND_RESAMPLER_TAPS taps, the
+	filter phases are interpolated so any rate ratio can be used).
+
+	resampler_init() sets up the filter; input blocks are up to max_input
+	samples per channel. resampler_set_rate() changes the conversion rate
+	and clears the history, resampler_adjust() fine tunes it (in ppm)
+	without a discontinuity. resampler_process() takes clipped 32-bit samples
+	(channels 1 or 2) and writes interleaved 16-bit stereo, returning the
+	number of output frames. Output lags the input by SOUND_RESAMPLER_TAPS/2
+	input samples.
+*/
+
+int resampler_init(int in_rate, int out_rate, int channels, int max_input);
+void resampler_set_rate(int in_rate, int out_rate);
+void resampler_adjust(int ppm);
+void resampler_exit(void);
+int resampler_process(int32_t **src, int length, int16_t *dst);
+
+#endif /* RESAMPLER_H */
@@ -0,0 +1,408 @@
+/******************************************************************************
+
+	soft_blit.c
+
+	Software Sprite Blitter
+
+******************************************************************************/
+
+#include "emumain.h"
+#include "soft_blit.h"
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+typedef struct soft_blit_span_t
+{
+	int x, y;			// first screen pixel
+	int w, h;			// clipped size
+	int u, v;			// texture position of first pixel (16.16)
+	int du, dv;			// texture step per pixel (16.16, negative if flipped)
+} SPAN;
+
+
+/*------------------------------------------------------------------------
+	Setup one axis (returns clipped length, 0 if nothing to draw)
+------------------------------------------------------------------------*/
+
+static int soft_blit_axis(int *pos, int *tpos, int *step, int p0, int p1, int t0, int t1, int min, int max)
+{
+	int len = p1 - p0;
+	int skip;
+
+	if (len <= 0 || p0 >= max || p1 <= min)
+		return 0;
+
+	*step = ((t1 - t0) << 16) / len;
+
+	// sample at the pixel center: a flipped 16 pixel tile maps to 15..0
+	*tpos = (t0 << 16) + (*step >> 1);
+
+	if (p0 < min)
+	{
+		skip = min - p0;
+		*tpos += skip * *step;
+		p0 = min;
+	}
+	if (p1 > max) p1 = max;
+
+	*pos = p0;
+	return p1 - p0;
+}
+
+
+/*------------------------------------------------------------------------
+	Setup sprite span (returns 0 if sprite is clipped out)
+------------------------------------------------------------------------*/
+
+static int soft_blit_setup(SPAN *s, const RECT *clip, const struct Vertex *v0, const struct Vertex *v1)
+{
+	s->w = soft_blit_axis(&s->x, &s->u, &s->du, v0->x, v1->x, v0->u, v1->u, clip->left, clip->right);
+	if (!s->w) return 0;
+
+	s->h = soft_blit_axis(&s->y, &s->v, &s->dv, v0->y, v1->y, v0->v, v1->v, clip->top, clip->bottom);
+	return s->h;
+}
+
+
+/******************************************************************************
+	Blitter Interface Functions
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Draw sprites from 8bpp texture
+------------------------------------------------------------------------*/
+
+void soft_blit_clut8(uint16_t *frame, const RECT *clip, const uint8_t *tex, const uint16_t *clut, const struct Vertex *vertices, int count)
+{
+	SPAN s;
+	const uint8_t *src;
+	uint16_t *dst, color;
+	int x, y, u, v;
+
+	for (; count >= 2; count -= 2, vertices += 2)
+	{
+		if (!soft_blit_setup(&s, clip, &vertices[0], &vertices[1]))
+			continue;
+
+		dst = &frame[s.y * BUF_WIDTH + s.x];
+		v = s.v;
+
+		if (s.du == 0x10000 || s.du == -0x10000)
+		{
+			// unscaled: walk the texture row directly
+			int step = s.du >> 16;
+
+			for (y = 0; y < s.h; y++, v += s.dv, dst += BUF_WIDTH)
+			{
+				src = &tex[(v >> 16) * BUF_WIDTH + (s.u >> 16)];
+
+				for (x = 0; x < s.w; x++, src += step)
+				{
+					color = clut[*src];
+					if (!(color & SOFT_BLIT_TRANSPARENT)) dst[x] = color;
+				}
+			}
+		}
+		else
+		{
+			for (y = 0; y < s.h; y++, v += s.dv, dst += BUF_WIDTH)
+			{
+				src = &tex[(v >> 16) * BUF_WIDTH];
+
+				for (x = 0, u = s.u; x < s.w; x++, u += s.du)
+				{
+					color = clut[src[u >> 16]];
+					if (!(color & SOFT_BLIT_TRANSPARENT)) dst[x] = color;
+				}
+			}
+		}
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw sprites from 8bpp texture with depth test
+------------------------------------------------------------------------*/
+
+void soft_blit_clut8_zb(uint16_t *frame, uint16_t *zbuffer, const RECT *clip, const uint8_t *tex, const uint16_t *clut, const struct Vertex *vertices, int count)
+{
+	SPAN s;
+	const uint8_t *src;
+	uint16_t *dst, *depth, color, z;
+	int x, y, u, v;
+
+	for (; count >= 2; count -= 2, vertices += 2)
+	{
+		if (!soft_blit_setup(&s, clip, &vertices[0], &vertices[1]))
+			continue;
+
+		dst   = &frame[s.y * BUF_WIDTH + s.x];
+		depth = &zbuffer[s.y * BUF_WIDTH + s.x];
+		z = vertices[0].z;
+		v = s.v;
+
+		for (y = 0; y < s.h; y++, v += s.dv, dst += BUF_WIDTH, depth += BUF_WIDTH)
+		{
+			src = &tex[(v >> 16) * BUF_WIDTH];
+
+			for (x = 0, u = s.u; x < s.w; x++, u += s.du)
+			{
+				color = clut[src[u >> 16]];
+
+				if (!(color & SOFT_BLIT_TRANSPARENT) && z >= depth[x])
+				{
+					dst[x] = color;
+					depth[x] = z;
+				}
+			}
+		}
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Update depth buffer from 8bpp texture (no color output)
+------------------------------------------------------------------------*/
+
+void soft_blit_depth8(uint16_t *zbuffer, const RECT *clip, const uint8_t *tex, const uint16_t *clut, const struct Vertex *vertices, int count)
+{
+	SPAN s;
+	const uint8_t *src;
+	uint16_t *depth, z;
+	int x, y, u, v;
+
+	for (; count >= 2; count -= 2, vertices += 2)
+	{
+		if (!soft_blit_setup(&s, clip, &vertices[0], &vertices[1]))
+			continue;
+
+		depth = &zbuffer[s.y * BUF_WIDTH + s.x];
+		z = vertices[0].z;
+		v = s.v;
+
+		for (y = 0; y < s.h; y++, v += s.dv, depth += BUF_WIDTH)
+		{
+			src = &tex[(v >> 16) * BUF_WIDTH];
+
+			for (x = 0, u = s.u; x < s.w; x++, u += s.du)
+			{
+				if (z >= depth[x] && !(clut[src[u >> 16]] & SOFT_BLIT_TRANSPARENT))
+					depth[x] = z;
+			}
+		}
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw sprites from 16bpp texture
+------------------------------------------------------------------------*/
+
+void soft_blit_rgb16(uint16_t *frame, const RECT *clip, const uint16_t *tex, const struct Vertex *vertices, int count)
+{
+	SPAN s;
+	const uint16_t *src;
+	uint16_t *dst, color;
+	int x, y, u, v;
+
+	for (; count >= 2; count -= 2, vertices += 2)
+	{
+		if (!soft_blit_setup(&s, clip, &vertices[0], &vertices[1]))
+			continue;
+
+		dst = &frame[s.y * BUF_WIDTH + s.x];
+		v = s.v;
+
+		for (y = 0; y < s.h; y++, v += s.dv, dst += BUF_WIDTH)
+		{
+			src = &tex[(v >> 16) * BUF_WIDTH];
+
+			for (x = 0, u = s.u; x < s.w; x++, u += s.du)
+			{
+				color = src[u >> 16];
+				if (!(color & SOFT_BLIT_TRANSPARENT)) dst[x] = color;
+			}
+		}
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Fill rectangle
+------------------------------------------------------------------------*/
+
+void soft_blit_fill(uint16_t *frame, const RECT *rect, uint16_t color)
+{
+	uint16_t *dst = &frame[rect->top * BUF_WIDTH + rect->left];
+	int x, y, w = rect->right - rect->left;
+
+	for (y = rect->top; y < rect->bottom; y++, dst += BUF_WIDTH)
+	{
+		if (!color)
+		{
+			memset(dst, 0, w * sizeof(uint16_t));
+			continue;
+		}
+		for (x = 0; x < w; x++)
+			dst[x] = color;
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Rotate rectangle by 180 degrees
+------------------------------------------------------------------------*/
+
+void soft_blit_flip(uint16_t *frame, const RECT *rect)
+{
+	uint16_t *top = &frame[rect->top * BUF_WIDTH + rect->left];
+	uint16_t *bottom = &frame[(rect->bottom - 1) * BUF_WIDTH + rect->right - 1];
+	uint16_t tmp;
+	int x, w = rect->right - rect->left;
+	int lines = rect->bottom - rect->top;
+
+	while (lines > 1)
+	{
+		for (x = 0; x < w; x++)
+		{
+			tmp = top[x];
+			top[x] = bottom[-x];
+			bottom[-x] = tmp;
+		}
+		top += BUF_WIDTH;
+		bottom -= BUF_WIDTH;
+		lines -= 2;
+	}
+
+	if (lines)
+	{
+		// middle line: reverse in place
+		for (x = 0; x < w / 2; x++)
+		{
+			tmp = top[x];
+			top[x] = top[w - 1 - x];
+			top[w - 1 - x] = tmp;
+		}
+	}
+}
+
+
+/******************************************************************************
+	Tilemap Surface Functions
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Mark all tiles for decoding
+------------------------------------------------------------------------*/
+
+void soft_tilemap_invalidate(SOFT_TILEMAP *map)
+{
+	memset(map->tiles, 0xff, 64 * 64 * sizeof(uint32_t));
+}
+
+
+/*------------------------------------------------------------------------
+	Record tile (returns 1 if it has changed)
+------------------------------------------------------------------------*/
+
+int soft_tilemap_check(SOFT_TILEMAP *map, int col, int row, uint32_t code, uint16_t attr)
+{
+	uint32_t *tile = &map->tiles[((row & 0x3f) << 6) | (col & 0x3f)];
+	uint32_t key = (code << 7) | (attr & 0x7f);
+
+	if (*tile == key) return 0;
+
+	*tile = key;
+	return 1;
+}
+
+
+/*------------------------------------------------------------------------
+	Decode tile into the surface
+------------------------------------------------------------------------*/
+
+void soft_tilemap_decode(SOFT_TILEMAP *map, int col, int row, const uint8_t *src, int pitch, uint16_t attr, int palno)
+{
+	int size = 1 << map->tile_shift;
+	int width = 64 << map->tile_shift;
+	int x, y, step = 1;
+	uint16_t *dst, color = palno << 4;
+	uint32_t tile;
+
+	dst = &map->pixels[(((row & 0x3f) << map->tile_shift) * width) + ((col & 0x3f) << map->tile_shift)];
+
+	if (!src)
+	{
+		for (y = 0; y < size; y++, dst += width)
+			for (x = 0; x < size; x++)
+				dst[x] = 0x0f;
+		return;
+	}
+
+	if (attr & 0x40)
+	{
+		dst += (size - 1) * width;
+		width = -width;
+	}
+	if (attr & 0x20)
+	{
+		dst += size - 1;
+		step = -1;
+	}
+
+	for (y = 0; y < size; y++, src += pitch, dst += width)
+	{
+		const uint32_t *line = (const uint32_t *)src;
+		uint16_t *p = dst;
+
+		for (x = 0; x < size; x += 8, p += step * 8)
+		{
+			tile = *line++;
+			p[step * 0] = color | ((tile >>  0) & 0x0f);
+			p[step * 4] = color | ((tile >>  4) & 0x0f);
+			p[step * 1] = color | ((tile >>  8) & 0x0f);
+			p[step * 5] = color | ((tile >> 12) & 0x0f);
+			p[step * 2] = color | ((tile >> 16) & 0x0f);
+			p[step * 6] = color | ((tile >> 20) & 0x0f);
+			p[step * 3] = color | ((tile >> 24) & 0x0f);
+			p[step * 7] = color | ((tile >> 28) & 0x0f);
+		}
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw scrolled surface through palette
+------------------------------------------------------------------------*/
+
+void soft_tilemap_draw(uint16_t *frame, const RECT *clip, const SOFT_TILEMAP *map, const uint16_t *palette, int scrollx, int scrolly)
+{
+	int mask = (64 << map->tile_shift) - 1;
+	int width = 64 << map->tile_shift;
+	int x, y, sx, w;
+	const uint16_t *src;
+	uint16_t *dst, color;
+
+	for (y = clip->top; y < clip->bottom; y++)
+	{
+		src = &map->pixels[((y + scrolly) & mask) * width];
+		dst = &frame[y * BUF_WIDTH];
+
+		for (x = clip->left; x < clip->right;)
+		{
+			// draw up to the right edge of the surface, then wrap around
+			sx = (x + scrollx) & mask;
+			w = width - sx;
+			if (w > clip->right - x) w = clip->right - x;
+
+			for (; w > 0; w--, x++)
+			{
+				color = palette[src[sx++]];
+				if (!(color & SOFT_BLIT_TRANSPARENT)) dst[x] = color;
+			}
+		}
+	}
+}
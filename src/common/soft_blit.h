@@ -0,0 +1,72 @@
+/******************************************************************************
+
+	soft_blit.h
+
+	Software Sprite Blitter
+
+******************************************************************************/
+
+#ifndef SOFT_BLIT_H
+#define SOFT_BLIT_H
+
+#include <stdint.h>
+#include "video_driver.h"
+
+/*
+	Draws the same 2-vertex sprite lists the PSP/PS2 back ends send to the
+	GPU into a 16bpp frame, for targets without a usable blitter (desktop).
+
+	All frames and textures are BUF_WIDTH pixels wide. Each pair of
+	vertices is one sprite: x/y are the screen corners, u/v the texture
+	corners (u0 > u1 or v0 > v1 flips the sprite). Sprites are scaled to
+	the screen size with nearest-neighbour sampling, as on the GPU.
+
+	A pixel whose color has bit 15 set (SOFT_BLIT_TRANSPARENT) is not drawn.
+	This is the pen the drivers already mark for the PSP alpha test.
+
+	soft_blit_clut8:    8bpp texture through a 256 color CLUT. One call
+	                    draws a whole batch sharing the same CLUT.
+	soft_blit_clut8_zb: same, with depth test: a pixel is drawn if the
+	                    vertex z is >= the stored depth, which is then
+	                    updated (sceGuDepthFunc(GU_GEQUAL) with depth writes).
+	soft_blit_depth8:   depth test and update only, the frame is not touched
+	                    (masking sprites that are drawn and then erased).
+	soft_blit_rgb16:    16bpp direct color texture.
+	soft_blit_fill:     fill rectangle (also used to clear the depth buffer).
+	soft_blit_flip:     rotate rectangle by 180 degrees in place.
+
+	soft_tilemap_*:     wrap-around surface of a 64x64 tile scroll layer
+	                    holding the palette index (palette << 4 | pen) of
+	                    each pixel. A tile is decoded only when its code or
+	                    attribute changes, and the surface is drawn through
+	                    the palette, so palette writes need no redraw.
+	                    soft_tilemap_check records the tile and returns 1 if
+	                    it has to be decoded (src is 4bpp tile data, NULL
+	                    for a blank tile, attr bits 0x20/0x40 flip it).
+*/
+
+#define SOFT_BLIT_TRANSPARENT	0x8000
+
+#define SOFT_TILEMAP_BLANK		0xfffff		// code of a tile without opaque pixels
+#define SOFT_TILEMAP_INVALID	0xffffffff
+
+typedef struct soft_tilemap_t
+{
+	uint16_t *pixels;		// (64 << tile_shift) pixels square
+	uint32_t *tiles;		// 64x64 keys of the decoded tiles
+	int tile_shift;			// 3, 4 or 5 (8x8, 16x16 or 32x32 tiles)
+} SOFT_TILEMAP;
+
+void soft_blit_clut8(uint16_t *frame, const RECT *clip, const uint8_t *tex, const uint16_t *clut, const struct Vertex *vertices, int count);
+void soft_blit_clut8_zb(uint16_t *frame, uint16_t *zbuffer, const RECT *clip, const uint8_t *tex, const uint16_t *clut, const struct Vertex *vertices, int count);
+void soft_blit_depth8(uint16_t *zbuffer, const RECT *clip, const uint8_t *tex, const uint16_t *clut, const struct Vertex *vertices, int count);
+void soft_blit_rgb16(uint16_t *frame, const RECT *clip, const uint16_t *tex, const struct Vertex *vertices, int count);
+void soft_blit_fill(uint16_t *frame, const RECT *rect, uint16_t color);
+void soft_blit_flip(uint16_t *frame, const RECT *rect);
+
+void soft_tilemap_invalidate(SOFT_TILEMAP *map);
+int  soft_tilemap_check(SOFT_TILEMAP *map, int col, int row, uint32_t code, uint16_t attr);
+void soft_tilemap_decode(SOFT_TILEMAP *map, int col, int row, const uint8_t *src, int pitch, uint16_t attr, int palno);
+void soft_tilemap_draw(uint16_t *frame, const RECT *clip, const SOFT_TILEMAP *map, const uint16_t *palette, int scrollx, int scrolly);
+
+#endif /* SOFT_BLIT_H */
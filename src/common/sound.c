@@ -10,6 +10,15 @@
 #include "thread_driver.h"
 #include "audio_driver.h"
 
+/* the sound thread follows the emulated frames and the resampling rate holds the audio queue */
+#define RATE_CONTROL	(SOUND_RATE_CONTROL && SOUND_RESAMPLER_TAPS)
+
+#if SOUND_EMU_THREAD
+#define SOUND_BLOCKS	4	/* rendered frames the emulation thread may run ahead of the device */
+#else
+#define SOUND_BLOCKS	2
+#endif
+
 
 /******************************************************************************
 	Local Variables
@@ -19,11 +28,27 @@ static volatile int sound_active;
 static void *sound_thread;
 static int sound_volume;
 static int sound_enable;
-static int16_t ALIGN16_DATA sound_buffer[2][SOUND_BUFFER_SIZE];
+static int16_t ALIGN16_DATA sound_buffer[SOUND_BLOCKS][SOUND_OUTPUT_SIZE];
+
+#if SOUND_EMU_THREAD
+static int16_t ALIGN16_DATA sound_silence[SOUND_OUTPUT_SIZE];
+static int sound_block_frames[SOUND_BLOCKS];
+static uint32_t block_read;		/* advanced by the sound thread */
+static uint32_t block_write;	/* advanced by the emulation thread */
+#endif
+
+static void *sound_event;		/* posted by the sound thread for sound_thread_wait() */
+static int sound_event_waiting;
+static int sound_thread_sleeping;
 
 static struct sound_t sound_info;
 static void *game_audio;
 
+#if RATE_CONTROL
+static float rate_fill;
+static int rate_ppm;
+#endif
+
 
 /******************************************************************************
 	Global Variables
@@ -36,13 +61,188 @@ struct sound_t *sound = &sound_info;
 	Local Functions
 ******************************************************************************/
 
+/*--------------------------------------------------------
+	Wake the emulation thread if it waits for progress
+	(sound thread)
+--------------------------------------------------------*/
+
+static void sound_thread_notify(void)
+{
+	if (__atomic_exchange_n(&sound_event_waiting, 0, __ATOMIC_SEQ_CST))
+		thread_driver->signalSema(sound_event);
+}
+
+
+#if SOUND_EMU_THREAD || RATE_CONTROL
+/*--------------------------------------------------------
+	Sleep until ready() is true (sound thread)
+
+	Anything that can make ready() true has to call
+	sound_thread_wakeup() afterwards.
+--------------------------------------------------------*/
+
+static void sound_thread_sleep(int (*ready)(void))
+{
+	while (!(*ready)())
+	{
+		__atomic_store_n(&sound_thread_sleeping, 1, __ATOMIC_SEQ_CST);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+		/* ready meanwhile: take the request back, or eat the wakeup that is on its way */
+		if ((*ready)() && __atomic_exchange_n(&sound_thread_sleeping, 0, __ATOMIC_SEQ_CST))
+			break;
+
+		thread_driver->sleepThread(sound_thread);
+	}
+}
+#endif
+
+
+#if RATE_CONTROL && !SOUND_EMU_THREAD
+/*--------------------------------------------------------
+	Check if the next update can be rendered
+	(render ahead if the audio queue is about to run dry)
+--------------------------------------------------------*/
+
+static int sound_rate_ready(void)
+{
+	audio_stats_t stats;
+
+	if (!sound_active || !sound_enable || sound_queue_ready())
+		return 1;
+
+	return !audio_driver->stats(game_audio, &stats) || stats.queued < stats.target / 4;
+}
+
+
+/*--------------------------------------------------------
+	Wait for the emulated frames of the next update
+	(sound_queue_frame() wakes the sound thread)
+--------------------------------------------------------*/
+
+static void sound_rate_wait(void)
+{
+	sound_thread_sleep(sound_rate_ready);
+}
+#endif
+
+
+#if RATE_CONTROL
+/*--------------------------------------------------------
+	Bend the resampling rate towards the queue target
+	(pending: frames not handed to the driver yet)
+--------------------------------------------------------*/
+
+static void sound_rate_control(uint32_t pending)
+{
+	audio_stats_t stats;
+	float fill;
+
+	if (!audio_driver->stats(game_audio, &stats) || !stats.target)
+		return;
+
+	fill = ((float)(stats.queued + pending) - (float)stats.target) / (float)stats.target;
+	if (fill > 1.0f) fill = 1.0f;
+	else if (fill < -1.0f) fill = -1.0f;
+
+	/* average out the callback granularity */
+	rate_fill += (fill - rate_fill) * 0.125f;
+
+	rate_ppm = (int)(-rate_fill * SOUND_RATE_CONTROL);
+	resampler_adjust(rate_ppm);
+}
+#endif
+
+
 /*--------------------------------------------------------
 	Sound Update Thread
 --------------------------------------------------------*/
 
+#if SOUND_EMU_THREAD
+
+/*--------------------------------------------------------
+	Wait conditions of the rendered frame ring
+--------------------------------------------------------*/
+
+static int sound_block_ready(void)
+{
+	return !sound_active || !sound_enable || block_read != __atomic_load_n(&block_write, __ATOMIC_ACQUIRE);
+}
+
+static int sound_block_free(void)
+{
+	return block_write - __atomic_load_n(&block_read, __ATOMIC_ACQUIRE) < SOUND_BLOCKS;
+}
+
+
+static int32_t sound_update_thread(uint32_t args, void *argp)
+{
+	audio_stats_t stats;
+	uint32_t read;
+	int16_t *buffer;
+	int frames;
+
+	while (sound_active)
+	{
+		if (Sleep)
+		{
+			do
+			{
+				usleep(5000000);
+			} while (Sleep);
+		}
+
+		read = block_read;
+
+		if (!sound_enable)
+		{
+			/* drop rendered frames, sound_thread_frame() stopped rendering */
+			read = __atomic_load_n(&block_write, __ATOMIC_ACQUIRE);
+			__atomic_store_n(&block_read, read, __ATOMIC_RELEASE);
+			sound_thread_notify();
+
+			buffer = sound_silence;
+			frames = sound->output_samples;
+		}
+		else if (read == __atomic_load_n(&block_write, __ATOMIC_ACQUIRE))
+		{
+			sound_thread_sleep(sound_block_ready);
+			continue;
+		}
+		else
+		{
+			/* starting or after a stall: put half the target in front so the device does not run dry */
+			if (audio_driver->stats(game_audio, &stats) && stats.queued < stats.target / 4)
+			{
+				frames = stats.target / 2;
+				if (frames > SOUND_OUTPUT_SIZE / 2) frames = SOUND_OUTPUT_SIZE / 2;
+				audio_driver->srcOutputBlocking(game_audio, sound_volume, sound_silence, frames * 2 * sizeof(int16_t));
+			}
+
+			buffer = sound_buffer[read % SOUND_BLOCKS];
+			frames = sound_block_frames[read % SOUND_BLOCKS];
+		}
+
+		audio_driver->srcOutputBlocking(game_audio, sound_volume, buffer, frames * 2 * sizeof(int16_t));
+
+		if (buffer != sound_silence)
+		{
+			__atomic_store_n(&block_read, read + 1, __ATOMIC_RELEASE);
+			sound_thread_notify();
+		}
+	}
+
+	thread_driver->exitThread(sound_thread, 0);
+
+	return 0;
+}
+
+#else
+
 static int32_t sound_update_thread(uint32_t args, void *argp)
 {
 	int flip = 0;
+	int frames;
 
 	while (sound_active)
 	{
@@ -55,11 +255,24 @@ static int32_t sound_update_thread(uint32_t args, void *argp)
 		}
 
 		if (sound_enable)
-			(*sound->update)(sound_buffer[flip]);
+		{
+#if RATE_CONTROL
+			sound_rate_wait();
+#endif
+			frames = (*sound->update)(sound_buffer[flip]);
+#if RATE_CONTROL
+			sound_rate_control(0);
+#endif
+		}
 		else
-			memset(sound_buffer[flip], 0, SOUND_BUFFER_SIZE * 2);
+		{
+			sound_queue_flush();
+			frames = sound->output_samples;
+			memset(sound_buffer[flip], 0, frames * 2 * sizeof(int16_t));
+		}
+		sound_thread_notify();
 
-		audio_driver->srcOutputBlocking(game_audio, sound_volume, sound_buffer[flip], SOUND_BUFFER_SIZE * sizeof(int16_t));
+		audio_driver->srcOutputBlocking(game_audio, sound_volume, sound_buffer[flip], frames * 2 * sizeof(int16_t));
 		flip ^= 1;
 	}
 
@@ -68,6 +281,8 @@ static int32_t sound_update_thread(uint32_t args, void *argp)
 	return 0;
 }
 
+#endif
+
 
 /******************************************************************************
 	Global Functions
@@ -110,6 +325,8 @@ void sound_thread_enable(int enable)
 			sound_thread_set_volume();
 		else
 			sound_volume = 0;
+
+		sound_thread_wakeup();
 	}
 }
 
@@ -136,16 +353,35 @@ int sound_thread_start(void)
 	sound_enable = 0;
 	game_audio = NULL;
 
-	memset(sound_buffer[0], 0, sizeof(sound_buffer[0]));
-	memset(sound_buffer[1], 0, sizeof(sound_buffer[1]));
+	memset(sound_buffer, 0, sizeof(sound_buffer));
+
+#if RATE_CONTROL
+	rate_fill = 0.0f;
+	rate_ppm = 0;
+#endif
+#if SOUND_EMU_THREAD
+	block_read = 0;
+	block_write = 0;
+	memset(sound_block_frames, 0, sizeof(sound_block_frames));
+#endif
+
+	if ((sound_event = thread_driver->createSema()) == NULL)
+	{
+		fatalerror(TEXT(COULD_NOT_START_SOUND_THREAD));
+		return 0;
+	}
+	sound_event_waiting = 0;
+	sound_thread_sleeping = 0;
 
 	game_audio = audio_driver->init();
 
-	if (!audio_driver->chSRCReserve(game_audio, sound->samples, sound->frequency, 2))
+	if (!audio_driver->chSRCReserve(game_audio, sound->output_samples, sound->output_frequency, 2))
 	{
 		fatalerror(TEXT(COULD_NOT_RESERVE_AUDIO_CHANNEL_FOR_SOUND));
 		audio_driver->free(game_audio);
+		thread_driver->deleteSema(sound_event);
 		game_audio = NULL;
+		sound_event = NULL;
 		return 0;
 	}
 
@@ -156,8 +392,10 @@ int sound_thread_start(void)
 		audio_driver->release(game_audio);
 		audio_driver->free(game_audio);
 		thread_driver->free(sound_thread);
+		thread_driver->deleteSema(sound_event);
 		sound_thread = NULL;
 		game_audio = NULL;
+		sound_event = NULL;
 		return 0;
 	}
 
@@ -170,6 +408,96 @@ int sound_thread_start(void)
 }
 
 
+#if SOUND_EMU_THREAD
+/*--------------------------------------------------------
+	Render a closed frame and pass it to the sound thread
+	(emulation thread)
+--------------------------------------------------------*/
+
+void sound_thread_frame(void)
+{
+	uint32_t write = block_write;
+	int slot = write % SOUND_BLOCKS;
+
+	if (!sound_active || !sound_enable)
+	{
+		sound_queue_flush();
+		return;
+	}
+
+	/* the device fell behind: wait for the sound thread */
+	sound_thread_wait(sound_block_free);
+
+#if RATE_CONTROL
+	sound_rate_control((write - __atomic_load_n(&block_read, __ATOMIC_ACQUIRE)) * sound->output_samples);
+#endif
+
+	sound_block_frames[slot] = (*sound->update)(sound_buffer[slot]);
+
+	__atomic_store_n(&block_write, write + 1, __ATOMIC_RELEASE);
+	sound_thread_wakeup();
+}
+#endif
+
+
+/*--------------------------------------------------------
+	Wake the sound thread if it sleeps in
+	sound_thread_sleep()
+--------------------------------------------------------*/
+
+void sound_thread_wakeup(void)
+{
+	if (__atomic_exchange_n(&sound_thread_sleeping, 0, __ATOMIC_SEQ_CST))
+		thread_driver->wakeupThread(sound_thread);
+}
+
+
+/*--------------------------------------------------------
+	Block until done() is true (emulation thread)
+
+	done() must become true through progress of the sound
+	thread, which posts sound_event after each update.
+--------------------------------------------------------*/
+
+void sound_thread_wait(int (*done)(void))
+{
+	while (!(*done)())
+	{
+		__atomic_store_n(&sound_event_waiting, 1, __ATOMIC_SEQ_CST);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+		/* done meanwhile: take the request back, or eat the post that is on its way */
+		if ((*done)() && __atomic_exchange_n(&sound_event_waiting, 0, __ATOMIC_SEQ_CST))
+			break;
+
+		thread_driver->waitSema(sound_event);
+	}
+}
+
+
+/*--------------------------------------------------------
+	Print audio queue statistics
+--------------------------------------------------------*/
+
+void sound_thread_report(void)
+{
+	audio_stats_t stats;
+
+	if (game_audio && audio_driver->stats(game_audio, &stats))
+	{
+		printf("audio    queued %5u/%5u frames (%5.1fms, target %5.1fms)  underrun %u  overrun %u\n",
+			stats.queued, stats.capacity,
+			(float)stats.queued * 1000.0f / stats.frequency,
+			(float)stats.target * 1000.0f / stats.frequency,
+			stats.underruns,
+			stats.overruns);
+#if RATE_CONTROL
+		printf("audio    rate %+5dppm\n", rate_ppm);
+#endif
+	}
+}
+
+
 /*--------------------------------------------------------
 	Sound Thread Stop
 --------------------------------------------------------*/
@@ -182,6 +510,7 @@ void sound_thread_stop(void)
 		sound_enable = 0;
 
 		sound_active = 0;
+		sound_thread_wakeup();
 		thread_driver->waitThreadEnd(sound_thread);
 		thread_driver->deleteThread(sound_thread);
 		thread_driver->free(sound_thread);
@@ -190,5 +519,8 @@ void sound_thread_stop(void)
 		audio_driver->release(game_audio);
 		audio_driver->free(game_audio);
 		game_audio = NULL;
+
+		thread_driver->deleteSema(sound_event);
+		sound_event = NULL;
 	}
 }
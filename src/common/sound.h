@@ -19,6 +19,17 @@
 #define SOUND_BUFFER_SIZE	((736*2)*2)
 #endif
 
+#if SOUND_EMU_THREAD && !SOUND_RESAMPLER_TAPS
+#error SOUND_EMU_THREAD needs SOUND_RESAMPLER_TAPS
+#endif
+
+#if SOUND_RESAMPLER_TAPS
+#define SOUND_OUTPUT_RATE	48000
+#define SOUND_OUTPUT_SIZE	((SOUND_OUTPUT_RATE / 25) * 2)	// output frames of 2 emulated frames, with margin
+#else
+#define SOUND_OUTPUT_SIZE	SOUND_BUFFER_SIZE
+#endif
+
 
 struct sound_t
 {
@@ -26,7 +37,9 @@ struct sound_t
 	int channels;
 	int frequency;
 	int samples;
-	void (*update)(int16_t *buffer);
+	int output_frequency;
+	int output_samples;
+	int (*update)(int16_t *buffer);
 	void (*callback)(int32_t **buffer, int length);
 };
 
@@ -47,5 +60,11 @@ void sound_thread_enable(int enable);
 void sound_thread_set_volume(void);
 int sound_thread_start(void);
 void sound_thread_stop(void);
+void sound_thread_report(void);
+void sound_thread_wait(int (*done)(void));
+void sound_thread_wakeup(void);
+#if SOUND_EMU_THREAD
+void sound_thread_frame(void);
+#endif
 
 #endif /* COMMON_SOUND_H */
@@ -204,6 +204,8 @@ int state_save(int slot)
 	sprintf(path, "%sstate/%s.sv%d", launchDir, game_name, slot);
 	remove(path);
 
+	sound_queue_sync();
+
 	sprintf(buf, TEXT(STATE_SAVING), game_name, slot);
 	init_progress(6, buf);
 
@@ -394,6 +396,8 @@ int state_load(int slot)
 
 	sprintf(path, "%sstate/%s.sv%d", launchDir, game_name, slot);
 
+	sound_queue_sync();
+
 #if (EMU_SYSTEM == MVS)
 	state_reload_bios = 0;
 #endif
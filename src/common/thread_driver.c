@@ -20,6 +20,10 @@ thread_driver_t thread_null = {
 	NULL,
 	NULL,
 	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
 };
 
 thread_driver_t *thread_drivers[] = {
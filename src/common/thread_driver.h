@@ -30,6 +30,15 @@ typedef struct thread_driver
 	void (*suspendThread)(void *data);
 	void (*sleepThread)(void *data);
 	void (*exitThread)(void *data, int32_t exit_code);
+	/* Counting semaphore (initially 0) for waits on threads that were
+	* not created through the driver, e.g. the emulation thread.
+	*
+	* Returns: semaphore handle on success, otherwise NULL.
+	**/
+	void *(*createSema)(void);
+	void (*deleteSema)(void *sema);
+	void (*waitSema)(void *sema);
+	void (*signalSema)(void *sema);
 } thread_driver_t;
 
 
@@ -14,6 +14,7 @@ ticker_driver_t ticker_null = {
 	NULL,
 	NULL,
 	NULL,
+	NULL,
 };
 
 ticker_driver_t *ticker_drivers[] = {
@@ -24,6 +24,8 @@ typedef struct ticker_driver
 	/* Stops and frees driver data. */
    	void (*free)(void *data);
 	uint64_t (*currentUs)(void *data);
+	/* Waits until currentUs reaches target (returns at once if passed). */
+	void (*sleepUntilUs)(void *data, uint64_t target);
 
 } ticker_driver_t;
 
@@ -0,0 +1,398 @@
+/******************************************************************************
+
+	tile_cache.c
+
+	Sprite Texture Cache
+
+******************************************************************************/
+
+#include "emumain.h"
+#include "tile_cache.h"
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+#define TILE_CACHE_HASH(c, key)		(((key) * 0x9e3779b1) >> (c)->hash_shift)
+
+#define MAX_TILE_CACHES		8
+
+static TILE_CACHE *tile_caches[MAX_TILE_CACHES];
+static int num_tile_caches;
+static uint32_t stats_start_frame;
+
+
+/*------------------------------------------------------------------------
+	Find table position of key (-1 if not registered)
+------------------------------------------------------------------------*/
+
+static int tile_cache_position(TILE_CACHE *c, uint32_t key)
+{
+	uint32_t i = TILE_CACHE_HASH(c, key);
+
+	while (c->slots[i])
+	{
+		if (c->keys[i] == key)
+			return i;
+
+		i = (i + 1) & c->hash_mask;
+	}
+	return -1;
+}
+
+
+/*------------------------------------------------------------------------
+	Add cache to statistics list
+------------------------------------------------------------------------*/
+
+static void tile_cache_register(TILE_CACHE *c)
+{
+	int i;
+
+	for (i = 0; i < num_tile_caches; i++)
+		if (tile_caches[i] == c) return;
+
+	if (num_tile_caches < MAX_TILE_CACHES)
+		tile_caches[num_tile_caches++] = c;
+}
+
+
+/******************************************************************************
+	Tile Cache Interface Functions
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Clear all tiles
+------------------------------------------------------------------------*/
+
+void tile_cache_clear(TILE_CACHE *c)
+{
+	uint32_t bits = 0;
+	int i;
+
+	tile_cache_register(c);
+	if (c->num) c->flushes++;
+
+	while ((1U << bits) <= c->hash_mask) bits++;
+	c->hash_shift = 32 - bits;
+
+	memset(c->slots, 0, sizeof(uint16_t) * (c->hash_mask + 1));
+	memset(c->slot_state, TILE_SLOT_FREE, c->size);
+
+	// pop order 0, 1, 2 ...
+	for (i = 0; i < c->size; i++)
+		c->free_list[i] = c->size - 1 - i;
+
+	c->free_num = c->size;
+	c->num = 0;
+	c->hand = 0;
+}
+
+
+/*------------------------------------------------------------------------
+	Change number of usable slots and clear all tiles
+
+	For textures shared by layers with different tile sizes.
+------------------------------------------------------------------------*/
+
+void tile_cache_set_size(TILE_CACHE *c, int size)
+{
+	c->size = (size < c->capacity) ? size : c->capacity;
+	tile_cache_clear(c);
+}
+
+
+/*------------------------------------------------------------------------
+	Get texture slot of key (-1 if not cached)
+------------------------------------------------------------------------*/
+
+int tile_cache_find(TILE_CACHE *c, uint32_t key)
+{
+	uint32_t i = TILE_CACHE_HASH(c, key);
+	uint16_t slot;
+
+	while ((slot = c->slots[i]) != 0)
+	{
+		if (c->keys[i] == key)
+			return slot - 1;
+
+		i = (i + 1) & c->hash_mask;
+	}
+	return -1;
+}
+
+
+/*------------------------------------------------------------------------
+	Get texture slot of key for drawing
+
+	Same as tile_cache_find(), but counted in the hit rate. Lookups
+	that only keep a tile alive must use tile_cache_find().
+------------------------------------------------------------------------*/
+
+int tile_cache_lookup(TILE_CACHE *c, uint32_t key)
+{
+	int idx = tile_cache_find(c, key);
+
+	if (idx >= 0) c->hits++;
+	return idx;
+}
+
+
+/*------------------------------------------------------------------------
+	Mark slot as drawn in this frame
+
+	Returns 1 on the first use in the current frame.
+------------------------------------------------------------------------*/
+
+int tile_cache_touch(TILE_CACHE *c, int idx)
+{
+	c->slot_state[idx] = TILE_SLOT_REFERENCED;
+
+	if (c->slot_used[idx] != frames_displayed)
+	{
+		c->slot_used[idx] = frames_displayed;
+		return 1;
+	}
+	return 0;
+}
+
+
+/*------------------------------------------------------------------------
+	Find and mark as used (not counted in the hit rate)
+------------------------------------------------------------------------*/
+
+int tile_cache_mark(TILE_CACHE *c, uint32_t key)
+{
+	int idx = tile_cache_find(c, key);
+
+	if (idx >= 0)
+	{
+		c->slot_state[idx] = TILE_SLOT_REFERENCED;
+		c->slot_used[idx] = frames_displayed;
+	}
+	return idx;
+}
+
+
+/*------------------------------------------------------------------------
+	Find and mark as drawn
+------------------------------------------------------------------------*/
+
+int tile_cache_get(TILE_CACHE *c, uint32_t key)
+{
+	int idx = tile_cache_mark(c, key);
+
+	if (idx >= 0) c->hits++;
+	return idx;
+}
+
+
+/*------------------------------------------------------------------------
+	Register key in a free slot (-1 if texture is full)
+------------------------------------------------------------------------*/
+
+int tile_cache_insert(TILE_CACHE *c, uint32_t key)
+{
+	uint32_t i;
+	int idx;
+
+	if (!c->free_num) return -1;
+
+	idx = c->free_list[--c->free_num];
+
+	i = TILE_CACHE_HASH(c, key);
+	while (c->slots[i])
+		i = (i + 1) & c->hash_mask;
+
+	c->keys[i]  = key;
+	c->slots[i] = idx + 1;
+
+	c->slot_key[idx]   = key;
+	c->slot_used[idx]  = frames_displayed;
+	c->slot_state[idx] = TILE_SLOT_REFERENCED;
+
+	c->num++;
+	c->misses++;
+	if (c->max_num < c->num) c->max_num = c->num;
+
+	return idx;
+}
+
+
+/*------------------------------------------------------------------------
+	Release slot
+
+	Backward shift deletion keeps probe sequences intact without
+	tombstones.
+------------------------------------------------------------------------*/
+
+void tile_cache_remove(TILE_CACHE *c, int idx)
+{
+	int pos;
+	uint32_t i, j, home;
+
+	if (c->slot_state[idx] == TILE_SLOT_FREE) return;
+
+	if ((pos = tile_cache_position(c, c->slot_key[idx])) >= 0)
+	{
+		i = pos;
+		j = pos;
+
+		for (;;)
+		{
+			j = (j + 1) & c->hash_mask;
+
+			if (!c->slots[j])
+				break;
+
+			home = TILE_CACHE_HASH(c, c->keys[j]);
+
+			// entry j may move to i only if i lies on its probe path
+			if (((j - home) & c->hash_mask) >= ((j - i) & c->hash_mask))
+			{
+				c->keys[i]  = c->keys[j];
+				c->slots[i] = c->slots[j];
+				i = j;
+			}
+		}
+		c->slots[i] = 0;
+	}
+
+	c->slot_state[idx] = TILE_SLOT_FREE;
+	c->free_list[c->free_num++] = idx;
+	c->num--;
+
+	if (c->evict_frame != frames_displayed)
+	{
+		c->evict_frame = frames_displayed;
+		c->frame_evictions = 0;
+	}
+	c->evictions++;
+	if (++c->frame_evictions > c->max_evictions)
+		c->max_evictions = c->frame_evictions;
+}
+
+
+/*------------------------------------------------------------------------
+	Free expired slots (CLOCK)
+
+	Slots drawn in the current frame are kept; referenced slots get a
+	second chance. Returns the number of slots freed.
+------------------------------------------------------------------------*/
+
+int tile_cache_evict(TILE_CACHE *c)
+{
+	int batch = (c->size >> 3) + 1;
+	int steps = c->size * 2;
+	int freed = 0;
+	int idx;
+
+	while (steps-- && freed < batch)
+	{
+		idx = c->hand;
+		if (++c->hand == c->size) c->hand = 0;
+
+		if (c->slot_state[idx] == TILE_SLOT_FREE)
+			continue;
+
+		if (c->slot_used[idx] == frames_displayed)
+			continue;
+
+		if (c->slot_state[idx] == TILE_SLOT_REFERENCED)
+		{
+			c->slot_state[idx] = TILE_SLOT_USED;
+			continue;
+		}
+
+		tile_cache_remove(c, idx);
+		freed++;
+	}
+
+	return freed;
+}
+
+
+/******************************************************************************
+	Statistics
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Reset counters of all caches
+------------------------------------------------------------------------*/
+
+void tile_cache_reset_stats(void)
+{
+	int i;
+
+	for (i = 0; i < num_tile_caches; i++)
+	{
+		TILE_CACHE *c = tile_caches[i];
+
+		c->hits = 0;
+		c->misses = 0;
+		c->evictions = 0;
+		c->flushes = 0;
+		c->frame_evictions = 0;
+		c->max_evictions = 0;
+		c->max_num = c->num;
+	}
+	stats_start_frame = frames_displayed;
+}
+
+
+/*------------------------------------------------------------------------
+	Get statistics of n-th registered cache (0 if none)
+------------------------------------------------------------------------*/
+
+int tile_cache_stats(int n, TILE_CACHE_STATS *stats)
+{
+	TILE_CACHE *c;
+	uint32_t lookups, frames;
+
+	if (n < 0 || n >= num_tile_caches)
+		return 0;
+
+	c = tile_caches[n];
+	lookups = c->hits + c->misses;
+	frames = frames_displayed - stats_start_frame;
+
+	stats->name          = c->name;
+	stats->hits          = c->hits;
+	stats->misses        = c->misses;
+	stats->evictions     = c->evictions;
+	stats->flushes       = c->flushes;
+	stats->num           = c->num;
+	stats->max_num       = c->max_num;
+	stats->size          = c->size;
+	stats->max_evictions = c->max_evictions;
+
+	stats->hit_rate            = lookups ? (float)c->hits * 100.0f / (float)lookups : 0.0f;
+	stats->evictions_per_frame = frames ? (float)c->evictions / (float)frames : 0.0f;
+	stats->occupancy           = c->size ? (float)c->num * 100.0f / (float)c->size : 0.0f;
+
+	return 1;
+}
+
+
+/*------------------------------------------------------------------------
+	Print statistics of all caches
+------------------------------------------------------------------------*/
+
+void tile_cache_report(void)
+{
+	TILE_CACHE_STATS stats;
+	int i;
+
+	for (i = 0; tile_cache_stats(i, &stats); i++)
+	{
+		printf("%-8s hit %6.2f%%  evict %7.2f/frame (max %u)  used %4u/%4u (%5.1f%%, max %u)  flush %u\n",
+			stats.name,
+			stats.hit_rate,
+			stats.evictions_per_frame,
+			stats.max_evictions,
+			stats.num, stats.size, stats.occupancy,
+			stats.max_num,
+			stats.flushes);
+	}
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+
+	tile_cache.h
+
+	Sprite Texture Cache
+
+******************************************************************************/
+
+#ifndef TILE_CACHE_H
+#define TILE_CACHE_H
+
+#include <stdint.h>
+
+/*
+	Maps a tile key (code + palette bank) to a texture slot.
+
+	Lookups use an open addressing table (linear probing, keys and slots
+	in separate arrays) so a hit touches one or two cache lines instead
+	of walking a chain of SPRITE nodes.
+
+	Eviction is CLOCK / second chance: tile_cache_evict() advances a hand
+	over the texture slots and frees up to 1/8 of the texture per call.
+	Slots used in the current frame are never evicted, as their vertices
+	are still queued for drawing.
+
+	hash_size must be a power of two, at least twice the slot count.
+
+	Every cache registers itself on its first tile_cache_clear() and keeps
+	counters for hit rate, evictions per frame and occupancy, which can be
+	read back by layer with tile_cache_stats().
+*/
+
+typedef struct tile_cache_t
+{
+	uint32_t *keys;			// table: tile key
+	uint16_t *slots;		// table: texture slot + 1 (0 = empty)
+	uint32_t *slot_key;		// slot: tile key
+	uint32_t *slot_used;	// slot: last frame drawn
+	uint8_t  *slot_state;	// slot: TILE_SLOT_xxx
+	uint16_t *free_list;
+	uint32_t hash_mask;
+	uint32_t hash_shift;
+	uint16_t capacity;		// slots allocated
+	uint16_t size;			// slots in use (<= capacity)
+	uint16_t num;
+	uint16_t free_num;
+	uint16_t hand;
+
+	// statistics
+	const char *name;
+	uint32_t hits;			// draw lookups that found the tile
+	uint32_t misses;		// tiles decoded into the texture
+	uint32_t evictions;
+	uint32_t flushes;		// whole texture cleared
+	uint32_t evict_frame;
+	uint16_t frame_evictions;
+	uint16_t max_evictions;	// most evictions in a single frame
+	uint16_t max_num;
+} TILE_CACHE;
+
+typedef struct tile_cache_stats_t
+{
+	const char *name;
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t evictions;
+	uint32_t flushes;
+	uint16_t num;
+	uint16_t max_num;
+	uint16_t size;
+	uint16_t max_evictions;
+	float hit_rate;				// percent
+	float evictions_per_frame;
+	float occupancy;			// percent
+} TILE_CACHE_STATS;
+
+enum
+{
+	TILE_SLOT_FREE = 0,
+	TILE_SLOT_USED,
+	TILE_SLOT_REFERENCED
+};
+
+#define TILE_CACHE_STORAGE(name, size, hash_size)					\
+	static uint32_t ALIGN16_DATA name##_keys[hash_size];			\
+	static uint16_t ALIGN16_DATA name##_slots[hash_size];			\
+	static uint32_t ALIGN_DATA name##_slot_key[size];				\
+	static uint32_t ALIGN_DATA name##_slot_used[size];				\
+	static uint8_t  ALIGN_DATA name##_slot_state[size];				\
+	static uint16_t ALIGN_DATA name##_free_list[size]
+
+#define TILE_CACHE_INIT(name, size, hash_size)						\
+	{																\
+		name##_keys, name##_slots,									\
+		name##_slot_key, name##_slot_used, name##_slot_state,		\
+		name##_free_list,											\
+		(hash_size) - 1, 0, (size), (size), 0, 0, 0,				\
+		#name														\
+	}
+
+#define tile_cache_full(c)		((c)->free_num == 0)
+
+void tile_cache_clear(TILE_CACHE *c);
+void tile_cache_set_size(TILE_CACHE *c, int size);
+int tile_cache_find(TILE_CACHE *c, uint32_t key);
+int tile_cache_lookup(TILE_CACHE *c, uint32_t key);
+int tile_cache_touch(TILE_CACHE *c, int idx);
+int tile_cache_mark(TILE_CACHE *c, uint32_t key);
+int tile_cache_get(TILE_CACHE *c, uint32_t key);
+int tile_cache_insert(TILE_CACHE *c, uint32_t key);
+void tile_cache_remove(TILE_CACHE *c, int idx);
+int tile_cache_evict(TILE_CACHE *c);
+
+void tile_cache_reset_stats(void);
+int tile_cache_stats(int n, TILE_CACHE_STATS *stats);
+void tile_cache_report(void);
+
+#endif /* TILE_CACHE_H */
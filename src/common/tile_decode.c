@@ -0,0 +1,320 @@
+/******************************************************************************
+
+	tile_decode.c
+
+	4bpp -> 8bpp Tile Expansion
+
+	Used when a sprite cache miss fills a texture slot. The SSE2 / NEON
+	paths expand two (16 wide) or four (8 wide) rows per 128-bit load;
+	other targets use the original 32-bit word loop.
+
+******************************************************************************/
+
+#include "emumain.h"
+#include "tile_decode.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define TILE_DECODE_SSE2	1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TILE_DECODE_NEON	1
+#endif
+
+
+/******************************************************************************
+	SSE2
+******************************************************************************/
+
+#if defined(TILE_DECODE_SSE2)
+
+void tile_decode_16(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col, int rows)
+{
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	const __m128i bank = _mm_set1_epi32((int)col);
+	__m128i data, lo, hi;
+
+	for (; rows > 0; rows -= 2)
+	{
+		data = _mm_loadu_si128((const __m128i *)src);
+		lo = _mm_and_si128(data, mask);
+		hi = _mm_and_si128(_mm_srli_epi16(data, 4), mask);
+
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_unpacklo_epi32(lo, hi), bank));
+		dst += pitch;
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_unpackhi_epi32(lo, hi), bank));
+		dst += pitch;
+		src += 16;
+	}
+}
+
+void tile_decode_8(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col)
+{
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	const __m128i bank = _mm_set1_epi32((int)col);
+	__m128i data, lo, hi, out;
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		data = _mm_loadu_si128((const __m128i *)src);
+		lo = _mm_and_si128(data, mask);
+		hi = _mm_and_si128(_mm_srli_epi16(data, 4), mask);
+
+		out = _mm_or_si128(_mm_unpacklo_epi32(lo, hi), bank);
+		_mm_storel_epi64((__m128i *)dst, out);
+		dst += pitch;
+		_mm_storel_epi64((__m128i *)dst, _mm_srli_si128(out, 8));
+		dst += pitch;
+
+		out = _mm_or_si128(_mm_unpackhi_epi32(lo, hi), bank);
+		_mm_storel_epi64((__m128i *)dst, out);
+		dst += pitch;
+		_mm_storel_epi64((__m128i *)dst, _mm_srli_si128(out, 8));
+		dst += pitch;
+
+		src += 16;
+	}
+}
+
+void tile_decode_8_linear(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col)
+{
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	const __m128i bank = _mm_set1_epi32((int)col);
+	__m128i data, lo, hi, out;
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		data = _mm_loadu_si128((const __m128i *)src);
+		lo = _mm_and_si128(data, mask);
+		hi = _mm_and_si128(_mm_srli_epi16(data, 4), mask);
+
+		out = _mm_or_si128(_mm_unpacklo_epi8(lo, hi), bank);
+		_mm_storel_epi64((__m128i *)dst, out);
+		dst += pitch;
+		_mm_storel_epi64((__m128i *)dst, _mm_srli_si128(out, 8));
+		dst += pitch;
+
+		out = _mm_or_si128(_mm_unpackhi_epi8(lo, hi), bank);
+		_mm_storel_epi64((__m128i *)dst, out);
+		dst += pitch;
+		_mm_storel_epi64((__m128i *)dst, _mm_srli_si128(out, 8));
+		dst += pitch;
+
+		src += 16;
+	}
+}
+
+#if USE_PREDECODE_GFX
+void tile_copy_16(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col, int rows)
+{
+	const __m128i bank = _mm_set1_epi32((int)col);
+
+	while (rows--)
+	{
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_loadu_si128((const __m128i *)src), bank));
+		src += 16;
+		dst += pitch;
+	}
+}
+#endif
+
+
+/******************************************************************************
+	NEON
+******************************************************************************/
+
+#elif defined(TILE_DECODE_NEON)
+
+void tile_decode_16(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col, int rows)
+{
+	const uint8x16_t mask = vdupq_n_u8(0x0f);
+	const uint8x16_t bank = vreinterpretq_u8_u32(vdupq_n_u32(col));
+	uint8x16_t data;
+	uint32x4x2_t out;
+
+	for (; rows > 0; rows -= 2)
+	{
+		data = vld1q_u8(src);
+		out = vzipq_u32(vreinterpretq_u32_u8(vandq_u8(data, mask)),
+						vreinterpretq_u32_u8(vshrq_n_u8(data, 4)));
+
+		vst1q_u8(dst, vorrq_u8(vreinterpretq_u8_u32(out.val[0]), bank));
+		dst += pitch;
+		vst1q_u8(dst, vorrq_u8(vreinterpretq_u8_u32(out.val[1]), bank));
+		dst += pitch;
+		src += 16;
+	}
+}
+
+void tile_decode_8(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col)
+{
+	const uint8x16_t mask = vdupq_n_u8(0x0f);
+	const uint8x16_t bank = vreinterpretq_u8_u32(vdupq_n_u32(col));
+	uint8x16_t data, row01, row23;
+	uint32x4x2_t out;
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		data = vld1q_u8(src);
+		out = vzipq_u32(vreinterpretq_u32_u8(vandq_u8(data, mask)),
+						vreinterpretq_u32_u8(vshrq_n_u8(data, 4)));
+		row01 = vorrq_u8(vreinterpretq_u8_u32(out.val[0]), bank);
+		row23 = vorrq_u8(vreinterpretq_u8_u32(out.val[1]), bank);
+
+		vst1_u8(dst, vget_low_u8(row01));
+		dst += pitch;
+		vst1_u8(dst, vget_high_u8(row01));
+		dst += pitch;
+		vst1_u8(dst, vget_low_u8(row23));
+		dst += pitch;
+		vst1_u8(dst, vget_high_u8(row23));
+		dst += pitch;
+
+		src += 16;
+	}
+}
+
+void tile_decode_8_linear(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col)
+{
+	const uint8x16_t mask = vdupq_n_u8(0x0f);
+	const uint8x16_t bank = vreinterpretq_u8_u32(vdupq_n_u32(col));
+	uint8x16_t data, row01, row23;
+	uint8x16x2_t out;
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		data = vld1q_u8(src);
+		out = vzipq_u8(vandq_u8(data, mask), vshrq_n_u8(data, 4));
+		row01 = vorrq_u8(out.val[0], bank);
+		row23 = vorrq_u8(out.val[1], bank);
+
+		vst1_u8(dst, vget_low_u8(row01));
+		dst += pitch;
+		vst1_u8(dst, vget_high_u8(row01));
+		dst += pitch;
+		vst1_u8(dst, vget_low_u8(row23));
+		dst += pitch;
+		vst1_u8(dst, vget_high_u8(row23));
+		dst += pitch;
+
+		src += 16;
+	}
+}
+
+#if USE_PREDECODE_GFX
+void tile_copy_16(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col, int rows)
+{
+	const uint8x16_t bank = vreinterpretq_u8_u32(vdupq_n_u32(col));
+
+	while (rows--)
+	{
+		vst1q_u8(dst, vorrq_u8(vld1q_u8(src), bank));
+		src += 16;
+		dst += pitch;
+	}
+}
+#endif
+
+
+/******************************************************************************
+	Generic
+******************************************************************************/
+
+#else
+
+void tile_decode_16(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col, int rows)
+{
+	uint32_t tile;
+
+	while (rows--)
+	{
+		tile = *(uint32_t *)(src + 0);
+		*(uint32_t *)(dst +  0) = ((tile >> 0) & 0x0f0f0f0f) | col;
+		*(uint32_t *)(dst +  4) = ((tile >> 4) & 0x0f0f0f0f) | col;
+		tile = *(uint32_t *)(src + 4);
+		*(uint32_t *)(dst +  8) = ((tile >> 0) & 0x0f0f0f0f) | col;
+		*(uint32_t *)(dst + 12) = ((tile >> 4) & 0x0f0f0f0f) | col;
+		src += 8;
+		dst += pitch;
+	}
+}
+
+void tile_decode_8(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col)
+{
+	uint32_t tile;
+	int rows = 8;
+
+	while (rows--)
+	{
+		tile = *(uint32_t *)(src + 0);
+		*(uint32_t *)(dst +  0) = ((tile >> 0) & 0x0f0f0f0f) | col;
+		*(uint32_t *)(dst +  4) = ((tile >> 4) & 0x0f0f0f0f) | col;
+		src += 4;
+		dst += pitch;
+	}
+}
+
+void tile_decode_8_linear(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col)
+{
+	uint32_t tile;
+	int rows = 8;
+
+	while (rows--)
+	{
+		tile = *(uint32_t *)(src + 0);
+		*(uint32_t *)(dst +  0) = ((tile & 0x0000000f) >>  0) | ((tile & 0x000000f0) <<  4) | ((tile & 0x00000f00) <<  8) | ((tile & 0x0000f000) << 12) | col;
+		*(uint32_t *)(dst +  4) = ((tile & 0x000f0000) >> 16) | ((tile & 0x00f00000) >> 12) | ((tile & 0x0f000000) >>  8) | ((tile & 0xf0000000) >>  4) | col;
+		src += 4;
+		dst += pitch;
+	}
+}
+
+#if USE_PREDECODE_GFX
+void tile_copy_16(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col, int rows)
+{
+	while (rows--)
+	{
+		*(uint32_t *)(dst +  0) = *(uint32_t *)(src +  0) | col;
+		*(uint32_t *)(dst +  4) = *(uint32_t *)(src +  4) | col;
+		*(uint32_t *)(dst +  8) = *(uint32_t *)(src +  8) | col;
+		*(uint32_t *)(dst + 12) = *(uint32_t *)(src + 12) | col;
+		src += 16;
+		dst += pitch;
+	}
+}
+#endif
+
+#endif
+
+
+#if USE_PREDECODE_GFX
+
+/******************************************************************************
+	Pre-decoded Store
+******************************************************************************/
+
+/*------------------------------------------------------
+	Expand whole graphics region to 8bpp
+------------------------------------------------------*/
+
+uint8_t *tile_predecode_16(const uint8_t *src, uint32_t length)
+{
+	uint8_t *dst;
+
+	if (!src || !length)
+		return NULL;
+
+	if ((dst = (uint8_t *)malloc((size_t)length * 2)) == NULL)
+		return NULL;
+
+	// palette bank 0: plain pixel values, OR'd in by tile_copy_16
+	tile_decode_16(dst, 16, src, 0, length / 8);
+
+	return dst;
+}
+
+#endif
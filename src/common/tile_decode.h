@@ -0,0 +1,48 @@
+/******************************************************************************
+
+	tile_decode.h
+
+	4bpp -> 8bpp Tile Expansion
+
+******************************************************************************/
+
+#ifndef TILE_DECODE_H
+#define TILE_DECODE_H
+
+#include <stdint.h>
+
+/*
+	Expand 4bpp packed graphics into an 8bpp texture, OR'ing the palette
+	bank (col, replicated in every byte) into each pixel.
+
+	tile_decode_16: 16 pixels per row, 8 source bytes per row,
+	                rows must be even (8 or 16).
+	tile_decode_8:  8x8 tile, 4 source bytes per row.
+	                The low nibbles of each source word give pixels 0-3,
+	                the high nibbles pixels 4-7 (MVS/CPS layout).
+	tile_decode_8_linear: 8x8 tile, 4 source bytes per row, pixels
+	                stored low nibble first in ascending order (NCDZ FIX).
+
+	pitch is the distance in bytes between destination rows.
+*/
+
+void tile_decode_16(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col, int rows);
+void tile_decode_8(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col);
+void tile_decode_8_linear(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col);
+
+#if USE_PREDECODE_GFX
+/*
+	Pre-decoded 8bpp store
+
+	tile_predecode_16: expand a whole 16 pixel wide graphics region once
+	                   (2 * length bytes, 256 bytes per 16x16 tile).
+	                   Returns NULL if the memory is not available, in which
+	                   case callers keep decoding on each cache miss.
+	tile_copy_16:      copy pre-decoded rows, OR'ing in the palette bank.
+*/
+
+uint8_t *tile_predecode_16(const uint8_t *src, uint32_t length);
+void tile_copy_16(uint8_t *dst, int pitch, const uint8_t *src, uint32_t col, int rows);
+#endif
+
+#endif /* TILE_DECODE_H */
@@ -192,6 +192,7 @@ static void cps1_run(void)
 			
 			apply_cheat(); //davex cheat
 			timer_update_cpu();
+			sound_queue_frame();
 			update_screen();
 			update_inputport();
 		}
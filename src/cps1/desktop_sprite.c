@@ -0,0 +1,1086 @@
+/******************************************************************************
+
+	desktop_sprite.c
+
+	CPS1 Sprite Manager - Desktop (SDL) Platform
+
+	Same draw lists as the PSP back end, drawn into the 16bpp frame by
+	the software blitter (common/soft_blit.c). Textures are linear.
+	Platform-agnostic code is in sprite_common.c.
+
+******************************************************************************/
+
+#include "cps1.h"
+#include "sprite_common.h"
+
+
+/******************************************************************************
+	Prototypes
+******************************************************************************/
+
+void (*blit_draw_scroll2)(int16_t x, int16_t y, uint32_t code, uint16_t attr);
+static void blit_draw_scroll2_software(int16_t x, int16_t y, uint32_t code, uint16_t attr);
+static void blit_draw_scroll2_hardware(int16_t x, int16_t y, uint32_t code, uint16_t attr);
+
+void (*blit_draw_scroll2h)(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint16_t tpens);
+static void blit_draw_scroll2h_software(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint16_t tpens);
+static void blit_draw_scroll2h_hardware(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint16_t tpens);
+
+
+/******************************************************************************
+	Local Structures/Variables
+******************************************************************************/
+
+typedef struct object_t OBJECT;
+
+struct object_t
+{
+	uint32_t clut;
+	struct Vertex vertices[2];
+};
+
+static RECT cps_src_clip = { 64, 16, 64 + 384, 16 + 224 };
+
+static RECT cps_clip[6] =
+{
+	{  0,  0,  0 + 640,  0 + 480 },	// option_stretch = 0  (640x480 window)
+	{ 60,  1, 60 + 360,  1 + 270 },	// option_stretch = 1  (360x270  4:3)
+	{ 48,  1, 48 + 384,  1 + 270 },	// option_stretch = 2  (384x270 24:17)
+	{ 7,   0,   7+ 466,      272 },	// option_stretch = 3  (466x272 12:7)
+	{ 0,   1, 480,       1 + 270 },	// option_stretch = 4  (480x270 16:9)
+	{ 138, 0, 138 + 204,     272 }  	// option_stretch = 5  (204x272 3:4 vertical)
+};
+
+
+/*------------------------------------------------------------------------
+	Vertex Data
+------------------------------------------------------------------------*/
+
+static OBJECT ALIGN_DATA vertices_object[OBJECT_MAX_SPRITES];
+
+static uint16_t object_num;
+static uint16_t object_index;
+
+static struct Vertex ALIGN_DATA vertices_scroll[2][SCROLL1_MAX_SPRITES * 2];
+static struct Vertex ALIGN_DATA vertices_scrollh[SCROLLH_MAX_SPRITES * 2];
+static struct Vertex ALIGN_DATA vertices_batch[OBJECT_MAX_SPRITES * 2];
+
+static uint16_t ALIGN_DATA scrollh_texture[BUF_WIDTH * SCROLLH_MAX_HEIGHT];
+
+static const RECT layer_clip = { 64, 16, 448, 240 };
+static RECT scroll2_clip;
+
+#if USE_TILEMAP_SURFACE
+static uint16_t scroll1_pixels[512 * 512];
+static uint16_t scroll2_pixels[1024 * 1024];
+static uint16_t scroll3_pixels[2048 * 2048];
+static uint32_t scroll_tiles[3][64 * 64];
+
+static SOFT_TILEMAP scroll1_map = { scroll1_pixels, scroll_tiles[0], 3 };
+static SOFT_TILEMAP scroll2_map = { scroll2_pixels, scroll_tiles[1], 4 };
+static SOFT_TILEMAP scroll3_map = { scroll3_pixels, scroll_tiles[2], 5 };
+#endif
+
+
+/******************************************************************************
+	Sprite Drawing Interface Functions
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Clear all sprites immediately
+------------------------------------------------------------------------*/
+
+void blit_clear_all_sprite(void)
+{
+	tile_cache_clear(&object_cache);
+	tile_cache_clear(&scroll1_cache);
+	tile_cache_clear(&scroll2_cache);
+	tile_cache_clear(&scroll3_cache);
+
+#if USE_TILEMAP_SURFACE
+	soft_tilemap_invalidate(&scroll1_map);
+	soft_tilemap_invalidate(&scroll2_map);
+	soft_tilemap_invalidate(&scroll3_map);
+#endif
+
+	scrollh_reset_sprite(0);
+	memset(palette_dirty_marks, 0, sizeof(palette_dirty_marks));
+}
+
+
+/*------------------------------------------------------------------------
+	Clear high layer
+------------------------------------------------------------------------*/
+
+void blit_scrollh_clear_sprite(uint16_t tpens)
+{
+	scrollh_delete_sprite_tpens(tpens);
+}
+
+
+/*------------------------------------------------------------------------
+	Set palette dirty flag
+------------------------------------------------------------------------*/
+
+void blit_palette_mark_dirty(int palno)
+{
+	if (palno < 64) scroll1_palette_is_dirty = 1;
+	else if (palno < 96) scroll2_palette_is_dirty = 1;
+	else if (palno < 128) scroll3_palette_is_dirty = 1;
+
+	palette_dirty_marks[palno] = 1;
+}
+
+
+/*------------------------------------------------------------------------
+	Reset sprite processing
+------------------------------------------------------------------------*/
+
+void blit_reset(int bank_scroll1, int bank_scroll2, int bank_scroll3, uint8_t *pen_usage16)
+{
+	scrbitmap   = (uint16_t *)video_driver->workFrame(video_data, SCRBITMAP);
+	tex_scrollh = scrollh_texture;
+	tex_object  = video_driver->workFrame(video_data, TEX_SPR0);
+	tex_scroll1 = video_driver->workFrame(video_data, TEX_SPR1);
+	tex_scroll2 = video_driver->workFrame(video_data, TEX_SPR2);
+	tex_scroll3 = video_driver->workFrame(video_data, TEX_FIX);
+
+	gfx_object  = memory_region_gfx1;
+	gfx_scroll1 = &memory_region_gfx1[bank_scroll1 << 21];
+	gfx_scroll2 = &memory_region_gfx1[bank_scroll2 << 21];
+	gfx_scroll3 = &memory_region_gfx1[bank_scroll3 << 21];
+
+	pen_usage = pen_usage16;
+	clut = video_palette;
+
+	video_driver->setClutBaseAddr(video_data, video_palette);
+
+	blit_clear_all_sprite();
+}
+
+
+/*------------------------------------------------------------------------
+	Begin sprite drawing
+------------------------------------------------------------------------*/
+
+void blit_start(int high_layer)
+{
+	if (scrollh_texture_clear || high_layer != scrollh_layer_number)
+		scrollh_reset_sprite(high_layer);
+
+	scrollh_delete_dirty_palette();
+	memset(palette_dirty_marks, 0, sizeof(palette_dirty_marks));
+
+	clut0_num = 0;
+	clut1_num = 0;
+
+	object_index = 0;
+	object_num  = 0;
+
+	scrollh_num = 0;
+
+	video_driver->startWorkFrame(video_data, 0);
+}
+
+
+/*------------------------------------------------------------------------
+	End sprite drawing
+------------------------------------------------------------------------*/
+
+void blit_finish(void)
+{
+	// screen rotation is not supported here, the frame is shown unrotated
+	if (cps_flip_screen)
+		soft_blit_flip(scrbitmap, &cps_src_clip);
+
+	video_driver->transferWorkFrame(video_data, &cps_src_clip, &cps_clip[option_stretch]);
+}
+
+
+/*------------------------------------------------------------------------
+	Update OBJECT texture
+------------------------------------------------------------------------*/
+
+void blit_update_object(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	if ((x > 47 && x < 448) && (y > 0 && y < 239))
+		object_mark_sprite(MAKE_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Register OBJECT to draw list
+------------------------------------------------------------------------*/
+
+void blit_draw_object(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	if ((x > 47 && x < 448) && (y > 0 && y < 239))
+	{
+		int16_t idx;
+		OBJECT *object;
+		struct Vertex *vertices;
+		uint32_t key = MAKE_KEY(code, attr);
+
+		if ((idx = object_get_sprite(key)) < 0)
+		{
+			uint32_t col;
+			uint8_t *src, *dst;
+
+			if (tile_cache_full(&object_cache))
+			{
+				cps1_scan_object();
+				object_delete_sprite();
+			}
+
+			idx = object_insert_sprite(key);
+			dst = NONE_SWIZZLED_16x16(tex_object, idx);
+			src = &gfx_object[code << 7];
+			col = color_table[attr & 0x0f];
+
+			tile_decode_16(dst, BUF_WIDTH, src, col, 16);
+		}
+
+		object = &vertices_object[object_index++];
+		object->clut = attr & 0x10;
+
+		vertices = object->vertices;
+
+		vertices[0].x = vertices[1].x = x;
+		vertices[0].y = vertices[1].y = y;
+		vertices[0].u = vertices[1].u = (idx & 0x001f) << 4;
+		vertices[0].v = vertices[1].v = (idx & 0x03e0) >> 1;
+
+		attr ^= 0x60;
+		vertices[(attr & 0x20) >> 5].u += 16;
+		vertices[(attr & 0x40) >> 6].v += 16;
+
+		vertices[1].x += 16;
+		vertices[1].y += 16;
+
+		object_num += 2;
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	End OBJECT drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_object(void)
+{
+	int i, total_sprites = 0;
+	uint8_t color = 0;
+	struct Vertex *vertices = vertices_batch;
+	OBJECT *object;
+
+	if (!object_num) return;
+
+	object = vertices_object;
+
+	for (i = 0; i < object_index; i++)
+	{
+		if (color != object->clut)
+		{
+			if (total_sprites)
+			{
+				soft_blit_clut8(scrbitmap, &layer_clip, tex_object, &clut[color << 4], vertices_batch, total_sprites);
+				total_sprites = 0;
+				vertices = vertices_batch;
+			}
+
+			color = object->clut;
+		}
+
+		vertices[0] = object->vertices[0];
+		vertices[1] = object->vertices[1];
+
+		total_sprites += 2;
+		vertices += 2;
+		object++;
+	}
+
+	if (total_sprites)
+		soft_blit_clut8(scrbitmap, &layer_clip, tex_object, &clut[color << 4], vertices_batch, total_sprites);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL1 texture
+------------------------------------------------------------------------*/
+
+void blit_update_scroll1(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	scroll1_mark_sprite(MAKE_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Register SCROLL1 to draw list
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll1(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint16_t gfxset)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_KEY(code, attr);
+
+	if ((idx = scroll1_get_sprite(key)) < 0)
+	{
+		uint32_t col, tile;
+		uint8_t *src, *dst, lines = 8;
+
+		if (tile_cache_full(&scroll1_cache))
+		{
+			cps1_scan_scroll1();
+			scroll1_delete_sprite();
+		}
+
+		idx = scroll1_insert_sprite(key);
+		dst = NONE_SWIZZLED_8x8(tex_scroll1, idx);
+		src = &gfx_scroll1[(code << 6) + (gfxset << 2)];
+		col = color_table[attr & 0x0f];
+
+		while (lines--)
+		{
+			tile = *(uint32_t *)(src + 0);
+			*(uint32_t *)(dst + 0) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst + 4) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			src += 8;
+			dst += BUF_WIDTH;
+		}
+	}
+
+	if (attr & 0x10)
+	{
+		vertices = &vertices_scroll[1][clut1_num];
+		clut1_num += 2;
+	}
+	else
+	{
+		vertices = &vertices_scroll[0][clut0_num];
+		clut0_num += 2;
+	}
+
+	vertices[0].x = vertices[1].x = x;
+	vertices[0].y = vertices[1].y = y;
+	vertices[0].u = vertices[1].u = (idx & 0x003f) << 3;
+	vertices[0].v = vertices[1].v = (idx & 0x0fc0) >> 3;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 8;
+	vertices[(attr & 0x40) >> 6].v += 8;
+
+	vertices[1].x += 8;
+	vertices[1].y += 8;
+}
+
+
+/*------------------------------------------------------------------------
+	Draw scroll layer lists (palette blocks clut0/clut1)
+------------------------------------------------------------------------*/
+
+static void blit_finish_scroll(const RECT *clip, uint8_t *tex, int clut0, int clut1)
+{
+	if (clut0_num)
+	{
+		soft_blit_clut8(scrbitmap, clip, tex, &clut[clut0 << 4], vertices_scroll[0], clut0_num);
+		clut0_num = 0;
+	}
+	if (clut1_num)
+	{
+		soft_blit_clut8(scrbitmap, clip, tex, &clut[clut1 << 4], vertices_scroll[1], clut1_num);
+		clut1_num = 0;
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	End SCROLL1 drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll1(void)
+{
+	blit_finish_scroll(&layer_clip, tex_scroll1, 32, 48);
+}
+
+
+/*------------------------------------------------------------------------
+	Set SCROLL2 clip range
+------------------------------------------------------------------------*/
+
+void blit_set_clip_scroll2(int16_t min_y, int16_t max_y)
+{
+	scroll2_min_y = min_y;
+	scroll2_max_y = max_y + 1;
+
+	scroll2_clip.left   = 64;
+	scroll2_clip.top    = scroll2_min_y;
+	scroll2_clip.right  = 448;
+	scroll2_clip.bottom = scroll2_max_y;
+
+	if (scroll2_max_y - scroll2_min_y >= 16)
+	{
+		blit_draw_scroll2  = blit_draw_scroll2_hardware;
+		blit_draw_scroll2h = blit_draw_scroll2h_hardware;
+	}
+	else
+	{
+		blit_draw_scroll2  = blit_draw_scroll2_software;
+		blit_draw_scroll2h = blit_draw_scroll2h_software;
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Check SCROLL2 draw range
+------------------------------------------------------------------------*/
+
+int blit_check_clip_scroll2(int16_t sy)
+{
+	scroll2_sy = sy;
+	scroll2_ey = sy + 16;
+
+	if (scroll2_min_y > scroll2_sy) scroll2_sy = scroll2_min_y;
+	if (scroll2_max_y < scroll2_ey) scroll2_ey = scroll2_max_y;
+
+	return (scroll2_sy < scroll2_ey);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL2 texture
+------------------------------------------------------------------------*/
+
+void blit_update_scroll2(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	if (y + 16 > 0 && y < 239)
+		scroll2_mark_sprite(MAKE_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL2 (line scroll) directly to VRAM
+------------------------------------------------------------------------*/
+
+static void blit_draw_scroll2_software(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	uint32_t src, dst;
+	uint8_t func;
+
+	src = code << 7;
+
+	if (attr & 0x40)
+	{
+		src += ((y + 16) - scroll2_ey) << 3;
+		dst = ((scroll2_ey - 1) << 9) + x;
+	}
+	else
+	{
+		src += (scroll2_sy - y) << 3;
+		dst = (scroll2_sy << 9) + x;
+	}
+
+	func = pen_usage[code] | ((attr & 0x60) >> 4);
+
+	(*drawgfx16[func])((uint32_t *)&gfx_scroll2[src],
+					&scrbitmap[dst],
+					&video_palette[((attr & 0x1f) + 64) << 4],
+					scroll2_ey - scroll2_sy);
+}
+
+
+/*------------------------------------------------------------------------
+	Register SCROLL2 to draw list
+------------------------------------------------------------------------*/
+
+static void blit_draw_scroll2_hardware(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_KEY(code, attr);
+
+	if ((idx = scroll2_get_sprite(key)) < 0)
+	{
+		uint32_t col;
+		uint8_t *src, *dst;
+
+		if (tile_cache_full(&scroll2_cache))
+		{
+			cps1_scan_scroll2();
+			scroll2_delete_sprite();
+		}
+
+		idx = scroll2_insert_sprite(key);
+		dst = NONE_SWIZZLED_16x16(tex_scroll2, idx);
+		src = &gfx_scroll2[code << 7];
+		col = color_table[attr & 0x0f];
+
+		tile_decode_16(dst, BUF_WIDTH, src, col, 16);
+	}
+
+	if (attr & 0x10)
+	{
+		vertices = &vertices_scroll[1][clut1_num];
+		clut1_num += 2;
+	}
+	else
+	{
+		vertices = &vertices_scroll[0][clut0_num];
+		clut0_num += 2;
+	}
+
+	vertices[0].x = vertices[1].x = x;
+	vertices[0].y = vertices[1].y = y;
+	vertices[0].u = vertices[1].u = (idx & 0x001f) << 4;
+	vertices[0].v = vertices[1].v = (idx & 0x03e0) >> 1;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 16;
+	vertices[(attr & 0x40) >> 6].v += 16;
+
+	vertices[1].x += 16;
+	vertices[1].y += 16;
+}
+
+
+/*------------------------------------------------------------------------
+	End SCROLL2 drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll2(void)
+{
+	blit_finish_scroll(&scroll2_clip, tex_scroll2, 64, 80);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL3 texture
+------------------------------------------------------------------------*/
+
+void blit_update_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	scroll3_mark_sprite(MAKE_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Register SCROLL3 to draw list
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_KEY(code, attr);
+
+	if ((idx = scroll3_get_sprite(key)) < 0)
+	{
+		uint32_t col, tile;
+		uint8_t *src, *dst, lines = 32;
+
+		if (tile_cache_full(&scroll3_cache))
+		{
+			cps1_scan_scroll3();
+			scroll3_delete_sprite();
+		}
+
+		idx = scroll3_insert_sprite(key);
+		dst = NONE_SWIZZLED_32x32(tex_scroll3, idx);
+		src = &gfx_scroll3[code << 9];
+		col = color_table[attr & 0x0f];
+
+		while (lines--)
+		{
+			tile = *(uint32_t *)(src + 0);
+			*(uint32_t *)(dst +  0) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst +  4) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			tile = *(uint32_t *)(src + 4);
+			*(uint32_t *)(dst +  8) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst + 12) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			tile = *(uint32_t *)(src + 8);
+			*(uint32_t *)(dst + 16) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst + 20) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			tile = *(uint32_t *)(src + 12);
+			*(uint32_t *)(dst + 24) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst + 28) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			src += 16;
+			dst += BUF_WIDTH;
+		}
+	}
+
+	if (attr & 0x10)
+	{
+		vertices = &vertices_scroll[1][clut1_num];
+		clut1_num += 2;
+	}
+	else
+	{
+		vertices = &vertices_scroll[0][clut0_num];
+		clut0_num += 2;
+	}
+
+	vertices[0].x = vertices[1].x = x;
+	vertices[0].y = vertices[1].y = y;
+	vertices[0].u = vertices[1].u = (idx & 0x000f) << 5;
+	vertices[0].v = vertices[1].v = (idx & 0x00f0) << 1;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 32;
+	vertices[(attr & 0x40) >> 6].v += 32;
+
+	vertices[1].x += 32;
+	vertices[1].y += 32;
+}
+
+
+/*------------------------------------------------------------------------
+	End SCROLL3 drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll3(void)
+{
+	blit_finish_scroll(&layer_clip, tex_scroll3, 96, 112);
+}
+
+
+/*------------------------------------------------------------------------
+	Register SCROLL1 (high layer) to draw list
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll1h(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint16_t tpens, uint16_t gfxset)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_HIGH_KEY(code, attr);
+
+	if ((idx = scrollh_get_sprite(key)) < 0)
+	{
+		uint32_t *src, tile, lines = 8;
+		uint16_t *dst, *pal, pal2[16];
+
+		if (tile_cache_full(&scrollh_cache))
+		{
+			cps1_scan_scroll1_foreground();
+			scrollh_delete_sprite();
+		}
+
+		idx = scrollh_insert_sprite(key);
+		dst = NONE_SWIZZLED_8x8(tex_scrollh, idx);
+		src = (uint32_t *)&gfx_scroll1[(code << 6) + (gfxset << 2)];
+		pal = &video_palette[((attr & 0x1f) + 32) << 4];
+
+		if (tpens != 0x7fff)
+		{
+			int i;
+
+			for (i = 0; i < 15; i++)
+				pal2[i] = (tpens & (1 << i)) ? pal[i] : 0x8000;
+			pal2[15] = 0x8000;
+			pal = pal2;
+		}
+
+		while (lines--)
+		{
+			tile = src[0];
+			dst[0] = pal[tile & 0x0f]; tile >>= 4;
+			dst[4] = pal[tile & 0x0f]; tile >>= 4;
+			dst[1] = pal[tile & 0x0f]; tile >>= 4;
+			dst[5] = pal[tile & 0x0f]; tile >>= 4;
+			dst[2] = pal[tile & 0x0f]; tile >>= 4;
+			dst[6] = pal[tile & 0x0f]; tile >>= 4;
+			dst[3] = pal[tile & 0x0f]; tile >>= 4;
+			dst[7] = pal[tile & 0x0f];
+			src += 2;
+			dst += BUF_WIDTH;
+		}
+	}
+
+	vertices = &vertices_scrollh[scrollh_num];
+
+	vertices[0].u = vertices[1].u = (idx & 0x003f) << 3;
+	vertices[0].v = vertices[1].v = (idx & 0x0fc0) >> 3;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 8;
+	vertices[(attr & 0x40) >> 6].v += 8;
+
+	vertices[0].x = x;
+	vertices[0].y = y;
+
+	vertices[1].x = x + 8;
+	vertices[1].y = y + 8;
+
+	scrollh_num += 2;
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL2 (high layer/line scroll) directly to VRAM
+------------------------------------------------------------------------*/
+
+static void blit_draw_scroll2h_software(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint16_t tpens)
+{
+	uint32_t src, dst;
+	uint8_t func;
+
+	src = code << 7;
+
+	if (attr & 0x40)
+	{
+		src += ((y + 16) - scroll2_ey) << 3;
+		dst = ((scroll2_ey - 1) << 9) + x;
+	}
+	else
+	{
+		src += (scroll2_sy - y) << 3;
+		dst = (scroll2_sy << 9) + x;
+	}
+
+	if (tpens == 0x7fff)
+	{
+		func = pen_usage[code] | ((attr & 0x60) >> 4);
+
+		(*drawgfx16[func])((uint32_t *)&gfx_scroll2[src],
+						&scrbitmap[dst],
+						&video_palette[((attr & 0x1f) + 64) << 4],
+						scroll2_ey - scroll2_sy);
+	}
+	else
+	{
+		func = (attr & 0x60) >> 5;
+
+		(*drawgfx16h[func])((uint32_t *)&gfx_scroll2[src],
+						&scrbitmap[dst],
+						&video_palette[((attr & 0x1f) + 64) << 4],
+						scroll2_ey - scroll2_sy,
+						tpens);
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL2 (high layer) texture
+------------------------------------------------------------------------*/
+
+void blit_update_scroll2h(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	if (y + 16 > 0 && y < 239)
+		scrollh_mark_sprite(MAKE_HIGH_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Register SCROLL2 (high layer) to draw list
+------------------------------------------------------------------------*/
+
+static void blit_draw_scroll2h_hardware(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint16_t tpens)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_HIGH_KEY(code, attr);
+
+	if ((idx = scrollh_get_sprite(key)) < 0)
+	{
+		uint32_t *src, tile, lines = 16;
+		uint16_t *dst, *pal, pal2[16];
+
+		if (tile_cache_full(&scrollh_cache))
+		{
+			cps1_scan_scroll2_foreground();
+			scrollh_delete_sprite();
+		}
+
+		idx = scrollh_insert_sprite(key);
+		dst = NONE_SWIZZLED_16x16(tex_scrollh, idx);
+		src = (uint32_t *)&gfx_scroll2[code << 7];
+		pal = &video_palette[((attr & 0x1f) + 64) << 4];
+
+		if (tpens != 0x7fff)
+		{
+			int i;
+
+			for (i = 0; i < 15; i++)
+				pal2[i] = (tpens & (1 << i)) ? pal[i] : 0x8000;
+			pal2[15] = 0x8000;
+			pal = pal2;
+		}
+
+		while (lines--)
+		{
+			tile = src[0];
+			dst[ 0] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 7] = pal[tile & 0x0f];
+			tile = src[1];
+			dst[ 8] = pal[tile & 0x0f]; tile >>= 4;
+			dst[12] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
+			dst[13] = pal[tile & 0x0f]; tile >>= 4;
+			dst[10] = pal[tile & 0x0f]; tile >>= 4;
+			dst[14] = pal[tile & 0x0f]; tile >>= 4;
+			dst[11] = pal[tile & 0x0f]; tile >>= 4;
+			dst[15] = pal[tile & 0x0f];
+			src += 2;
+			dst += BUF_WIDTH;
+		}
+	}
+
+	vertices = &vertices_scrollh[scrollh_num];
+
+	vertices[0].u = vertices[1].u = (idx & 0x001f) << 4;
+	vertices[0].v = vertices[1].v = (idx & 0x03e0) >> 1;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 16;
+	vertices[(attr & 0x40) >> 6].v += 16;
+
+	vertices[0].x = x;
+	vertices[0].y = y;
+
+	vertices[1].x = x + 16;
+	vertices[1].y = y + 16;
+
+	scrollh_num += 2;
+}
+
+
+/*------------------------------------------------------------------------
+	End SCROLL2 (high layer) drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll2h(void)
+{
+	if (!scrollh_num) return;
+
+	soft_blit_rgb16(scrbitmap, &scroll2_clip, tex_scrollh, vertices_scrollh, scrollh_num);
+
+	scrollh_num = 0;
+}
+
+
+/*------------------------------------------------------------------------
+	Register SCROLL3 (high layer) to draw list
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll3h(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint16_t tpens)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_HIGH_KEY(code, attr);
+
+	if ((idx = scrollh_get_sprite(key)) < 0)
+	{
+		uint32_t *src, tile, lines = 32;
+		uint16_t *dst, *pal, pal2[16];
+
+		if (tile_cache_full(&scrollh_cache))
+		{
+			cps1_scan_scroll3_foreground();
+			scrollh_delete_sprite();
+		}
+
+		idx = scrollh_insert_sprite(key);
+		dst = NONE_SWIZZLED_32x32(tex_scrollh, idx);
+		src = (uint32_t *)&gfx_scroll3[code << 9];
+		pal = &video_palette[((attr & 0x1f) + 96) << 4];
+
+		if (tpens != 0x7fff)
+		{
+			int i;
+
+			for (i = 0; i < 15; i++)
+				pal2[i] = (tpens & (1 << i)) ? pal[i] : 0x8000;
+			pal2[15] = 0x8000;
+			pal = pal2;
+		}
+
+		while (lines--)
+		{
+			tile = src[0];
+			dst[ 0] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 7] = pal[tile & 0x0f];
+			tile = src[1];
+			dst[ 8] = pal[tile & 0x0f]; tile >>= 4;
+			dst[12] = pal[tile & 0x0f]; tile >>= 4;
+			dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
+			dst[13] = pal[tile & 0x0f]; tile >>= 4;
+			dst[10] = pal[tile & 0x0f]; tile >>= 4;
+			dst[14] = pal[tile & 0x0f]; tile >>= 4;
+			dst[11] = pal[tile & 0x0f]; tile >>= 4;
+			dst[15] = pal[tile & 0x0f];
+			tile = src[2];
+			dst[16] = pal[tile & 0x0f]; tile >>= 4;
+			dst[20] = pal[tile & 0x0f]; tile >>= 4;
+			dst[17] = pal[tile & 0x0f]; tile >>= 4;
+			dst[21] = pal[tile & 0x0f]; tile >>= 4;
+			dst[18] = pal[tile & 0x0f]; tile >>= 4;
+			dst[22] = pal[tile & 0x0f]; tile >>= 4;
+			dst[19] = pal[tile & 0x0f]; tile >>= 4;
+			dst[23] = pal[tile & 0x0f];
+			tile = src[3];
+			dst[24] = pal[tile & 0x0f]; tile >>= 4;
+			dst[28] = pal[tile & 0x0f]; tile >>= 4;
+			dst[25] = pal[tile & 0x0f]; tile >>= 4;
+			dst[29] = pal[tile & 0x0f]; tile >>= 4;
+			dst[26] = pal[tile & 0x0f]; tile >>= 4;
+			dst[30] = pal[tile & 0x0f]; tile >>= 4;
+			dst[27] = pal[tile & 0x0f]; tile >>= 4;
+			dst[31] = pal[tile & 0x0f];
+			src += 4;
+			dst += BUF_WIDTH;
+		}
+	}
+
+	vertices = &vertices_scrollh[scrollh_num];
+
+	vertices[0].u = vertices[1].u = (idx & 0x000f) << 5;
+	vertices[0].v = vertices[1].v = (idx & 0x00f0) << 1;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 32;
+	vertices[(attr & 0x40) >> 6].v += 32;
+
+	vertices[0].x = x;
+	vertices[1].x = x + 32;
+
+	vertices[0].y = y;
+	vertices[1].y = y + 32;
+
+	scrollh_num += 2;
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL1,3 (high layer) texture
+------------------------------------------------------------------------*/
+
+void blit_update_scrollh(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	scrollh_mark_sprite(MAKE_HIGH_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	End SCROLL1,3 (high layer) drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_scrollh(void)
+{
+	if (!scrollh_num) return;
+
+	soft_blit_rgb16(scrbitmap, &layer_clip, tex_scrollh, vertices_scrollh, scrollh_num);
+}
+
+
+#if USE_TILEMAP_SURFACE
+/*------------------------------------------------------------------------
+	Update SCROLL1 surface tile
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll1_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr, uint16_t gfxset)
+{
+	if (soft_tilemap_check(&scroll1_map, col, row, code, attr))
+	{
+		if (code == SOFT_TILEMAP_BLANK)
+			soft_tilemap_decode(&scroll1_map, col, row, NULL, 0, attr, 0);
+		else
+			soft_tilemap_decode(&scroll1_map, col, row, &gfx_scroll1[(code << 6) + (gfxset << 2)], 8, attr, (attr & 0x1f) + 32);
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL1 surface
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll1_surface(int16_t scrollx, int16_t scrolly)
+{
+	soft_tilemap_draw(scrbitmap, &layer_clip, &scroll1_map, clut, scrollx, scrolly);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL2 surface tile
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll2_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr)
+{
+	if (soft_tilemap_check(&scroll2_map, col, row, code, attr))
+	{
+		if (code == SOFT_TILEMAP_BLANK)
+			soft_tilemap_decode(&scroll2_map, col, row, NULL, 0, attr, 0);
+		else
+			soft_tilemap_decode(&scroll2_map, col, row, &gfx_scroll2[code << 7], 8, attr, (attr & 0x1f) + 64);
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL2 surface (lines of the current line scroll block)
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll2_surface(int16_t scrollx, int16_t scrolly)
+{
+	soft_tilemap_draw(scrbitmap, &scroll2_clip, &scroll2_map, clut, scrollx, scrolly);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL3 surface tile
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll3_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr)
+{
+	if (soft_tilemap_check(&scroll3_map, col, row, code, attr))
+	{
+		if (code == SOFT_TILEMAP_BLANK)
+			soft_tilemap_decode(&scroll3_map, col, row, NULL, 0, attr, 0);
+		else
+			soft_tilemap_decode(&scroll3_map, col, row, &gfx_scroll3[code << 9], 16, attr, (attr & 0x1f) + 96);
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL3 surface
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll3_surface(int16_t scrollx, int16_t scrolly)
+{
+	soft_tilemap_draw(scrbitmap, &layer_clip, &scroll3_map, clut, scrollx, scrolly);
+}
+#endif
+
+
+/*------------------------------------------------------------------------
+	Draw STARS layer
+------------------------------------------------------------------------*/
+
+void blit_draw_stars(uint16_t stars_x, uint16_t stars_y, uint8_t *col, uint16_t *pal)
+{
+	uint16_t offs;
+	int16_t x, y;
+
+	for (offs = 0; offs < 0x1000; offs++, col += 8)
+	{
+		if (*col != 0x0f)
+		{
+			x = (((offs >> 8) << 5) - stars_x + (*col & 0x1f)) & 0x1ff;
+			y = ((offs & 0xff) - stars_y) & 0xff;
+
+			if (x >= layer_clip.left && x < layer_clip.right && y >= layer_clip.top && y < layer_clip.bottom)
+				scrbitmap[(y << 9) + x] = pal[(*col & 0xe0) >> 1];
+		}
+	}
+}
@@ -100,43 +100,12 @@ static const int ALIGN_DATA swizzle_table_8bit[32] =
 
 void blit_clear_all_sprite(void)
 {
-	int i;
+	tile_cache_clear(&object_cache);
+	tile_cache_clear(&scroll1_cache);
+	tile_cache_clear(&scroll2_cache);
+	tile_cache_clear(&scroll3_cache);
 
-	for (i = 0; i < OBJECT_TEXTURE_SIZE - 1; i++)
-		object_data[i].next = &object_data[i + 1];
-
-	object_data[i].next = NULL;
-	object_free_head = &object_data[0];
-
-	for (i = 0; i < SCROLL1_TEXTURE_SIZE - 1; i++)
-		scroll1_data[i].next = &scroll1_data[i + 1];
-
-	scroll1_data[i].next = NULL;
-	scroll1_free_head = &scroll1_data[0];
-
-	for (i = 0; i < SCROLL2_TEXTURE_SIZE - 1; i++)
-		scroll2_data[i].next = &scroll2_data[i + 1];
-
-	scroll2_data[i].next = NULL;
-	scroll2_free_head = &scroll2_data[0];
-
-	for (i = 0; i < SCROLL3_TEXTURE_SIZE - 1; i++)
-		scroll3_data[i].next = &scroll3_data[i + 1];
-
-	scroll3_data[i].next = NULL;
-	scroll3_free_head = &scroll3_data[0];
-
-	memset(object_head, 0, sizeof(SPRITE *) * OBJECT_HASH_SIZE);
-	memset(scroll1_head, 0, sizeof(SPRITE *) * SCROLL1_HASH_SIZE);
-	memset(scroll2_head, 0, sizeof(SPRITE *) * SCROLL2_HASH_SIZE);
-	memset(scroll3_head, 0, sizeof(SPRITE *) * SCROLL3_HASH_SIZE);
-
-	object_texture_num = 0;
-	scroll1_texture_num = 0;
-	scroll2_texture_num = 0;
-	scroll3_texture_num = 0;
-
-	scrollh_reset_sprite();
+	scrollh_reset_sprite(0);
 	memset(palette_dirty_marks, 0, sizeof(palette_dirty_marks));
 }
 
@@ -171,8 +140,6 @@ void blit_palette_mark_dirty(int palno)
 
 void blit_reset(int bank_scroll1, int bank_scroll2, int bank_scroll3, uint8_t *pen_usage16)
 {
-	int i;
-
 	// TODO: FJTRUJY - Make this function more generic
 	scrbitmap  = (uint16_t *)video_driver->workFrame(video_data, SCRBITMAP);
 	tex_scrollh = scrbitmap + BUF_WIDTH * SCR_HEIGHT;
@@ -181,12 +148,6 @@ void blit_reset(int bank_scroll1, int bank_scroll2, int bank_scroll3, uint8_t *p
 	tex_scroll2 = tex_scroll1 + BUF_WIDTH * TEXTURE_HEIGHT;
 	tex_scroll3 = tex_scroll2 + BUF_WIDTH * TEXTURE_HEIGHT;
 
-	for (i = 0; i < OBJECT_TEXTURE_SIZE; i++) object_data[i].index = i;
-	for (i = 0; i < SCROLL1_TEXTURE_SIZE; i++) scroll1_data[i].index = i;
-	for (i = 0; i < SCROLL2_TEXTURE_SIZE; i++) scroll2_data[i].index = i;
-	for (i = 0; i < SCROLL3_TEXTURE_SIZE; i++) scroll3_data[i].index = i;
-	for (i = 0; i < SCROLLH_TEXTURE_SIZE; i++) scrollh_data[i].index = i;
-
 	gfx_object  = memory_region_gfx1;
 	gfx_scroll1 = &memory_region_gfx1[bank_scroll1 << 21];
 	gfx_scroll2 = &memory_region_gfx1[bank_scroll2 << 21];
@@ -206,10 +167,7 @@ void blit_reset(int bank_scroll1, int bank_scroll2, int bank_scroll3, uint8_t *p
 void blit_start(int high_layer)
 {
 	if (scrollh_texture_clear || high_layer != scrollh_layer_number)
-	{
-		scrollh_reset_sprite();
-		scrollh_layer_number = high_layer;
-	}
+		scrollh_reset_sprite(high_layer);
 
 	scrollh_delete_dirty_palette();
 	memset(palette_dirty_marks, 0, sizeof(palette_dirty_marks));
@@ -270,20 +228,7 @@ void blit_finish(void)
 void blit_update_object(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
 	if ((x > 47 && x < 448) && (y > 0 && y < 239))
-	{
-		uint32_t key = MAKE_KEY(code, attr);
-		SPRITE *p = object_head[key & OBJECT_HASH_MASK];
-
-		while (p)
-		{
-			if (p->key == key)
-			{
-				p->used = frames_displayed;
-				return;
-		 	}
-			p = p->next;
-		}
-	}
+		object_mark_sprite(MAKE_KEY(code, attr));
 }
 
 
@@ -305,7 +250,7 @@ void blit_draw_object(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 			uint32_t col, tile;
 			uint8_t *src, *dst, lines = 16;
 
-			if (object_texture_num == OBJECT_TEXTURE_SIZE - 1)
+			if (tile_cache_full(&object_cache))
 			{
 				cps1_scan_object();
 				object_delete_sprite();
@@ -413,18 +358,7 @@ void blit_finish_object(void)
 
 void blit_update_scroll1(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
-	uint32_t key = MAKE_KEY(code, attr);
-	SPRITE *p = scroll1_head[key & SCROLL1_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return;
-		}
-		p = p->next;
-	}
+	scroll1_mark_sprite(MAKE_KEY(code, attr));
 }
 
 
@@ -443,7 +377,7 @@ void blit_draw_scroll1(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint1
 		uint32_t col, tile;
 		uint8_t *src, *dst, lines = 8;
 
-		if (scroll1_texture_num == SCROLL1_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scroll1_cache))
 		{
 			cps1_scan_scroll1();
 			scroll1_delete_sprite();
@@ -577,20 +511,7 @@ int blit_check_clip_scroll2(int16_t sy)
 void blit_update_scroll2(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
 	if (y + 16 > 0 && y < 239)
-	{
-		uint32_t key = MAKE_KEY(code, attr);
-		SPRITE *p = scroll2_head[key & SCROLL2_HASH_MASK];
-
-		while (p)
-		{
-			if (p->key == key)
-			{
-				p->used = frames_displayed;
-				return;
-			}
-			p = p->next;
-		}
-	}
+		scroll2_mark_sprite(MAKE_KEY(code, attr));
 }
 
 
@@ -640,7 +561,7 @@ static void blit_draw_scroll2_hardware(int16_t x, int16_t y, uint32_t code, uint
 		uint32_t col, tile;
 		uint8_t *src, *dst, lines = 16;
 
-		if (scroll2_texture_num == SCROLL2_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scroll2_cache))
 		{
 			cps1_scan_scroll2();
 			scroll2_delete_sprite();
@@ -738,18 +659,7 @@ void blit_finish_scroll2(void)
 
 void blit_update_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
-	uint32_t key = MAKE_KEY(code, attr);
-	SPRITE *p = scroll3_head[key & SCROLL3_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return;
-		}
-		p = p->next;
-	}
+	scroll3_mark_sprite(MAKE_KEY(code, attr));
 }
 
 
@@ -768,7 +678,7 @@ void blit_draw_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 		uint32_t col, tile;
 		uint8_t *src, *dst, lines = 32;
 
-		if (scroll3_texture_num == SCROLL3_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scroll3_cache))
 		{
 			cps1_scan_scroll3();
 			scroll3_delete_sprite();
@@ -881,7 +791,7 @@ void blit_draw_scroll1h(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint
 		uint32_t *src, tile, lines = 8;
 		uint16_t *dst, *pal, pal2[16];
 
-		if (scrollh_texture_num == SCROLL1H_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scrollh_cache))
 		{
 			cps1_scan_scroll1_foreground();
 			scrollh_delete_sprite();
@@ -988,20 +898,7 @@ static void blit_draw_scroll2h_software(int16_t x, int16_t y, uint32_t code, uin
 void blit_update_scroll2h(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
 	if (y + 16 > 0 && y < 239)
-	{
-		uint32_t key = MAKE_HIGH_KEY(code, attr);
-		SPRITE *p = scrollh_head[key & SCROLLH_HASH_MASK];
-
-		while (p)
-		{
-			if (p->key == key)
-			{
-				p->used = frames_displayed;
-				return;
-			}
-			p = p->next;
-		}
-	}
+		scrollh_mark_sprite(MAKE_HIGH_KEY(code, attr));
 }
 
 
@@ -1020,7 +917,7 @@ static void blit_draw_scroll2h_hardware(int16_t x, int16_t y, uint32_t code, uin
 		uint32_t *src, tile, lines = 16;
 		uint16_t *dst, *pal, pal2[16];
 
-		if (scrollh_texture_num == SCROLL2H_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scrollh_cache))
 		{
 			cps1_scan_scroll2_foreground();
 			scrollh_delete_sprite();
@@ -1128,7 +1025,7 @@ void blit_draw_scroll3h(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint
 		uint32_t *src, tile, lines = 32;
 		uint16_t *dst, *pal, pal2[16];
 
-		if (scrollh_texture_num == SCROLL3H_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scrollh_cache))
 		{
 			cps1_scan_scroll3_foreground();
 			scrollh_delete_sprite();
@@ -1217,18 +1114,7 @@ void blit_draw_scroll3h(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint
 
 void blit_update_scrollh(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
-	uint32_t key = MAKE_HIGH_KEY(code, attr);
-	SPRITE *p = scrollh_head[key & SCROLLH_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return;
-		}
-		p = p->next;
-	}
+	scrollh_mark_sprite(MAKE_HIGH_KEY(code, attr));
 }
 
 
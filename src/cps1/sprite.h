@@ -47,6 +47,15 @@ void blit_draw_scroll3h(int16_t x, int16_t y, uint32_t code, uint16_t attr, uint
 void blit_update_scrollh(int16_t x, int16_t y, uint32_t code, uint16_t attr);
 void blit_finish_scrollh(void);
 
+#if USE_TILEMAP_SURFACE
+void blit_draw_scroll1_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr, uint16_t gfxset);
+void blit_finish_scroll1_surface(int16_t scrollx, int16_t scrolly);
+void blit_draw_scroll2_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr);
+void blit_finish_scroll2_surface(int16_t scrollx, int16_t scrolly);
+void blit_draw_scroll3_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr);
+void blit_finish_scroll3_surface(int16_t scrollx, int16_t scrolly);
+#endif
+
 void blit_draw_stars(uint16_t stars_x, uint16_t stars_y, uint8_t *col, uint16_t *pal);
 
 #endif /* CPS1_SPRITE_H */
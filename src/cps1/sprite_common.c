@@ -30,44 +30,34 @@
 uint8_t ALIGN_DATA palette_dirty_marks[256];
 
 /* OBJECT */
-SPRITE ALIGN_DATA *object_head[OBJECT_HASH_SIZE];
-SPRITE ALIGN_DATA object_data[OBJECT_TEXTURE_SIZE];
-SPRITE *object_free_head;
+TILE_CACHE_STORAGE(object, OBJECT_TEXTURE_SIZE, OBJECT_HASH_SIZE);
+TILE_CACHE object_cache = TILE_CACHE_INIT(object, OBJECT_TEXTURE_SIZE, OBJECT_HASH_SIZE);
 uint8_t *gfx_object;
 uint8_t *tex_object;
-uint16_t object_texture_num;
 
 /* SCROLL1 */
-SPRITE ALIGN_DATA *scroll1_head[SCROLL1_HASH_SIZE];
-SPRITE ALIGN_DATA scroll1_data[SCROLL1_TEXTURE_SIZE];
-SPRITE *scroll1_free_head;
+TILE_CACHE_STORAGE(scroll1, SCROLL1_TEXTURE_SIZE, SCROLL1_HASH_SIZE);
+TILE_CACHE scroll1_cache = TILE_CACHE_INIT(scroll1, SCROLL1_TEXTURE_SIZE, SCROLL1_HASH_SIZE);
 uint8_t *gfx_scroll1;
 uint8_t *tex_scroll1;
-uint16_t scroll1_texture_num;
 
 /* SCROLL2 */
-SPRITE ALIGN_DATA *scroll2_head[SCROLL2_HASH_SIZE];
-SPRITE ALIGN_DATA scroll2_data[SCROLL2_TEXTURE_SIZE];
-SPRITE *scroll2_free_head;
+TILE_CACHE_STORAGE(scroll2, SCROLL2_TEXTURE_SIZE, SCROLL2_HASH_SIZE);
+TILE_CACHE scroll2_cache = TILE_CACHE_INIT(scroll2, SCROLL2_TEXTURE_SIZE, SCROLL2_HASH_SIZE);
 uint8_t *gfx_scroll2;
 uint8_t *tex_scroll2;
-uint16_t scroll2_texture_num;
 
 /* SCROLL3 */
-SPRITE ALIGN_DATA *scroll3_head[SCROLL3_HASH_SIZE];
-SPRITE ALIGN_DATA scroll3_data[SCROLL3_TEXTURE_SIZE];
-SPRITE *scroll3_free_head;
+TILE_CACHE_STORAGE(scroll3, SCROLL3_TEXTURE_SIZE, SCROLL3_HASH_SIZE);
+TILE_CACHE scroll3_cache = TILE_CACHE_INIT(scroll3, SCROLL3_TEXTURE_SIZE, SCROLL3_HASH_SIZE);
 uint8_t *gfx_scroll3;
 uint8_t *tex_scroll3;
-uint16_t scroll3_texture_num;
 
 /* SCROLLH */
-SPRITE ALIGN_DATA *scrollh_head[SCROLLH_HASH_SIZE];
-SPRITE ALIGN_DATA scrollh_data[SCROLLH_TEXTURE_SIZE];
-SPRITE *scrollh_free_head;
+TILE_CACHE_STORAGE(scrollh, SCROLLH_TEXTURE_SIZE, SCROLLH_HASH_SIZE);
+TILE_CACHE scrollh_cache = TILE_CACHE_INIT(scrollh, SCROLLH_TEXTURE_SIZE, SCROLLH_HASH_SIZE);
 uint16_t *tex_scrollh;
 uint16_t scrollh_num;
-uint16_t scrollh_texture_num;
 uint8_t scrollh_texture_clear;
 uint8_t scrollh_layer_number;
 uint8_t scroll1_palette_is_dirty;
@@ -575,52 +565,27 @@ void drawgfx16h_16x16_flipxy(uint32_t *src, uint16_t *dst, uint16_t *pal, int li
 
 int16_t object_get_sprite(uint32_t key)
 {
-	SPRITE *p = object_head[key & OBJECT_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return p->index;
-	 	}
-		p = p->next;
-	}
-	return -1;
+	return tile_cache_get(&object_cache, key);
 }
 
 
 /*------------------------------------------------------------------------
-	Register sprite in OBJECT texture
+	Keep sprite in OBJECT texture without drawing it
 ------------------------------------------------------------------------*/
 
-int16_t object_insert_sprite(uint32_t key)
+void object_mark_sprite(uint32_t key)
 {
-	uint16_t hash = key & OBJECT_HASH_MASK;
-	SPRITE *p = object_head[hash];
-	SPRITE *q = object_free_head;
-
-	if (!q) return -1;
-
-	object_free_head = object_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
+	tile_cache_mark(&object_cache, key);
+}
 
-	if (!p)
-	{
-		object_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
 
-	object_texture_num++;
+/*------------------------------------------------------------------------
+	Register sprite in OBJECT texture
+------------------------------------------------------------------------*/
 
-	return q->index;
+int16_t object_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&object_cache, key);
 }
 
 
@@ -630,42 +595,7 @@ int16_t object_insert_sprite(uint32_t key)
 
 void object_delete_sprite(void)
 {
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < OBJECT_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = object_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				object_texture_num--;
-
-				if (!prev_p)
-				{
-					object_head[i] = p->next;
-					p->next = object_free_head;
-					object_free_head = p;
-					p = object_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = object_free_head;
-					object_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
+	tile_cache_evict(&object_cache);
 }
 
 
@@ -679,52 +609,27 @@ void object_delete_sprite(void)
 
 int16_t scroll1_get_sprite(uint32_t key)
 {
-	SPRITE *p = scroll1_head[key & SCROLL1_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return p->index;
-	 	}
-		p = p->next;
-	}
-	return -1;
+	return tile_cache_get(&scroll1_cache, key);
 }
 
 
 /*------------------------------------------------------------------------
-	Register sprite in SCROLL1 texture
+	Keep sprite in SCROLL1 texture without drawing it
 ------------------------------------------------------------------------*/
 
-int16_t scroll1_insert_sprite(uint32_t key)
+void scroll1_mark_sprite(uint32_t key)
 {
-	uint16_t hash = key & SCROLL1_HASH_MASK;
-	SPRITE *p = scroll1_head[hash];
-	SPRITE *q = scroll1_free_head;
-
-	if (!q) return -1;
-
-	scroll1_free_head = scroll1_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
+	tile_cache_mark(&scroll1_cache, key);
+}
 
-	if (!p)
-	{
-		scroll1_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
 
-	scroll1_texture_num++;
+/*------------------------------------------------------------------------
+	Register sprite in SCROLL1 texture
+------------------------------------------------------------------------*/
 
-	return q->index;
+int16_t scroll1_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&scroll1_cache, key);
 }
 
 
@@ -734,42 +639,7 @@ int16_t scroll1_insert_sprite(uint32_t key)
 
 void scroll1_delete_sprite(void)
 {
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < SCROLL1_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = scroll1_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				scroll1_texture_num--;
-
-				if (!prev_p)
-				{
-					scroll1_head[i] = p->next;
-					p->next = scroll1_free_head;
-					scroll1_free_head = p;
-					p = scroll1_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = scroll1_free_head;
-					scroll1_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
+	tile_cache_evict(&scroll1_cache);
 }
 
 
@@ -783,52 +653,27 @@ void scroll1_delete_sprite(void)
 
 int16_t scroll2_get_sprite(uint32_t key)
 {
-	SPRITE *p = scroll2_head[key & SCROLL2_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return p->index;
-	 	}
-		p = p->next;
-	}
-	return -1;
+	return tile_cache_get(&scroll2_cache, key);
 }
 
 
 /*------------------------------------------------------------------------
-	Register sprite in SCROLL2 texture
+	Keep sprite in SCROLL2 texture without drawing it
 ------------------------------------------------------------------------*/
 
-int16_t scroll2_insert_sprite(uint32_t key)
+void scroll2_mark_sprite(uint32_t key)
 {
-	uint16_t hash = key & SCROLL2_HASH_MASK;
-	SPRITE *p = scroll2_head[hash];
-	SPRITE *q = scroll2_free_head;
-
-	if (!q) return -1;
-
-	scroll2_free_head = scroll2_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
+	tile_cache_mark(&scroll2_cache, key);
+}
 
-	if (!p)
-	{
-		scroll2_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
 
-	scroll2_texture_num++;
+/*------------------------------------------------------------------------
+	Register sprite in SCROLL2 texture
+------------------------------------------------------------------------*/
 
-	return q->index;
+int16_t scroll2_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&scroll2_cache, key);
 }
 
 
@@ -838,42 +683,7 @@ int16_t scroll2_insert_sprite(uint32_t key)
 
 void scroll2_delete_sprite(void)
 {
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < SCROLL2_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = scroll2_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				scroll2_texture_num--;
-
-				if (!prev_p)
-				{
-					scroll2_head[i] = p->next;
-					p->next = scroll2_free_head;
-					scroll2_free_head = p;
-					p = scroll2_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = scroll2_free_head;
-					scroll2_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
+	tile_cache_evict(&scroll2_cache);
 }
 
 
@@ -887,52 +697,27 @@ void scroll2_delete_sprite(void)
 
 int16_t scroll3_get_sprite(uint32_t key)
 {
-	SPRITE *p = scroll3_head[key & SCROLL3_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return p->index;
-	 	}
-		p = p->next;
-	}
-	return -1;
+	return tile_cache_get(&scroll3_cache, key);
 }
 
 
 /*------------------------------------------------------------------------
-	Register sprite in SCROLL3 texture
+	Keep sprite in SCROLL3 texture without drawing it
 ------------------------------------------------------------------------*/
 
-int16_t scroll3_insert_sprite(uint32_t key)
+void scroll3_mark_sprite(uint32_t key)
 {
-	uint16_t hash = key & SCROLL3_HASH_MASK;
-	SPRITE *p = scroll3_head[hash];
-	SPRITE *q = scroll3_free_head;
-
-	if (!q) return -1;
-
-	scroll3_free_head = scroll3_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
+	tile_cache_mark(&scroll3_cache, key);
+}
 
-	if (!p)
-	{
-		scroll3_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
 
-	scroll3_texture_num++;
+/*------------------------------------------------------------------------
+	Register sprite in SCROLL3 texture
+------------------------------------------------------------------------*/
 
-	return q->index;
+int16_t scroll3_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&scroll3_cache, key);
 }
 
 
@@ -942,42 +727,7 @@ int16_t scroll3_insert_sprite(uint32_t key)
 
 void scroll3_delete_sprite(void)
 {
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < SCROLL3_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = scroll3_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				scroll3_texture_num--;
-
-				if (!prev_p)
-				{
-					scroll3_head[i] = p->next;
-					p->next = scroll3_free_head;
-					scroll3_free_head = p;
-					p = scroll3_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = scroll3_free_head;
-					scroll3_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
+	tile_cache_evict(&scroll3_cache);
 }
 
 
@@ -987,23 +737,22 @@ void scroll3_delete_sprite(void)
 
 /*------------------------------------------------------------------------
 	Reset SCROLLH texture
+
+	The texture is shared by SCROLL1/2/3, so the number of usable
+	slots follows the tile size of the high priority layer.
 ------------------------------------------------------------------------*/
 
-void scrollh_reset_sprite(void)
+void scrollh_reset_sprite(uint8_t layer)
 {
-	int i;
-
-	for (i = 0; i < SCROLLH_TEXTURE_SIZE - 1; i++)
-		scrollh_data[i].next = &scrollh_data[i + 1];
-
-	scrollh_data[i].next = NULL;
-	scrollh_free_head = &scrollh_data[0];
-
-	memset(scrollh_head, 0, sizeof(SPRITE *) * SCROLLH_HASH_SIZE);
+	switch (layer)
+	{
+	case LAYER_SCROLL2: tile_cache_set_size(&scrollh_cache, SCROLL2H_TEXTURE_SIZE); break;
+	case LAYER_SCROLL3: tile_cache_set_size(&scrollh_cache, SCROLL3H_TEXTURE_SIZE); break;
+	default:            tile_cache_set_size(&scrollh_cache, SCROLL1H_TEXTURE_SIZE); break;
+	}
 
-	scrollh_texture_num = 0;
 	scrollh_texture_clear = 0;
-	scrollh_layer_number = 0;
+	scrollh_layer_number = layer;
 
 	scroll1_palette_is_dirty = 0;
 	scroll2_palette_is_dirty = 0;
@@ -1017,53 +766,27 @@ void scrollh_reset_sprite(void)
 
 int16_t scrollh_get_sprite(uint32_t key)
 {
-	SPRITE *p = scrollh_head[key & SCROLLH_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return p->index;
-	 	}
-		p = p->next;
-	}
-	return -1;
+	return tile_cache_get(&scrollh_cache, key);
 }
 
 
 /*------------------------------------------------------------------------
-	Register sprite in SCROLLH texture
+	Keep sprite in SCROLLH texture without drawing it
 ------------------------------------------------------------------------*/
 
-int16_t scrollh_insert_sprite(uint32_t key)
+void scrollh_mark_sprite(uint32_t key)
 {
-	uint16_t hash = key & SCROLLH_HASH_MASK;
-	SPRITE *p = scrollh_head[hash];
-	SPRITE *q = scrollh_free_head;
-
-	if (!q) return -1;
-
-	scrollh_free_head = scrollh_free_head->next;
+	tile_cache_mark(&scrollh_cache, key);
+}
 
-	q->next = NULL;
-	q->key  = key;
-	q->pal  = (key >> 16) & 0x1f;
-	q->used = frames_displayed;
 
-	if (!p)
-	{
-		scrollh_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
-
-	scrollh_texture_num++;
+/*------------------------------------------------------------------------
+	Register sprite in SCROLLH texture
+------------------------------------------------------------------------*/
 
-	return q->index;
+int16_t scrollh_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&scrollh_cache, key);
 }
 
 
@@ -1073,42 +796,7 @@ int16_t scrollh_insert_sprite(uint32_t key)
 
 void scrollh_delete_sprite(void)
 {
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < SCROLLH_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = scrollh_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				scrollh_texture_num--;
-
-				if (!prev_p)
-				{
-					scrollh_head[i] = p->next;
-					p->next = scrollh_free_head;
-					scrollh_free_head = p;
-					p = scrollh_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = scrollh_free_head;
-					scrollh_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
+	tile_cache_evict(&scrollh_cache);
 }
 
 
@@ -1119,40 +807,14 @@ void scrollh_delete_sprite(void)
 void scrollh_delete_sprite_tpens(uint16_t tpens)
 {
 	int i;
-	SPRITE *p, *prev_p;
 
-	for (i = 0; i < SCROLLH_HASH_SIZE; i++)
+	for (i = 0; i < scrollh_cache.size; i++)
 	{
-		prev_p = NULL;
-		p = scrollh_head[i];
+		if (scrollh_cache.slot_state[i] == TILE_SLOT_FREE)
+			continue;
 
-		while (p)
-		{
-			if ((p->key >> 23) == tpens)
-			{
-				scrollh_texture_num--;
-
-				if (!prev_p)
-				{
-					scrollh_head[i] = p->next;
-					p->next = scrollh_free_head;
-					scrollh_free_head = p;
-					p = scrollh_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = scrollh_free_head;
-					scrollh_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
+		if ((scrollh_cache.slot_key[i] >> 23) == tpens)
+			tile_cache_remove(&scrollh_cache, i);
 	}
 }
 
@@ -1163,7 +825,7 @@ void scrollh_delete_sprite_tpens(uint16_t tpens)
 
 void scrollh_delete_dirty_palette(void)
 {
-	int palno;
+	int i;
 	uint8_t *dirty_flags = NULL;
 
 	switch (scrollh_layer_number)
@@ -1177,48 +839,14 @@ void scrollh_delete_dirty_palette(void)
 	scroll2_palette_is_dirty = 0;
 	scroll3_palette_is_dirty = 0;
 
-	if (!dirty_flags || !scrollh_texture_num) return;
+	if (!dirty_flags || !scrollh_cache.num) return;
 
-	for (palno = 0; palno < 32; palno++)
+	for (i = 0; i < scrollh_cache.size; i++)
 	{
-		int i;
-		SPRITE *p, *prev_p;
+		if (scrollh_cache.slot_state[i] == TILE_SLOT_FREE)
+			continue;
 
-		if (!dirty_flags[palno]) continue;
-
-		for (i = 0; i < SCROLLH_HASH_SIZE; i++)
-		{
-			prev_p = NULL;
-			p = scrollh_head[i];
-
-			while (p)
-			{
-				if (p->pal == palno)
-				{
-					scrollh_texture_num--;
-
-					if (!prev_p)
-					{
-						scrollh_head[i] = p->next;
-						p->next = scrollh_free_head;
-						scrollh_free_head = p;
-						p = scrollh_head[i];
-					}
-					else
-					{
-						prev_p->next = p->next;
-						p->next = scrollh_free_head;
-						scrollh_free_head = p;
-						p = prev_p->next;
-					}
-				}
-				else
-				{
-					prev_p = p;
-					p = p->next;
-				}
-			}
-		}
+		if (dirty_flags[(scrollh_cache.slot_key[i] >> 16) & 0x1f])
+			tile_cache_remove(&scrollh_cache, i);
 	}
 }
-
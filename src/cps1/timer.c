@@ -283,6 +283,24 @@ uint32_t timer_get_currentframe(void)
 }
 
 
+/*------------------------------------------------------
+	Get Position in Current Frame (unit: 1/65536 frame)
+------------------------------------------------------*/
+
+int timer_get_frame_offset(void)
+{
+	float time = frame_base;
+	int offset;
+
+	if (active_cpu != CPU_NOTACTIVE)
+		time += cpu_elapsed_time(active_cpu);
+
+	offset = (int)(time * 65536.0 / time_slice);
+
+	return (offset > 0xffff) ? 0xffff : offset;
+}
+
+
 /*------------------------------------------------------
 	Update CPU
 ------------------------------------------------------*/
@@ -42,6 +42,7 @@ int timer_enable(int which, int enable);
 void timer_adjust(int which, float duration, int param, void (*callback)(int raram));
 void timer_set(int which, float duration, int param, void (*callback)(int param));
 uint32_t timer_get_currentframe(void);
+int timer_get_frame_offset(void);
 void timer_update_cpu(void);
 
 #ifdef SAVE_STATE
@@ -754,6 +754,19 @@ void cps1_scan_object(void)
 	Render
 ------------------------------------------------------*/
 
+#if USE_TILEMAP_SURFACE
+#define DRAW_SCROLL1													\
+	if (!cps1_scroll_pen_usage[gfxset][code]) code = SOFT_TILEMAP_BLANK;	\
+	attr = cps_scroll1[offs + 1];										\
+	blit_draw_scroll1_surface(logical_col + x, logical_row + y, code, attr, gfxset);
+
+static void cps1_render_scroll1_normal(void)
+{
+	SCAN_SCROLL1()
+
+	blit_finish_scroll1_surface(cps_scroll1x, cps_scroll1y);
+}
+#else
 #define DRAW_SCROLL1													\
 	if (cps1_scroll_pen_usage[gfxset][code])							\
 	{																	\
@@ -765,6 +778,7 @@ static void cps1_render_scroll1_normal(void)
 {
 	SCAN_SCROLL1()
 }
+#endif
 
 #undef DRAW_SCROLL1
 
@@ -918,6 +932,24 @@ void cps1_scan_scroll1(void)
 #define BLIT_CHECK_CLIP_FUNC	if (!blit_check_clip_scroll2(sy)) continue;
 #define BLIT_FINISH_FUNC		blit_finish_scroll2();
 
+#if USE_TILEMAP_SURFACE
+#undef BLIT_FINISH_FUNC
+#define BLIT_FINISH_FUNC		blit_finish_scroll2_surface(cps_scroll2x, cps_scroll2y);
+
+#define DRAW_SCROLL2													\
+	if (!pen_usage[code]) code = SOFT_TILEMAP_BLANK;					\
+	attr = cps_scroll2[offs + 1];										\
+	blit_draw_scroll2_surface(logical_col + x, logical_row + y, code, attr);
+
+static void cps1_render_scroll2_normal(void)
+{
+	SCAN_SCROLL2()
+}
+
+#undef DRAW_SCROLL2
+#undef BLIT_FINISH_FUNC
+#define BLIT_FINISH_FUNC		blit_finish_scroll2();
+#else
 #define DRAW_SCROLL2													\
 	if (pen_usage[code])												\
 	{																	\
@@ -931,6 +963,7 @@ static void cps1_render_scroll2_normal(void)
 }
 
 #undef DRAW_SCROLL2
+#endif
 
 #define DRAW_SCROLL2													\
 	attr  = cps_scroll2[offs + 1];										\
@@ -1188,6 +1221,19 @@ static void cps1_check_scroll2_distort(int distort)
 	Render
 ------------------------------------------------------*/
 
+#if USE_TILEMAP_SURFACE
+#define DRAW_SCROLL3													\
+	if (!pen_usage[code]) code = SOFT_TILEMAP_BLANK;					\
+	attr = cps_scroll3[offs + 1];										\
+	blit_draw_scroll3_surface(logical_col + x, logical_row + y, code, attr);
+
+static void cps1_render_scroll3_normal(void)
+{
+	SCAN_SCROLL3()
+
+	blit_finish_scroll3_surface(cps_scroll3x, cps_scroll3y);
+}
+#else
 #define DRAW_SCROLL3													\
 	if (pen_usage[code])												\
 	{																	\
@@ -1199,6 +1245,7 @@ static void cps1_render_scroll3_normal(void)
 {
 	SCAN_SCROLL3()
 }
+#endif
 
 #undef DRAW_SCROLL3
 
@@ -199,6 +199,7 @@ static void cps2_run(void)
 			
 			apply_cheat();//davex
 			timer_update_cpu();
+			sound_queue_frame();
 			update_screen();
 			update_inputport();
 		}
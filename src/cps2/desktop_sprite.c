@@ -0,0 +1,811 @@
+/******************************************************************************
+
+	sprite.c
+
+	CPS2 Sprite Manager - Desktop (SDL) Platform
+
+******************************************************************************/
+
+#include "cps2.h"
+#include "sprite_common.h"
+
+
+/******************************************************************************
+	Prototypes
+******************************************************************************/
+
+void (*blit_finish_object)(int start_pri, int end_pri);
+static void blit_render_object(int start_pri, int end_pri);
+static void blit_render_object_zb(int start_pri, int end_pri);
+
+void (*blit_draw_scroll2)(int16_t x, int16_t y, uint32_t code, uint16_t attr);
+static void blit_draw_scroll2_software(int16_t x, int16_t y, uint32_t code, uint16_t attr);
+static void blit_draw_scroll2_hardware(int16_t x, int16_t y, uint32_t code, uint16_t attr);
+
+
+/******************************************************************************
+	Local variables/structures
+******************************************************************************/
+
+typedef struct object_t OBJECT;
+
+struct object_t
+{
+	uint32_t clut;
+	struct Vertex vertices[2];
+	OBJECT *next;
+};
+
+static RECT cps_src_clip = { 64, 16, 64 + 384, 16 + 224 };
+
+static RECT cps_clip[6] =
+{
+	{  0,  0,  0 + 640,  0 + 480 },	// option_stretch = 0  (640x480 window)
+	{ 60,  1, 60 + 360,  1 + 270 },	// option_stretch = 1  (360x270  4:3)
+	{ 48,  1, 48 + 384,  1 + 270 },	// option_stretch = 2  (384x270 24:17)
+	{ 7,   0,   7+ 466,      272 },	// option_stretch = 3  (466x272 12:7)
+	{ 0,   1, 480,       1 + 270 },	// option_stretch = 4  (480x270 16:9)
+	{ 138, 0, 138 + 204,     272 }	    // option_stretch = 5  (204x272 3:4 vertical)
+};
+
+static int16_t clip_min_y;
+static int16_t clip_max_y;
+
+static int16_t object_min_y;
+
+static RECT layer_clip;
+static RECT scroll2_clip;
+
+#if USE_TILEMAP_SURFACE
+static uint16_t scroll1_pixels[512 * 512];
+static uint16_t scroll2_pixels[1024 * 1024];
+static uint16_t scroll3_pixels[2048 * 2048];
+static uint32_t scroll_tiles[3][64 * 64];
+
+static SOFT_TILEMAP scroll1_map = { scroll1_pixels, scroll_tiles[0], 3 };
+static SOFT_TILEMAP scroll2_map = { scroll2_pixels, scroll_tiles[1], 4 };
+static SOFT_TILEMAP scroll3_map = { scroll3_pixels, scroll_tiles[2], 5 };
+#endif
+
+
+/*------------------------------------------------------------------------
+	Vertex data
+------------------------------------------------------------------------*/
+
+static OBJECT *vertices_object_head[8];
+static OBJECT *vertices_object_tail[8];
+static OBJECT ALIGN_DATA vertices_object[OBJECT_MAX_SPRITES];
+
+static uint16_t object_num[8];
+static uint16_t object_index;
+
+static struct Vertex ALIGN_DATA vertices_scroll[2][SCROLL1_MAX_SPRITES * 2];
+static struct Vertex ALIGN_DATA vertices_batch[OBJECT_MAX_SPRITES * 2];
+
+
+/*------------------------------------------------------------------------
+	Depth buffer for object priority masking
+------------------------------------------------------------------------*/
+
+static uint16_t ALIGN_DATA zbuffer[BUF_WIDTH * SCR_HEIGHT];
+static const RECT zbuffer_clip = { 64, 16, 64 + 384, 16 + 224 };
+
+
+/******************************************************************************
+	Sprite drawing interface functions
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Clear all sprites immediately
+------------------------------------------------------------------------*/
+
+void blit_clear_all_sprite(void)
+{
+	tile_cache_clear(&object_cache);
+	tile_cache_clear(&scroll1_cache);
+	tile_cache_clear(&scroll2_cache);
+	tile_cache_clear(&scroll3_cache);
+
+#if USE_TILEMAP_SURFACE
+	soft_tilemap_invalidate(&scroll1_map);
+	soft_tilemap_invalidate(&scroll2_map);
+	soft_tilemap_invalidate(&scroll3_map);
+#endif
+}
+
+
+/*------------------------------------------------------------------------
+	Sprite processing reset
+------------------------------------------------------------------------*/
+
+void blit_reset(void)
+{
+	scrbitmap   = (uint16_t *)video_driver->workFrame(video_data, SCRBITMAP);
+	tex_object  = video_driver->workFrame(video_data, TEX_SPR0);
+	tex_scroll1 = video_driver->workFrame(video_data, TEX_SPR1);
+	tex_scroll2 = video_driver->workFrame(video_data, TEX_SPR2);
+	tex_scroll3 = video_driver->workFrame(video_data, TEX_FIX);
+
+	clip_min_y = FIRST_VISIBLE_LINE;
+	clip_max_y = LAST_VISIBLE_LINE;
+
+	pen_usage = gfx_pen_usage[TILE16];
+	clut = video_palette;
+
+	video_driver->setClutBaseAddr(video_data, video_palette);
+
+	blit_finish_object = blit_render_object;
+
+	blit_clear_all_sprite();
+}
+
+
+/*------------------------------------------------------------------------
+	Start screen update
+------------------------------------------------------------------------*/
+
+void blit_start(int start, int end)
+{
+	int i;
+
+	clip_min_y = start;
+	clip_max_y = end + 1;
+
+	layer_clip.left   = 64;
+	layer_clip.top    = clip_min_y;
+	layer_clip.right  = 448;
+	layer_clip.bottom = clip_max_y;
+
+	object_min_y = start - 16;
+
+	clut0_num = 0;
+	clut1_num = 0;
+
+	object_index = 0;
+	for (i = 0; i < 8; i++)
+	{
+		object_num[i] = 0;
+		vertices_object_head[i] = NULL;
+	}
+
+	if (start == FIRST_VISIBLE_LINE)
+	{
+		if (cps2_has_mask)
+		{
+			blit_finish_object = blit_render_object_zb;
+			soft_blit_fill(zbuffer, &zbuffer_clip, 0);
+		}
+		else
+			blit_finish_object = blit_render_object;
+
+		video_driver->startWorkFrame(video_data, 0);
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	End screen update
+------------------------------------------------------------------------*/
+
+void blit_finish(void)
+{
+	// screen rotation is not supported here, the frame is shown unrotated
+	if (cps_flip_screen)
+		soft_blit_flip(scrbitmap, &cps_src_clip);
+
+	video_driver->transferWorkFrame(video_data, &cps_src_clip, &cps_clip[option_stretch]);
+}
+
+
+/*------------------------------------------------------------------------
+	Update OBJECT texture and cache
+------------------------------------------------------------------------*/
+
+void blit_update_object(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	if ((x > 48 && x < 448) && (y > object_min_y && y < clip_max_y))
+		object_mark_sprite(MAKE_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Add OBJECT to draw list
+------------------------------------------------------------------------*/
+
+void blit_draw_object(int16_t x, int16_t y, uint16_t z, int16_t pri, uint32_t code, uint16_t attr)
+{
+	if ((x > 48 && x < 448) && (y > object_min_y && y < clip_max_y))
+	{
+		int16_t idx;
+		OBJECT *object;
+		struct Vertex *vertices;
+		uint32_t key = MAKE_KEY(code, attr);
+
+		if ((idx = object_get_sprite(key)) < 0)
+		{
+			uint32_t col;
+			uint8_t *src, *dst;
+
+			if (tile_cache_full(&object_cache))
+			{
+				cps2_scan_object_callback();
+				object_delete_sprite();
+			}
+
+			idx = object_insert_sprite(key);
+			dst = NONE_SWIZZLED_16x16(tex_object, idx);
+#if USE_CACHE
+			src = &memory_region_gfx1[(*read_cache)(code << 7)];
+#else
+			src = &memory_region_gfx1[code << 7];
+#endif
+			col = color_table[attr & 0x0f];
+
+			tile_decode_16(dst, BUF_WIDTH, src, col, 16);
+		}
+
+		object = &vertices_object[object_index++];
+		object->clut = attr & 0x10;
+		object->next = NULL;
+
+		if (!vertices_object_head[pri])
+			vertices_object_head[pri] = object;
+		else
+			vertices_object_tail[pri]->next = object;
+
+		vertices_object_tail[pri] = object;
+
+		vertices = object->vertices;
+
+		vertices[0].x = vertices[1].x = x;
+		vertices[0].y = vertices[1].y = y;
+		vertices[0].z = vertices[1].z = z;
+		vertices[0].u = vertices[1].u = (idx & 0x001f) << 4;
+		vertices[0].v = vertices[1].v = (idx & 0x03e0) >> 1;
+
+		attr ^= 0x60;
+		vertices[(attr & 0x20) >> 5].u += 16;
+		vertices[(attr & 0x40) >> 6].v += 16;
+
+		vertices[1].x += 16;
+		vertices[1].y += 16;
+
+		object_num[pri] += 2;
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw OBJECT lists, batched by CLUT
+	(zb: 0 = no depth test, 1 = depth test, 2 = depth buffer only)
+------------------------------------------------------------------------*/
+
+static void blit_render_object_batch(const uint16_t *pal, int total_sprites, int zb)
+{
+	switch (zb)
+	{
+	case 0: soft_blit_clut8(scrbitmap, &layer_clip, tex_object, pal, vertices_batch, total_sprites); break;
+	case 1: soft_blit_clut8_zb(scrbitmap, zbuffer, &layer_clip, tex_object, pal, vertices_batch, total_sprites); break;
+	case 2: soft_blit_depth8(zbuffer, &layer_clip, tex_object, pal, vertices_batch, total_sprites); break;
+	}
+}
+
+
+static void blit_render_object_list(int start_pri, int end_pri, int zb)
+{
+	int i, total_sprites = 0;
+	uint8_t color = 0;
+	struct Vertex *vertices = vertices_batch;
+	OBJECT *object;
+
+	for (i = start_pri; i <= end_pri; i++)
+	{
+		object = vertices_object_head[i];
+
+		while (object)
+		{
+			if (color != object->clut)
+			{
+				if (total_sprites)
+				{
+					blit_render_object_batch(&clut[color << 4], total_sprites, zb);
+					total_sprites = 0;
+					vertices = vertices_batch;
+				}
+
+				color = object->clut;
+			}
+
+			vertices[0] = object->vertices[0];
+			vertices[1] = object->vertices[1];
+
+			total_sprites += 2;
+			vertices += 2;
+			object = object->next;
+		}
+	}
+
+	if (total_sprites)
+		blit_render_object_batch(&clut[color << 4], total_sprites, zb);
+}
+
+
+/*------------------------------------------------------------------------
+	Draw OBJECT
+------------------------------------------------------------------------*/
+
+static void blit_render_object(int start_pri, int end_pri)
+{
+	blit_render_object_list(start_pri, end_pri, 0);
+}
+
+
+/*------------------------------------------------------------------------
+	Draw OBJECT (Z-buffer)
+
+	Priority 0 objects only mark the depth buffer, so they mask the
+	objects below. The GPU draws and erases them again; here they go to
+	the depth buffer only, as nothing else is drawn in the band yet.
+------------------------------------------------------------------------*/
+
+static void blit_render_object_zb(int start_pri, int end_pri)
+{
+	if (start_pri == 0 && object_num[0] != 0)
+	{
+		blit_render_object_list(0, 0, 2);
+		start_pri = 1;
+	}
+
+	blit_render_object_list(start_pri, end_pri, 1);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL1 texture
+------------------------------------------------------------------------*/
+
+void blit_update_scroll1(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	scroll1_mark_sprite(MAKE_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Add SCROLL1 to draw list
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll1(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_KEY(code, attr);
+
+	if ((idx = scroll1_get_sprite(key)) < 0)
+	{
+		uint32_t col, tile;
+		uint8_t *src, *dst, lines = 8;
+
+		if (tile_cache_full(&scroll1_cache))
+		{
+			cps2_scan_scroll1_callback();
+			scroll1_delete_sprite();
+		}
+
+		idx = scroll1_insert_sprite(key);
+		dst = NONE_SWIZZLED_8x8(tex_scroll1, idx);
+#if USE_CACHE
+		src = &memory_region_gfx1[(*read_cache)(code << 6)];
+#else
+		src = &memory_region_gfx1[code << 6];
+#endif
+		col = color_table[attr & 0x0f];
+
+		while (lines--)
+		{
+			tile = *(uint32_t *)(src + 4);
+			*(uint32_t *)(dst + 0) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst + 4) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			src += 8;
+			dst += BUF_WIDTH;
+		}
+	}
+
+	if (attr & 0x10)
+	{
+		vertices = &vertices_scroll[1][clut1_num];
+		clut1_num += 2;
+	}
+	else
+	{
+		vertices = &vertices_scroll[0][clut0_num];
+		clut0_num += 2;
+	}
+
+	vertices[0].x = vertices[1].x = x;
+	vertices[0].y = vertices[1].y = y;
+	vertices[0].u = vertices[1].u = (idx & 0x003f) << 3;
+	vertices[0].v = vertices[1].v = (idx & 0x0fc0) >> 3;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 8;
+	vertices[(attr & 0x40) >> 6].v += 8;
+
+	vertices[1].x += 8;
+	vertices[1].y += 8;
+}
+
+
+/*------------------------------------------------------------------------
+	Draw scroll layer lists (palette blocks clut0/clut1)
+------------------------------------------------------------------------*/
+
+static void blit_finish_scroll(const RECT *clip, uint8_t *tex, int clut0, int clut1)
+{
+	if (clut0_num)
+	{
+		soft_blit_clut8(scrbitmap, clip, tex, &clut[clut0 << 4], vertices_scroll[0], clut0_num);
+		clut0_num = 0;
+	}
+	if (clut1_num)
+	{
+		soft_blit_clut8(scrbitmap, clip, tex, &clut[clut1 << 4], vertices_scroll[1], clut1_num);
+		clut1_num = 0;
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	End SCROLL1 drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll1(void)
+{
+	blit_finish_scroll(&layer_clip, tex_scroll1, 32, 48);
+}
+
+
+/*------------------------------------------------------------------------
+	Set SCROLL2 clip range
+------------------------------------------------------------------------*/
+
+void blit_set_clip_scroll2(int16_t min_y, int16_t max_y)
+{
+	scroll2_min_y = min_y;
+	scroll2_max_y = max_y + 1;
+
+	scroll2_clip.left   = 64;
+	scroll2_clip.top    = scroll2_min_y;
+	scroll2_clip.right  = 448;
+	scroll2_clip.bottom = scroll2_max_y;
+
+	if (scroll2_max_y - scroll2_min_y >= 16)
+		blit_draw_scroll2 = blit_draw_scroll2_hardware;
+	else
+		blit_draw_scroll2 = blit_draw_scroll2_software;
+}
+
+
+/*------------------------------------------------------------------------
+	Check SCROLL2 drawing range
+------------------------------------------------------------------------*/
+
+int blit_check_clip_scroll2(int16_t sy)
+{
+	scroll2_sy = sy;
+	scroll2_ey = sy + 16;
+
+	if (scroll2_min_y > scroll2_sy) scroll2_sy = scroll2_min_y;
+	if (scroll2_max_y < scroll2_ey) scroll2_ey = scroll2_max_y;
+
+	return (scroll2_sy < scroll2_ey);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL2 texture
+------------------------------------------------------------------------*/
+
+void blit_update_scroll2(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	if (y > clip_min_y - 16 && y < clip_max_y)
+		scroll2_mark_sprite(MAKE_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL2 (line scroll) directly into the frame
+------------------------------------------------------------------------*/
+
+static void blit_draw_scroll2_software(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	uint32_t src, dst;
+	uint8_t func;
+
+#if USE_CACHE
+	src = (*read_cache)(code << 7);
+#else
+	src = code << 7;
+#endif
+
+	if (attr & 0x40)
+	{
+		src += ((y + 16) - scroll2_ey) << 3;
+		dst = ((scroll2_ey - 1) << 9) + x;
+	}
+	else
+	{
+		src += (scroll2_sy - y) << 3;
+		dst = (scroll2_sy << 9) + x;
+	}
+
+	func = (pen_usage[code] & 1) | ((attr & 0x60) >> 4);
+
+	(*drawgfx16[func])((uint32_t *)&memory_region_gfx1[src],
+					&scrbitmap[dst],
+					&video_palette[((attr & 0x1f) + 64) << 4],
+					scroll2_ey - scroll2_sy);
+}
+
+
+/*------------------------------------------------------------------------
+	Add SCROLL2 to draw list
+------------------------------------------------------------------------*/
+
+static void blit_draw_scroll2_hardware(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_KEY(code, attr);
+
+	if ((idx = scroll2_get_sprite(key)) < 0)
+	{
+		uint32_t col;
+		uint8_t *src, *dst;
+
+		if (tile_cache_full(&scroll2_cache))
+		{
+			cps2_scan_scroll2_callback();
+			scroll2_delete_sprite();
+		}
+
+		idx = scroll2_insert_sprite(key);
+		dst = NONE_SWIZZLED_16x16(tex_scroll2, idx);
+#if USE_CACHE
+		src = &memory_region_gfx1[(*read_cache)(code << 7)];
+#else
+		src = &memory_region_gfx1[code << 7];
+#endif
+		col = color_table[attr & 0x0f];
+
+		tile_decode_16(dst, BUF_WIDTH, src, col, 16);
+	}
+
+	if (attr & 0x10)
+	{
+		vertices = &vertices_scroll[1][clut1_num];
+		clut1_num += 2;
+	}
+	else
+	{
+		vertices = &vertices_scroll[0][clut0_num];
+		clut0_num += 2;
+	}
+
+	vertices[0].x = vertices[1].x = x;
+	vertices[0].y = vertices[1].y = y;
+	vertices[0].u = vertices[1].u = (idx & 0x001f) << 4;
+	vertices[0].v = vertices[1].v = (idx & 0x03e0) >> 1;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 16;
+	vertices[(attr & 0x40) >> 6].v += 16;
+
+	vertices[1].x += 16;
+	vertices[1].y += 16;
+}
+
+
+/*------------------------------------------------------------------------
+	End SCROLL2 drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll2(void)
+{
+	blit_finish_scroll(&scroll2_clip, tex_scroll2, 64, 80);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL3 texture
+------------------------------------------------------------------------*/
+
+void blit_update_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	scroll3_mark_sprite(MAKE_KEY(code, attr));
+}
+
+
+/*------------------------------------------------------------------------
+	Add SCROLL3 to draw list
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr)
+{
+	int16_t idx;
+	struct Vertex *vertices;
+	uint32_t key = MAKE_KEY(code, attr);
+
+	if ((idx = scroll3_get_sprite(key)) < 0)
+	{
+		uint32_t col, tile;
+		uint8_t *src, *dst, lines = 32;
+
+		if (tile_cache_full(&scroll3_cache))
+		{
+			cps2_scan_scroll3_callback();
+			scroll3_delete_sprite();
+		}
+
+		idx = scroll3_insert_sprite(key);
+		dst = NONE_SWIZZLED_32x32(tex_scroll3, idx);
+#if USE_CACHE
+		src = &memory_region_gfx1[(*read_cache)(code << 9)];
+#else
+		src = &memory_region_gfx1[code << 9];
+#endif
+		col = color_table[attr & 0x0f];
+
+		while (lines--)
+		{
+			tile = *(uint32_t *)(src + 0);
+			*(uint32_t *)(dst +  0) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst +  4) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			tile = *(uint32_t *)(src + 4);
+			*(uint32_t *)(dst +  8) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst + 12) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			tile = *(uint32_t *)(src + 8);
+			*(uint32_t *)(dst + 16) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst + 20) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			tile = *(uint32_t *)(src + 12);
+			*(uint32_t *)(dst + 24) = ((tile >> 0) & 0x0f0f0f0f) | col;
+			*(uint32_t *)(dst + 28) = ((tile >> 4) & 0x0f0f0f0f) | col;
+			src += 16;
+			dst += BUF_WIDTH;
+		}
+	}
+
+	if (attr & 0x10)
+	{
+		vertices = &vertices_scroll[1][clut1_num];
+		clut1_num += 2;
+	}
+	else
+	{
+		vertices = &vertices_scroll[0][clut0_num];
+		clut0_num += 2;
+	}
+
+	vertices[0].x = vertices[1].x = x;
+	vertices[0].y = vertices[1].y = y;
+	vertices[0].u = vertices[1].u = (idx & 0x000f) << 5;
+	vertices[0].v = vertices[1].v = (idx & 0x00f0) << 1;
+
+	attr ^= 0x60;
+	vertices[(attr & 0x20) >> 5].u += 32;
+	vertices[(attr & 0x40) >> 6].v += 32;
+
+	vertices[1].x += 32;
+	vertices[1].y += 32;
+}
+
+
+/*------------------------------------------------------------------------
+	End SCROLL3 drawing
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll3(void)
+{
+	blit_finish_scroll(&layer_clip, tex_scroll3, 96, 112);
+}
+
+
+#if USE_TILEMAP_SURFACE
+/*------------------------------------------------------------------------
+	Update SCROLL1 surface tile
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll1_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr)
+{
+	if (soft_tilemap_check(&scroll1_map, col, row, code, attr))
+	{
+		uint8_t *src = NULL;
+
+		if (code != SOFT_TILEMAP_BLANK)
+		{
+#if USE_CACHE
+			src = &memory_region_gfx1[(*read_cache)(code << 6)];
+#else
+			src = &memory_region_gfx1[code << 6];
+#endif
+			src += 4;
+		}
+		soft_tilemap_decode(&scroll1_map, col, row, src, 8, attr, (attr & 0x1f) + 32);
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL1 surface
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll1_surface(int16_t scrollx, int16_t scrolly)
+{
+	soft_tilemap_draw(scrbitmap, &layer_clip, &scroll1_map, clut, scrollx, scrolly);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL2 surface tile
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll2_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr)
+{
+	if (soft_tilemap_check(&scroll2_map, col, row, code, attr))
+	{
+		uint8_t *src = NULL;
+
+		if (code != SOFT_TILEMAP_BLANK)
+		{
+#if USE_CACHE
+			src = &memory_region_gfx1[(*read_cache)(code << 7)];
+#else
+			src = &memory_region_gfx1[code << 7];
+#endif
+		}
+		soft_tilemap_decode(&scroll2_map, col, row, src, 8, attr, (attr & 0x1f) + 64);
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL2 surface (lines of the current line scroll block)
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll2_surface(int16_t scrollx, int16_t scrolly)
+{
+	soft_tilemap_draw(scrbitmap, &scroll2_clip, &scroll2_map, clut, scrollx, scrolly);
+}
+
+
+/*------------------------------------------------------------------------
+	Update SCROLL3 surface tile
+------------------------------------------------------------------------*/
+
+void blit_draw_scroll3_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr)
+{
+	if (soft_tilemap_check(&scroll3_map, col, row, code, attr))
+	{
+		uint8_t *src = NULL;
+
+		if (code != SOFT_TILEMAP_BLANK)
+		{
+#if USE_CACHE
+			src = &memory_region_gfx1[(*read_cache)(code << 9)];
+#else
+			src = &memory_region_gfx1[code << 9];
+#endif
+		}
+		soft_tilemap_decode(&scroll3_map, col, row, src, 16, attr, (attr & 0x1f) + 96);
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Draw SCROLL3 surface
+------------------------------------------------------------------------*/
+
+void blit_finish_scroll3_surface(int16_t scrollx, int16_t scrolly)
+{
+	soft_tilemap_draw(scrbitmap, &layer_clip, &scroll3_map, clut, scrollx, scrolly);
+}
+#endif
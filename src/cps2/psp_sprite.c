@@ -7,6 +7,7 @@
 ******************************************************************************/
 
 #include "cps2.h"
+#include "sprite_common.h"
 
 
 /******************************************************************************
@@ -14,7 +15,6 @@
 ******************************************************************************/
 
 
-#define MAKE_KEY(code, attr)	(code | ((attr & 0x0f) << 28))
 #define PSP_UNCACHE_PTR(p)		(((uint32_t)(p)) | 0x40000000)
 
 
@@ -35,17 +35,8 @@ static void blit_draw_scroll2_hardware(int16_t x, int16_t y, uint32_t code, uint
 	[Jϐ/\
 ******************************************************************************/
 
-typedef struct sprite_t SPRITE;
 typedef struct object_t OBJECT;
 
-struct sprite_t
-{
-	uint32_t key;
-	uint32_t used;
-	int32_t index;
-	SPRITE *next;
-};
-
 struct object_t
 {
 	uint32_t clut;
@@ -69,81 +60,6 @@ static int16_t clip_min_y;
 static int16_t clip_max_y;
 
 static int16_t object_min_y;
-static int16_t scroll2_min_y;
-static int16_t scroll2_max_y;
-static int16_t scroll2_sy;
-static int16_t scroll2_ey;
-
-static uint8_t *pen_usage;
-static uint16_t *scrbitmap;
-
-
-/*------------------------------------------------------------------------
-	OBJECT: LN^
-------------------------------------------------------------------------*/
-
-#define OBJECT_HASH_SIZE		0x200
-#define OBJECT_HASH_MASK		0x1ff
-#define OBJECT_TEXTURE_SIZE		((BUF_WIDTH/16)*(TEXTURE_HEIGHT/16))
-#define OBJECT_MAX_SPRITES		0x1400
-
-static SPRITE ALIGN_DATA *object_head[OBJECT_HASH_SIZE];
-static SPRITE ALIGN_DATA object_data[OBJECT_TEXTURE_SIZE];
-static SPRITE ALIGN_DATA *object_free_head;
-
-static uint8_t *tex_object;
-static uint16_t object_texture_num;
-
-
-/*------------------------------------------------------------------------
-	SCROLL1: XN[1(eLXg)
-------------------------------------------------------------------------*/
-
-#define SCROLL1_HASH_SIZE		0x200
-#define SCROLL1_HASH_MASK		0x1ff
-#define SCROLL1_TEXTURE_SIZE	((BUF_WIDTH/8)*(TEXTURE_HEIGHT/8))
-#define SCROLL1_MAX_SPRITES		((384/8 + 2) * (224/8 + 2))
-
-static SPRITE ALIGN_DATA *scroll1_head[SCROLL1_HASH_SIZE];
-static SPRITE ALIGN_DATA scroll1_data[SCROLL1_TEXTURE_SIZE];
-static SPRITE ALIGN_DATA *scroll1_free_head;
-
-static uint8_t *tex_scroll1;
-static uint16_t scroll1_texture_num;
-
-
-/*------------------------------------------------------------------------
-	SCROLL2: XN[2
-------------------------------------------------------------------------*/
-
-#define SCROLL2_HASH_SIZE		0x100
-#define SCROLL2_HASH_MASK		0xff
-#define SCROLL2_TEXTURE_SIZE	((BUF_WIDTH/16)*(TEXTURE_HEIGHT/16))
-#define SCROLL2_MAX_SPRITES		((384/16 + 2) * (224/16 + 2))
-
-static SPRITE ALIGN_DATA *scroll2_head[SCROLL2_HASH_SIZE];
-static SPRITE ALIGN_DATA scroll2_data[SCROLL2_TEXTURE_SIZE];
-static SPRITE ALIGN_DATA *scroll2_free_head;
-
-static uint8_t *tex_scroll2;
-static uint16_t scroll2_texture_num;
-
-
-/*------------------------------------------------------------------------
-	SCROLL3: XN[3
-------------------------------------------------------------------------*/
-
-#define SCROLL3_HASH_SIZE		0x40
-#define SCROLL3_HASH_MASK		0x3f
-#define SCROLL3_TEXTURE_SIZE	((BUF_WIDTH/32)*(TEXTURE_HEIGHT/32))
-#define SCROLL3_MAX_SPRITES		((384/32 + 2) * (224/32 + 2))
-
-static SPRITE ALIGN_DATA *scroll3_head[SCROLL3_HASH_SIZE];
-static SPRITE ALIGN_DATA scroll3_data[SCROLL3_TEXTURE_SIZE];
-static SPRITE ALIGN_DATA *scroll3_free_head;
-
-static uint8_t *tex_scroll3;
-static uint16_t scroll3_texture_num;
 
 
 /*------------------------------------------------------------------------
@@ -160,23 +76,6 @@ static uint16_t object_index;
 static struct Vertex ALIGN_DATA vertices_scroll[2][SCROLL1_MAX_SPRITES * 2];
 
 
-/*------------------------------------------------------------------------
-	J[bNAbve[u
-------------------------------------------------------------------------*/
-
-static uint16_t *clut;
-static uint16_t clut0_num;
-static uint16_t clut1_num;
-
-static const uint32_t ALIGN_DATA color_table[16] =
-{
-	0x00000000, 0x10101010, 0x20202020, 0x30303030,
-	0x40404040, 0x50505050, 0x60606060, 0x70707070,
-	0x80808080, 0x90909090, 0xa0a0a0a0, 0xb0b0b0b0,
-	0xc0c0c0c0, 0xd0d0d0d0, 0xe0e0e0e0, 0xf0f0f0f0
-};
-
-
 /*------------------------------------------------------------------------
 	'swizzle'eNX`AhXvZe[u (8bitJ[)
 ------------------------------------------------------------------------*/
@@ -190,755 +89,6 @@ static const int ALIGN_DATA swizzle_table_8bit[32] =
 };
 
 
-/******************************************************************************
-	SCROLL2 \tgEFA`
-******************************************************************************/
-
-static void drawgfx16_16x16(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
-static void drawgfx16_16x16_flipx(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
-static void drawgfx16_16x16_flipy(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
-static void drawgfx16_16x16_flipxy(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
-
-static void drawgfx16_16x16_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
-static void drawgfx16_16x16_flipx_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
-static void drawgfx16_16x16_flipy_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
-static void drawgfx16_16x16_flipxy_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
-
-static void ALIGN_DATA (*drawgfx16[8])(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines) =
-{
-	drawgfx16_16x16,
-	drawgfx16_16x16_opaque,
-	drawgfx16_16x16_flipx,
-	drawgfx16_16x16_flipx_opaque,
-	drawgfx16_16x16_flipy,
-	drawgfx16_16x16_flipy_opaque,
-	drawgfx16_16x16_flipxy,
-	drawgfx16_16x16_flipxy_opaque
-};
-
-
-/*------------------------------------------------------------------------
-	16bpp 16x16
-------------------------------------------------------------------------*/
-
-static void drawgfx16_16x16(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
-{
-	uint32_t tile, mask;
-
-	while (lines--)
-	{
-		tile = src[0];
-		mask = ~tile;
-		if (mask)
-		{
-			if (mask & 0x000f) dst[ 0] = pal[(tile >>  0) & 0x0f];
-			if (mask & 0x00f0) dst[ 4] = pal[(tile >>  4) & 0x0f];
-			if (mask & 0x0f00) dst[ 1] = pal[(tile >>  8) & 0x0f];
-			if (mask & 0xf000) dst[ 5] = pal[(tile >> 12) & 0x0f];
-			mask >>= 16;
-			if (mask & 0x000f) dst[ 2] = pal[(tile >> 16) & 0x0f];
-			if (mask & 0x00f0) dst[ 6] = pal[(tile >> 20) & 0x0f];
-			if (mask & 0x0f00) dst[ 3] = pal[(tile >> 24) & 0x0f];
-			if (mask & 0xf000) dst[ 7] = pal[(tile >> 28) & 0x0f];
-		}
-		tile = src[1];
-		mask = ~tile;
-		if (mask)
-		{
-			if (mask & 0x000f) dst[ 8] = pal[(tile >>  0) & 0x0f];
-			if (mask & 0x00f0) dst[12] = pal[(tile >>  4) & 0x0f];
-			if (mask & 0x0f00) dst[ 9] = pal[(tile >>  8) & 0x0f];
-			if (mask & 0xf000) dst[13] = pal[(tile >> 12) & 0x0f];
-			mask >>= 16;
-			if (mask & 0x000f) dst[10] = pal[(tile >> 16) & 0x0f];
-			if (mask & 0x00f0) dst[14] = pal[(tile >> 20) & 0x0f];
-			if (mask & 0x0f00) dst[11] = pal[(tile >> 24) & 0x0f];
-			if (mask & 0xf000) dst[15] = pal[(tile >> 28) & 0x0f];
-		}
-		src += 2;
-		dst += BUF_WIDTH;
-	}
-}
-
-static void drawgfx16_16x16_flipx(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
-{
-	uint32_t tile, mask;
-
-	while (lines--)
-	{
-		tile = src[0];
-		mask = ~tile;
-		if (mask)
-		{
-			if (mask & 0x000f) dst[15] = pal[(tile >>  0) & 0x0f];
-			if (mask & 0x00f0) dst[11] = pal[(tile >>  4) & 0x0f];
-			if (mask & 0x0f00) dst[14] = pal[(tile >>  8) & 0x0f];
-			if (mask & 0xf000) dst[10] = pal[(tile >> 12) & 0x0f];
-			mask >>= 16;
-			if (mask & 0x000f) dst[13] = pal[(tile >> 16) & 0x0f];
-			if (mask & 0x00f0) dst[ 9] = pal[(tile >> 20) & 0x0f];
-			if (mask & 0x0f00) dst[12] = pal[(tile >> 24) & 0x0f];
-			if (mask & 0xf000) dst[ 8] = pal[(tile >> 28) & 0x0f];
-		}
-		tile = src[1];
-		mask = ~tile;
-		if (mask)
-		{
-			if (mask & 0x000f) dst[ 7] = pal[(tile >>  0) & 0x0f];
-			if (mask & 0x00f0) dst[ 3] = pal[(tile >>  4) & 0x0f];
-			if (mask & 0x0f00) dst[ 6] = pal[(tile >>  8) & 0x0f];
-			if (mask & 0xf000) dst[ 2] = pal[(tile >> 12) & 0x0f];
-			mask >>= 16;
-			if (mask & 0x000f) dst[ 5] = pal[(tile >> 16) & 0x0f];
-			if (mask & 0x00f0) dst[ 1] = pal[(tile >> 20) & 0x0f];
-			if (mask & 0x0f00) dst[ 4] = pal[(tile >> 24) & 0x0f];
-			if (mask & 0xf000) dst[ 0] = pal[(tile >> 28) & 0x0f];
-		}
-		src += 2;
-		dst += BUF_WIDTH;
-	}
-}
-
-static void drawgfx16_16x16_flipy(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
-{
-	uint32_t tile, mask;
-
-	while (lines--)
-	{
-		tile = src[0];
-		mask = ~tile;
-		if (mask)
-		{
-			if (mask & 0x000f) dst[ 0] = pal[(tile >>  0) & 0x0f];
-			if (mask & 0x00f0) dst[ 4] = pal[(tile >>  4) & 0x0f];
-			if (mask & 0x0f00) dst[ 1] = pal[(tile >>  8) & 0x0f];
-			if (mask & 0xf000) dst[ 5] = pal[(tile >> 12) & 0x0f];
-			mask >>= 16;
-			if (mask & 0x000f) dst[ 2] = pal[(tile >> 16) & 0x0f];
-			if (mask & 0x00f0) dst[ 6] = pal[(tile >> 20) & 0x0f];
-			if (mask & 0x0f00) dst[ 3] = pal[(tile >> 24) & 0x0f];
-			if (mask & 0xf000) dst[ 7] = pal[(tile >> 28) & 0x0f];
-		}
-		tile = src[1];
-		mask = ~tile;
-		if (mask)
-		{
-			if (mask & 0x000f) dst[ 8] = pal[(tile >>  0) & 0x0f];
-			if (mask & 0x00f0) dst[12] = pal[(tile >>  4) & 0x0f];
-			if (mask & 0x0f00) dst[ 9] = pal[(tile >>  8) & 0x0f];
-			if (mask & 0xf000) dst[13] = pal[(tile >> 12) & 0x0f];
-			mask >>= 16;
-			if (mask & 0x000f) dst[10] = pal[(tile >> 16) & 0x0f];
-			if (mask & 0x00f0) dst[14] = pal[(tile >> 20) & 0x0f];
-			if (mask & 0x0f00) dst[11] = pal[(tile >> 24) & 0x0f];
-			if (mask & 0xf000) dst[15] = pal[(tile >> 28) & 0x0f];
-		}
-		src += 2;
-		dst -= BUF_WIDTH;
-	}
-}
-
-static void drawgfx16_16x16_flipxy(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
-{
-	uint32_t tile, mask;
-
-	while (lines--)
-	{
-		tile = src[0];
-		mask = ~tile;
-		if (mask)
-		{
-			if (mask & 0x000f) dst[15] = pal[(tile >>  0) & 0x0f];
-			if (mask & 0x00f0) dst[11] = pal[(tile >>  4) & 0x0f];
-			if (mask & 0x0f00) dst[14] = pal[(tile >>  8) & 0x0f];
-			if (mask & 0xf000) dst[10] = pal[(tile >> 12) & 0x0f];
-			mask >>= 16;
-			if (mask & 0x000f) dst[13] = pal[(tile >> 16) & 0x0f];
-			if (mask & 0x00f0) dst[ 9] = pal[(tile >> 20) & 0x0f];
-			if (mask & 0x0f00) dst[12] = pal[(tile >> 24) & 0x0f];
-			if (mask & 0xf000) dst[ 8] = pal[(tile >> 28) & 0x0f];
-		}
-		tile = src[1];
-		mask = ~tile;
-		if (mask)
-		{
-			if (mask & 0x000f) dst[ 7] = pal[(tile >>  0) & 0x0f];
-			if (mask & 0x00f0) dst[ 3] = pal[(tile >>  4) & 0x0f];
-			if (mask & 0x0f00) dst[ 6] = pal[(tile >>  8) & 0x0f];
-			if (mask & 0xf000) dst[ 2] = pal[(tile >> 12) & 0x0f];
-			mask >>= 16;
-			if (mask & 0x000f) dst[ 5] = pal[(tile >> 16) & 0x0f];
-			if (mask & 0x00f0) dst[ 1] = pal[(tile >> 20) & 0x0f];
-			if (mask & 0x0f00) dst[ 4] = pal[(tile >> 24) & 0x0f];
-			if (mask & 0xf000) dst[ 0] = pal[(tile >> 28) & 0x0f];
-		}
-		src += 2;
-		dst -= BUF_WIDTH;
-	}
-}
-
-
-/*------------------------------------------------------------------------
-	16bpp 16x16 (߂Ȃ)
-------------------------------------------------------------------------*/
-
-static void drawgfx16_16x16_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
-{
-	uint32_t tile;
-
-	while (lines--)
-	{
-		tile = src[0];
-		dst[ 0] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 7] = pal[tile & 0x0f];
-		tile = src[1];
-		dst[ 8] = pal[tile & 0x0f]; tile >>= 4;
-		dst[12] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
-		dst[13] = pal[tile & 0x0f]; tile >>= 4;
-		dst[10] = pal[tile & 0x0f]; tile >>= 4;
-		dst[14] = pal[tile & 0x0f]; tile >>= 4;
-		dst[11] = pal[tile & 0x0f]; tile >>= 4;
-		dst[15] = pal[tile & 0x0f];
-		src += 2;
-		dst += BUF_WIDTH;
-	}
-}
-
-static void drawgfx16_16x16_flipx_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
-{
-	uint32_t tile;
-
-	while (lines--)
-	{
-		tile = src[0];
-		dst[15] = pal[tile & 0x0f]; tile >>= 4;
-		dst[11] = pal[tile & 0x0f]; tile >>= 4;
-		dst[14] = pal[tile & 0x0f]; tile >>= 4;
-		dst[10] = pal[tile & 0x0f]; tile >>= 4;
-		dst[13] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
-		dst[12] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 8] = pal[tile & 0x0f];
-		tile = src[1];
-		dst[ 7] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 0] = pal[tile & 0x0f];
-		src += 2;
-		dst += BUF_WIDTH;
-	}
-}
-
-static void drawgfx16_16x16_flipy_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
-{
-	uint32_t tile;
-
-	while (lines--)
-	{
-		tile = src[0];
-		dst[ 0] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 7] = pal[tile & 0x0f];
-		tile = src[1];
-		dst[ 8] = pal[tile & 0x0f]; tile >>= 4;
-		dst[12] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
-		dst[13] = pal[tile & 0x0f]; tile >>= 4;
-		dst[10] = pal[tile & 0x0f]; tile >>= 4;
-		dst[14] = pal[tile & 0x0f]; tile >>= 4;
-		dst[11] = pal[tile & 0x0f]; tile >>= 4;
-		dst[15] = pal[tile & 0x0f];
-		src += 2;
-		dst -= BUF_WIDTH;
-	}
-}
-
-static void drawgfx16_16x16_flipxy_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
-{
-	uint32_t tile;
-
-	while (lines--)
-	{
-		tile = src[0];
-		dst[15] = pal[tile & 0x0f]; tile >>= 4;
-		dst[11] = pal[tile & 0x0f]; tile >>= 4;
-		dst[14] = pal[tile & 0x0f]; tile >>= 4;
-		dst[10] = pal[tile & 0x0f]; tile >>= 4;
-		dst[13] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
-		dst[12] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 8] = pal[tile & 0x0f];
-		tile = src[1];
-		dst[ 7] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
-		dst[ 0] = pal[tile & 0x0f];
-		src += 2;
-		dst -= BUF_WIDTH;
-	}
-}
-
-
-/******************************************************************************
-	OBJECTXvCgǗ
-******************************************************************************/
-
-/*------------------------------------------------------------------------
-	OBJECTeNX`XvCgԍ擾
-------------------------------------------------------------------------*/
-
-static int32_t object_get_sprite(uint32_t key)
-{
-	SPRITE *p = object_head[key & OBJECT_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			if (p->used != frames_displayed)
-			{
-#if USE_CACHE
-				if (update_cache) update_cache(key << 7);
-#endif
-				p->used = frames_displayed;
-			}
-			return p->index;
-	 	}
-		p = p->next;
-	}
-	return -1;
-}
-
-
-/*------------------------------------------------------------------------
-	OBJECTeNX`ɃXvCgo^
-------------------------------------------------------------------------*/
-
-static int32_t object_insert_sprite(uint32_t key)
-{
-	uint16_t hash = key & OBJECT_HASH_MASK;
-	SPRITE *p = object_head[hash];
-	SPRITE *q = object_free_head;
-
-	if (!q) return -1;
-
-	object_free_head = object_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
-
-	if (!p)
-	{
-		object_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
-
-	object_texture_num++;
-
-	return q->index;
-}
-
-
-/*------------------------------------------------------------------------
-	OBJECTeNX`莞Ԃo߂XvCg폜
-------------------------------------------------------------------------*/
-
-static void object_delete_sprite(void)
-{
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < OBJECT_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = object_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				object_texture_num--;
-
-				if (!prev_p)
-				{
-					object_head[i] = p->next;
-					p->next = object_free_head;
-					object_free_head = p;
-					p = object_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = object_free_head;
-					object_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
-}
-
-
-/******************************************************************************
-	SCROLL1XvCgǗ
-******************************************************************************/
-
-/*------------------------------------------------------------------------
-	SCROLL1eNX`XvCgԍ擾
-------------------------------------------------------------------------*/
-
-static int32_t scroll1_get_sprite(uint32_t key)
-{
-	SPRITE *p = scroll1_head[key & SCROLL1_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			if (p->used != frames_displayed)
-			{
-#if USE_CACHE
-				if (update_cache) update_cache(key << 6);
-#endif
-				p->used = frames_displayed;
-			}
-			return p->index;
-		}
-		p = p->next;
-	}
-	return -1;
-}
-
-
-/*------------------------------------------------------------------------
-	SCROLL1eNX`ɃXvCgo^
-------------------------------------------------------------------------*/
-
-static int32_t scroll1_insert_sprite(uint32_t key)
-{
-	uint16_t hash = key & SCROLL1_HASH_MASK;
-	SPRITE *p = scroll1_head[hash];
-	SPRITE *q = scroll1_free_head;
-
-	if (!q) return -1;
-
-	scroll1_free_head = scroll1_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
-
-	if (!p)
-	{
-		scroll1_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
-
-	scroll1_texture_num++;
-
-	return q->index;
-}
-
-
-/*------------------------------------------------------------------------
-	SCROLL1eNX`莞Ԃo߂XvCg폜
-------------------------------------------------------------------------*/
-
-static void scroll1_delete_sprite(void)
-{
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < SCROLL1_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = scroll1_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				scroll1_texture_num--;
-
-				if (!prev_p)
-				{
-					scroll1_head[i] = p->next;
-					p->next = scroll1_free_head;
-					scroll1_free_head = p;
-					p = scroll1_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = scroll1_free_head;
-					scroll1_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
-}
-
-
-/******************************************************************************
-	SCROLL2XvCgǗ
-******************************************************************************/
-
-/*------------------------------------------------------------------------
-	SCROLL2eNX`XvCgԍ擾
-------------------------------------------------------------------------*/
-
-static int32_t scroll2_get_sprite(uint32_t key)
-{
-	SPRITE *p = scroll2_head[key & SCROLL2_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			if (p->used != frames_displayed)
-			{
-#if USE_CACHE
-				if (update_cache) update_cache(key << 7);
-#endif
-				p->used = frames_displayed;
-			}
-			return p->index;
-		}
-		p = p->next;
-	}
-	return -1;
-}
-
-
-/*------------------------------------------------------------------------
-	SCROLL2eNX`ɃXvCgo^
-------------------------------------------------------------------------*/
-
-static int32_t scroll2_insert_sprite(uint32_t key)
-{
-	uint16_t hash = key & SCROLL2_HASH_MASK;
-	SPRITE *p = scroll2_head[hash];
-	SPRITE *q = scroll2_free_head;
-
-	if (!q) return -1;
-
-	scroll2_free_head = scroll2_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
-
-	if (!p)
-	{
-		scroll2_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
-
-	scroll2_texture_num++;
-
-	return q->index;
-}
-
-
-/*------------------------------------------------------------------------
-	SCROLL2eNX`莞Ԃo߂XvCg폜
-------------------------------------------------------------------------*/
-
-static void scroll2_delete_sprite(void)
-{
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < SCROLL2_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = scroll2_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				scroll2_texture_num--;
-
-				if (!prev_p)
-				{
-					scroll2_head[i] = p->next;
-					p->next = scroll2_free_head;
-					scroll2_free_head = p;
-					p = scroll2_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = scroll2_free_head;
-					scroll2_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
-}
-
-
-/******************************************************************************
-	SCROLL3XvCgǗ
-******************************************************************************/
-
-/*------------------------------------------------------------------------
-	SCROLL3eNX`XvCgԍ擾
-------------------------------------------------------------------------*/
-
-static int32_t scroll3_get_sprite(uint32_t key)
-{
-	SPRITE *p = scroll3_head[key & SCROLL3_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			if (p->used != frames_displayed)
-			{
-#if USE_CACHE
-				if (update_cache) update_cache(key << 9);
-#endif
-				p->used = frames_displayed;
-			}
-			return p->index;
-		}
-		p = p->next;
-	}
-	return -1;
-}
-
-
-/*------------------------------------------------------------------------
-	SCROLL3eNX`ɃXvCgo^
-------------------------------------------------------------------------*/
-
-static int32_t scroll3_insert_sprite(uint32_t key)
-{
-	uint16_t hash = key & SCROLL3_HASH_MASK;
-	SPRITE *p = scroll3_head[hash];
-	SPRITE *q = scroll3_free_head;
-
-	if (!q) return -1;
-
-	scroll3_free_head = scroll3_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
-
-	if (!p)
-	{
-		scroll3_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
-
-	scroll3_texture_num++;
-
-	return q->index;
-}
-
-
-/*------------------------------------------------------------------------
-	SCROLL3eNX`莞Ԃo߂XvCg폜
-------------------------------------------------------------------------*/
-
-static void scroll3_delete_sprite(void)
-{
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < SCROLL3_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = scroll3_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				scroll3_texture_num--;
-
-				if (!prev_p)
-				{
-					scroll3_head[i] = p->next;
-					p->next = scroll3_free_head;
-					scroll3_free_head = p;
-					p = scroll3_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = scroll3_free_head;
-					scroll3_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
-}
-
-
 /******************************************************************************
 	XvCg`C^tF[X֐
 ******************************************************************************/
@@ -949,41 +99,10 @@ static void scroll3_delete_sprite(void)
 
 void blit_clear_all_sprite(void)
 {
-	int i;
-
-	for (i = 0; i < OBJECT_TEXTURE_SIZE - 1; i++)
-		object_data[i].next = &object_data[i + 1];
-
-	object_data[i].next = NULL;
-	object_free_head = &object_data[0];
-
-	for (i = 0; i < SCROLL1_TEXTURE_SIZE - 1; i++)
-		scroll1_data[i].next = &scroll1_data[i + 1];
-
-	scroll1_data[i].next = NULL;
-	scroll1_free_head = &scroll1_data[0];
-
-	for (i = 0; i < SCROLL2_TEXTURE_SIZE - 1; i++)
-		scroll2_data[i].next = &scroll2_data[i + 1];
-
-	scroll2_data[i].next = NULL;
-	scroll2_free_head = &scroll2_data[0];
-
-	for (i = 0; i < SCROLL3_TEXTURE_SIZE - 1; i++)
-		scroll3_data[i].next = &scroll3_data[i + 1];
-
-	scroll3_data[i].next = NULL;
-	scroll3_free_head = &scroll3_data[0];
-
-	memset(object_head, 0, sizeof(SPRITE *) * OBJECT_HASH_SIZE);
-	memset(scroll1_head, 0, sizeof(SPRITE *) * SCROLL1_HASH_SIZE);
-	memset(scroll2_head, 0, sizeof(SPRITE *) * SCROLL2_HASH_SIZE);
-	memset(scroll3_head, 0, sizeof(SPRITE *) * SCROLL3_HASH_SIZE);
-
-	object_texture_num = 0;
-	scroll1_texture_num = 0;
-	scroll2_texture_num = 0;
-	scroll3_texture_num = 0;
+	tile_cache_clear(&object_cache);
+	tile_cache_clear(&scroll1_cache);
+	tile_cache_clear(&scroll2_cache);
+	tile_cache_clear(&scroll3_cache);
 }
 
 
@@ -993,19 +112,12 @@ void blit_clear_all_sprite(void)
 
 void blit_reset(void)
 {
-	int i;
-
 	scrbitmap  = (uint16_t *)video_driver->workFrame(video_data, SCRBITMAP);
 	tex_object  = video_driver->workFrame(video_data, TEX_SPR0);
 	tex_scroll1 = video_driver->workFrame(video_data, TEX_SPR1);
 	tex_scroll2 = video_driver->workFrame(video_data, TEX_SPR2);
 	tex_scroll3 = video_driver->workFrame(video_data, TEX_FIX);
 
-	for (i = 0; i < OBJECT_TEXTURE_SIZE; i++) object_data[i].index = i;
-	for (i = 0; i < SCROLL1_TEXTURE_SIZE; i++) scroll1_data[i].index = i;
-	for (i = 0; i < SCROLL2_TEXTURE_SIZE; i++) scroll2_data[i].index = i;
-	for (i = 0; i < SCROLL3_TEXTURE_SIZE; i++) scroll3_data[i].index = i;
-
 	clip_min_y = FIRST_VISIBLE_LINE;
 	clip_max_y = LAST_VISIBLE_LINE;
 
@@ -1097,26 +209,7 @@ void blit_finish(void)
 void blit_update_object(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
 	if ((x > 48 && x < 448) && (y > object_min_y && y < clip_max_y))
-	{
-		uint32_t key = MAKE_KEY(code, attr);
-		SPRITE *p = object_head[key & OBJECT_HASH_MASK];
-
-		while (p)
-		{
-			if (p->key == key)
-			{
-				if (p->used != frames_displayed)
-				{
-#if USE_CACHE
-					if (update_cache) update_cache(key << 7);
-#endif
-					p->used = frames_displayed;
-				}
-				return;
-		 	}
-			p = p->next;
-		}
-	}
+		object_mark_sprite(MAKE_KEY(code, attr));
 }
 
 
@@ -1135,10 +228,10 @@ void blit_draw_object(int16_t x, int16_t y, uint16_t z, int16_t pri, uint32_t co
 
 		if ((idx = object_get_sprite(key)) < 0)
 		{
-			uint32_t col, tile;
-			uint8_t *src, *dst, lines = 16;
+			uint32_t col;
+			uint8_t *src, *dst;
 
-			if (object_texture_num == OBJECT_TEXTURE_SIZE - 1)
+			if (tile_cache_full(&object_cache))
 			{
 				cps2_scan_object_callback();
 				object_delete_sprite();
@@ -1153,17 +246,9 @@ void blit_draw_object(int16_t x, int16_t y, uint16_t z, int16_t pri, uint32_t co
 #endif
 			col = color_table[attr & 0x0f];
 
-			while (lines--)
-			{
-				tile = *(uint32_t *)(src + 0);
-				*(uint32_t *)(dst +  0) = ((tile >> 0) & 0x0f0f0f0f) | col;
-				*(uint32_t *)(dst +  4) = ((tile >> 4) & 0x0f0f0f0f) | col;
-				tile = *(uint32_t *)(src + 4);
-				*(uint32_t *)(dst +  8) = ((tile >> 0) & 0x0f0f0f0f) | col;
-				*(uint32_t *)(dst + 12) = ((tile >> 4) & 0x0f0f0f0f) | col;
-				src += 8;
-				dst += swizzle_table_8bit[lines];
-			}
+			// swizzled 16x16: two 16x8 blocks, 4096 bytes apart
+			tile_decode_16(dst, 16, src, col, 8);
+			tile_decode_16(dst + 4096, 16, src + 64, col, 8);
 		}
 
 		object = &vertices_object[object_index++];
@@ -1377,24 +462,7 @@ static void blit_render_object_zb(int start_pri, int end_pri)
 
 void blit_update_scroll1(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
-	uint32_t key = MAKE_KEY(code, attr);
-	SPRITE *p = scroll1_head[key & SCROLL1_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			if (p->used != frames_displayed)
-			{
-#if USE_CACHE
-				if (update_cache) update_cache(key << 6);
-#endif
-				p->used = frames_displayed;
-			}
-			return;
-		}
-		p = p->next;
-	}
+	scroll1_mark_sprite(MAKE_KEY(code, attr));
 }
 
 
@@ -1413,7 +481,7 @@ void blit_draw_scroll1(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 		uint32_t col, tile;
 		uint8_t *src, *dst, lines = 8;
 
-		if (scroll1_texture_num == SCROLL1_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scroll1_cache))
 		{
 			cps2_scan_scroll1_callback();
 			scroll1_delete_sprite();
@@ -1544,26 +612,7 @@ int blit_check_clip_scroll2(int16_t sy)
 void blit_update_scroll2(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
 	if (y > clip_min_y - 16 && y < clip_max_y)
-	{
-		uint32_t key = MAKE_KEY(code, attr);
-		SPRITE *p = scroll2_head[key & SCROLL2_HASH_MASK];
-
-		while (p)
-		{
-			if (p->key == key)
-			{
-				if (p->used != frames_displayed)
-				{
-#if USE_CACHE
-					if (update_cache) update_cache(key << 7);
-#endif
-					p->used = frames_displayed;
-				}
-				return;
-			}
-			p = p->next;
-		}
-	}
+		scroll2_mark_sprite(MAKE_KEY(code, attr));
 }
 
 
@@ -1617,7 +666,7 @@ static void blit_draw_scroll2_hardware(int16_t x, int16_t y, uint32_t code, uint
 		uint32_t col, tile;
 		uint8_t *src, *dst, lines = 16;
 
-		if (scroll2_texture_num == SCROLL2_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scroll2_cache))
 		{
 			cps2_scan_scroll2_callback();
 			scroll2_delete_sprite();
@@ -1718,24 +767,7 @@ void blit_finish_scroll2(void)
 
 void blit_update_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 {
-	uint32_t key = MAKE_KEY(code, attr);
-	SPRITE *p = scroll3_head[key & SCROLL3_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			if (p->used != frames_displayed)
-			{
-#if USE_CACHE
-				if (update_cache) update_cache(key << 9);
-#endif
-				p->used = frames_displayed;
-			}
-			return;
-		}
-		p = p->next;
-	}
+	scroll3_mark_sprite(MAKE_KEY(code, attr));
 }
 
 
@@ -1754,7 +786,7 @@ void blit_draw_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr)
 		uint32_t col, tile;
 		uint8_t *src, *dst, lines = 32;
 
-		if (scroll3_texture_num == SCROLL3_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&scroll3_cache))
 		{
 			cps2_scan_scroll3_callback();
 			scroll3_delete_sprite();
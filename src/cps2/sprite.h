@@ -33,4 +33,13 @@ void blit_update_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr);
 void blit_draw_scroll3(int16_t x, int16_t y, uint32_t code, uint16_t attr);
 void blit_finish_scroll3(void);
 
+#if USE_TILEMAP_SURFACE
+void blit_draw_scroll1_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr);
+void blit_finish_scroll1_surface(int16_t scrollx, int16_t scrolly);
+void blit_draw_scroll2_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr);
+void blit_finish_scroll2_surface(int16_t scrollx, int16_t scrolly);
+void blit_draw_scroll3_surface(int16_t col, int16_t row, uint32_t code, uint16_t attr);
+void blit_finish_scroll3_surface(int16_t scrollx, int16_t scrolly);
+#endif
+
 #endif /* CPS2_SPRITE_H */
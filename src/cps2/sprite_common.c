@@ -0,0 +1,606 @@
+/******************************************************************************
+
+	sprite_common.c
+
+	CPS2 Common sprite management - shared across all platforms
+
+	This file contains platform-agnostic sprite management code:
+	- Texture caching of OBJECT, SCROLL1/2/3 tiles
+	- Software rendering functions for SCROLL2 (used for line scroll effects)
+
+	Graphics data uses the same interleaved format as CPS1: when decoding
+	a 32-bit word, pixels follow the pattern 0,4,1,5,2,6,3,7.
+
+******************************************************************************/
+
+#include "sprite_common.h"
+
+/******************************************************************************
+	Shared variable definitions
+******************************************************************************/
+
+/* OBJECT */
+TILE_CACHE_STORAGE(object, OBJECT_TEXTURE_SIZE, OBJECT_HASH_SIZE);
+TILE_CACHE object_cache = TILE_CACHE_INIT(object, OBJECT_TEXTURE_SIZE, OBJECT_HASH_SIZE);
+uint8_t *tex_object;
+
+/* SCROLL1 */
+TILE_CACHE_STORAGE(scroll1, SCROLL1_TEXTURE_SIZE, SCROLL1_HASH_SIZE);
+TILE_CACHE scroll1_cache = TILE_CACHE_INIT(scroll1, SCROLL1_TEXTURE_SIZE, SCROLL1_HASH_SIZE);
+uint8_t *tex_scroll1;
+
+/* SCROLL2 */
+TILE_CACHE_STORAGE(scroll2, SCROLL2_TEXTURE_SIZE, SCROLL2_HASH_SIZE);
+TILE_CACHE scroll2_cache = TILE_CACHE_INIT(scroll2, SCROLL2_TEXTURE_SIZE, SCROLL2_HASH_SIZE);
+uint8_t *tex_scroll2;
+
+/* SCROLL3 */
+TILE_CACHE_STORAGE(scroll3, SCROLL3_TEXTURE_SIZE, SCROLL3_HASH_SIZE);
+TILE_CACHE scroll3_cache = TILE_CACHE_INIT(scroll3, SCROLL3_TEXTURE_SIZE, SCROLL3_HASH_SIZE);
+uint8_t *tex_scroll3;
+
+/* Scroll2 clipping */
+int16_t scroll2_min_y;
+int16_t scroll2_max_y;
+int16_t scroll2_sy;
+int16_t scroll2_ey;
+
+/* Pen usage */
+uint8_t *pen_usage;
+
+/* Screen bitmap */
+uint16_t *scrbitmap;
+
+/* CLUT */
+uint16_t *clut;
+uint16_t clut0_num;
+uint16_t clut1_num;
+
+/* Color table for palette index encoding
+   Used to encode 4-bit palette indices into 8-bit texture format */
+const uint32_t ALIGN_DATA color_table[16] =
+{
+	0x00000000, 0x10101010, 0x20202020, 0x30303030,
+	0x40404040, 0x50505050, 0x60606060, 0x70707070,
+	0x80808080, 0x90909090, 0xa0a0a0a0, 0xb0b0b0b0,
+	0xc0c0c0c0, 0xd0d0d0d0, 0xe0e0e0e0, 0xf0f0f0f0
+};
+
+/* Function pointer array for software rendering */
+void ALIGN_DATA (*drawgfx16[8])(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines) =
+{
+	drawgfx16_16x16,
+	drawgfx16_16x16_opaque,
+	drawgfx16_16x16_flipx,
+	drawgfx16_16x16_flipx_opaque,
+	drawgfx16_16x16_flipy,
+	drawgfx16_16x16_flipy_opaque,
+	drawgfx16_16x16_flipxy,
+	drawgfx16_16x16_flipxy_opaque
+};
+
+
+/******************************************************************************
+	SCROLL2 Software Rendering
+
+	Used when SCROLL2 clip region is too small for hardware rendering
+	(less than 16 scanlines), i.e. for per-line scrolling.
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	16bpp 16x16 - Transparent pixels (color 0) are skipped
+------------------------------------------------------------------------*/
+
+void drawgfx16_16x16(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
+{
+	uint32_t tile, mask;
+
+	while (lines--)
+	{
+		tile = src[0];
+		mask = ~tile;
+		if (mask)
+		{
+			if (mask & 0x000f) dst[ 0] = pal[(tile >>  0) & 0x0f];
+			if (mask & 0x00f0) dst[ 4] = pal[(tile >>  4) & 0x0f];
+			if (mask & 0x0f00) dst[ 1] = pal[(tile >>  8) & 0x0f];
+			if (mask & 0xf000) dst[ 5] = pal[(tile >> 12) & 0x0f];
+			mask >>= 16;
+			if (mask & 0x000f) dst[ 2] = pal[(tile >> 16) & 0x0f];
+			if (mask & 0x00f0) dst[ 6] = pal[(tile >> 20) & 0x0f];
+			if (mask & 0x0f00) dst[ 3] = pal[(tile >> 24) & 0x0f];
+			if (mask & 0xf000) dst[ 7] = pal[(tile >> 28) & 0x0f];
+		}
+		tile = src[1];
+		mask = ~tile;
+		if (mask)
+		{
+			if (mask & 0x000f) dst[ 8] = pal[(tile >>  0) & 0x0f];
+			if (mask & 0x00f0) dst[12] = pal[(tile >>  4) & 0x0f];
+			if (mask & 0x0f00) dst[ 9] = pal[(tile >>  8) & 0x0f];
+			if (mask & 0xf000) dst[13] = pal[(tile >> 12) & 0x0f];
+			mask >>= 16;
+			if (mask & 0x000f) dst[10] = pal[(tile >> 16) & 0x0f];
+			if (mask & 0x00f0) dst[14] = pal[(tile >> 20) & 0x0f];
+			if (mask & 0x0f00) dst[11] = pal[(tile >> 24) & 0x0f];
+			if (mask & 0xf000) dst[15] = pal[(tile >> 28) & 0x0f];
+		}
+		src += 2;
+		dst += BUF_WIDTH;
+	}
+}
+
+void drawgfx16_16x16_flipx(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
+{
+	uint32_t tile, mask;
+
+	while (lines--)
+	{
+		tile = src[0];
+		mask = ~tile;
+		if (mask)
+		{
+			if (mask & 0x000f) dst[15] = pal[(tile >>  0) & 0x0f];
+			if (mask & 0x00f0) dst[11] = pal[(tile >>  4) & 0x0f];
+			if (mask & 0x0f00) dst[14] = pal[(tile >>  8) & 0x0f];
+			if (mask & 0xf000) dst[10] = pal[(tile >> 12) & 0x0f];
+			mask >>= 16;
+			if (mask & 0x000f) dst[13] = pal[(tile >> 16) & 0x0f];
+			if (mask & 0x00f0) dst[ 9] = pal[(tile >> 20) & 0x0f];
+			if (mask & 0x0f00) dst[12] = pal[(tile >> 24) & 0x0f];
+			if (mask & 0xf000) dst[ 8] = pal[(tile >> 28) & 0x0f];
+		}
+		tile = src[1];
+		mask = ~tile;
+		if (mask)
+		{
+			if (mask & 0x000f) dst[ 7] = pal[(tile >>  0) & 0x0f];
+			if (mask & 0x00f0) dst[ 3] = pal[(tile >>  4) & 0x0f];
+			if (mask & 0x0f00) dst[ 6] = pal[(tile >>  8) & 0x0f];
+			if (mask & 0xf000) dst[ 2] = pal[(tile >> 12) & 0x0f];
+			mask >>= 16;
+			if (mask & 0x000f) dst[ 5] = pal[(tile >> 16) & 0x0f];
+			if (mask & 0x00f0) dst[ 1] = pal[(tile >> 20) & 0x0f];
+			if (mask & 0x0f00) dst[ 4] = pal[(tile >> 24) & 0x0f];
+			if (mask & 0xf000) dst[ 0] = pal[(tile >> 28) & 0x0f];
+		}
+		src += 2;
+		dst += BUF_WIDTH;
+	}
+}
+
+void drawgfx16_16x16_flipy(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
+{
+	uint32_t tile, mask;
+
+	while (lines--)
+	{
+		tile = src[0];
+		mask = ~tile;
+		if (mask)
+		{
+			if (mask & 0x000f) dst[ 0] = pal[(tile >>  0) & 0x0f];
+			if (mask & 0x00f0) dst[ 4] = pal[(tile >>  4) & 0x0f];
+			if (mask & 0x0f00) dst[ 1] = pal[(tile >>  8) & 0x0f];
+			if (mask & 0xf000) dst[ 5] = pal[(tile >> 12) & 0x0f];
+			mask >>= 16;
+			if (mask & 0x000f) dst[ 2] = pal[(tile >> 16) & 0x0f];
+			if (mask & 0x00f0) dst[ 6] = pal[(tile >> 20) & 0x0f];
+			if (mask & 0x0f00) dst[ 3] = pal[(tile >> 24) & 0x0f];
+			if (mask & 0xf000) dst[ 7] = pal[(tile >> 28) & 0x0f];
+		}
+		tile = src[1];
+		mask = ~tile;
+		if (mask)
+		{
+			if (mask & 0x000f) dst[ 8] = pal[(tile >>  0) & 0x0f];
+			if (mask & 0x00f0) dst[12] = pal[(tile >>  4) & 0x0f];
+			if (mask & 0x0f00) dst[ 9] = pal[(tile >>  8) & 0x0f];
+			if (mask & 0xf000) dst[13] = pal[(tile >> 12) & 0x0f];
+			mask >>= 16;
+			if (mask & 0x000f) dst[10] = pal[(tile >> 16) & 0x0f];
+			if (mask & 0x00f0) dst[14] = pal[(tile >> 20) & 0x0f];
+			if (mask & 0x0f00) dst[11] = pal[(tile >> 24) & 0x0f];
+			if (mask & 0xf000) dst[15] = pal[(tile >> 28) & 0x0f];
+		}
+		src += 2;
+		dst -= BUF_WIDTH;
+	}
+}
+
+void drawgfx16_16x16_flipxy(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
+{
+	uint32_t tile, mask;
+
+	while (lines--)
+	{
+		tile = src[0];
+		mask = ~tile;
+		if (mask)
+		{
+			if (mask & 0x000f) dst[15] = pal[(tile >>  0) & 0x0f];
+			if (mask & 0x00f0) dst[11] = pal[(tile >>  4) & 0x0f];
+			if (mask & 0x0f00) dst[14] = pal[(tile >>  8) & 0x0f];
+			if (mask & 0xf000) dst[10] = pal[(tile >> 12) & 0x0f];
+			mask >>= 16;
+			if (mask & 0x000f) dst[13] = pal[(tile >> 16) & 0x0f];
+			if (mask & 0x00f0) dst[ 9] = pal[(tile >> 20) & 0x0f];
+			if (mask & 0x0f00) dst[12] = pal[(tile >> 24) & 0x0f];
+			if (mask & 0xf000) dst[ 8] = pal[(tile >> 28) & 0x0f];
+		}
+		tile = src[1];
+		mask = ~tile;
+		if (mask)
+		{
+			if (mask & 0x000f) dst[ 7] = pal[(tile >>  0) & 0x0f];
+			if (mask & 0x00f0) dst[ 3] = pal[(tile >>  4) & 0x0f];
+			if (mask & 0x0f00) dst[ 6] = pal[(tile >>  8) & 0x0f];
+			if (mask & 0xf000) dst[ 2] = pal[(tile >> 12) & 0x0f];
+			mask >>= 16;
+			if (mask & 0x000f) dst[ 5] = pal[(tile >> 16) & 0x0f];
+			if (mask & 0x00f0) dst[ 1] = pal[(tile >> 20) & 0x0f];
+			if (mask & 0x0f00) dst[ 4] = pal[(tile >> 24) & 0x0f];
+			if (mask & 0xf000) dst[ 0] = pal[(tile >> 28) & 0x0f];
+		}
+		src += 2;
+		dst -= BUF_WIDTH;
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	16bpp 16x16 (opaque)
+------------------------------------------------------------------------*/
+
+void drawgfx16_16x16_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
+{
+	uint32_t tile;
+
+	while (lines--)
+	{
+		tile = src[0];
+		dst[ 0] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 7] = pal[tile & 0x0f];
+		tile = src[1];
+		dst[ 8] = pal[tile & 0x0f]; tile >>= 4;
+		dst[12] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
+		dst[13] = pal[tile & 0x0f]; tile >>= 4;
+		dst[10] = pal[tile & 0x0f]; tile >>= 4;
+		dst[14] = pal[tile & 0x0f]; tile >>= 4;
+		dst[11] = pal[tile & 0x0f]; tile >>= 4;
+		dst[15] = pal[tile & 0x0f];
+		src += 2;
+		dst += BUF_WIDTH;
+	}
+}
+
+void drawgfx16_16x16_flipx_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
+{
+	uint32_t tile;
+
+	while (lines--)
+	{
+		tile = src[0];
+		dst[15] = pal[tile & 0x0f]; tile >>= 4;
+		dst[11] = pal[tile & 0x0f]; tile >>= 4;
+		dst[14] = pal[tile & 0x0f]; tile >>= 4;
+		dst[10] = pal[tile & 0x0f]; tile >>= 4;
+		dst[13] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
+		dst[12] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 8] = pal[tile & 0x0f];
+		tile = src[1];
+		dst[ 7] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 0] = pal[tile & 0x0f];
+		src += 2;
+		dst += BUF_WIDTH;
+	}
+}
+
+void drawgfx16_16x16_flipy_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
+{
+	uint32_t tile;
+
+	while (lines--)
+	{
+		tile = src[0];
+		dst[ 0] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 7] = pal[tile & 0x0f];
+		tile = src[1];
+		dst[ 8] = pal[tile & 0x0f]; tile >>= 4;
+		dst[12] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
+		dst[13] = pal[tile & 0x0f]; tile >>= 4;
+		dst[10] = pal[tile & 0x0f]; tile >>= 4;
+		dst[14] = pal[tile & 0x0f]; tile >>= 4;
+		dst[11] = pal[tile & 0x0f]; tile >>= 4;
+		dst[15] = pal[tile & 0x0f];
+		src += 2;
+		dst -= BUF_WIDTH;
+	}
+}
+
+void drawgfx16_16x16_flipxy_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines)
+{
+	uint32_t tile;
+
+	while (lines--)
+	{
+		tile = src[0];
+		dst[15] = pal[tile & 0x0f]; tile >>= 4;
+		dst[11] = pal[tile & 0x0f]; tile >>= 4;
+		dst[14] = pal[tile & 0x0f]; tile >>= 4;
+		dst[10] = pal[tile & 0x0f]; tile >>= 4;
+		dst[13] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 9] = pal[tile & 0x0f]; tile >>= 4;
+		dst[12] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 8] = pal[tile & 0x0f];
+		tile = src[1];
+		dst[ 7] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 3] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 6] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 2] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 5] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 1] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 4] = pal[tile & 0x0f]; tile >>= 4;
+		dst[ 0] = pal[tile & 0x0f];
+		src += 2;
+		dst -= BUF_WIDTH;
+	}
+}
+
+
+
+/******************************************************************************
+	OBJECT Sprite Management
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Get sprite number from OBJECT texture
+------------------------------------------------------------------------*/
+
+int16_t object_get_sprite(uint32_t key)
+{
+	int16_t idx = tile_cache_lookup(&object_cache, key);
+
+	if (idx >= 0 && tile_cache_touch(&object_cache, idx))
+	{
+#if USE_CACHE
+		if (update_cache) update_cache(key << 7);
+#endif
+	}
+	return idx;
+}
+
+
+/*------------------------------------------------------------------------
+	Keep sprite in OBJECT texture without drawing it
+------------------------------------------------------------------------*/
+
+void object_mark_sprite(uint32_t key)
+{
+	int16_t idx = tile_cache_find(&object_cache, key);
+
+	if (idx >= 0 && tile_cache_touch(&object_cache, idx))
+	{
+#if USE_CACHE
+		if (update_cache) update_cache(key << 7);
+#endif
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Register sprite in OBJECT texture
+------------------------------------------------------------------------*/
+
+int16_t object_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&object_cache, key);
+}
+
+
+/*------------------------------------------------------------------------
+	Delete expired sprites from OBJECT texture
+------------------------------------------------------------------------*/
+
+void object_delete_sprite(void)
+{
+	tile_cache_evict(&object_cache);
+}
+
+
+/******************************************************************************
+	SCROLL1 Sprite Management
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Get sprite number from SCROLL1 texture
+------------------------------------------------------------------------*/
+
+int16_t scroll1_get_sprite(uint32_t key)
+{
+	int16_t idx = tile_cache_lookup(&scroll1_cache, key);
+
+	if (idx >= 0 && tile_cache_touch(&scroll1_cache, idx))
+	{
+#if USE_CACHE
+		if (update_cache) update_cache(key << 6);
+#endif
+	}
+	return idx;
+}
+
+
+/*------------------------------------------------------------------------
+	Keep sprite in SCROLL1 texture without drawing it
+------------------------------------------------------------------------*/
+
+void scroll1_mark_sprite(uint32_t key)
+{
+	int16_t idx = tile_cache_find(&scroll1_cache, key);
+
+	if (idx >= 0 && tile_cache_touch(&scroll1_cache, idx))
+	{
+#if USE_CACHE
+		if (update_cache) update_cache(key << 6);
+#endif
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Register sprite in SCROLL1 texture
+------------------------------------------------------------------------*/
+
+int16_t scroll1_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&scroll1_cache, key);
+}
+
+
+/*------------------------------------------------------------------------
+	Delete expired sprites from SCROLL1 texture
+------------------------------------------------------------------------*/
+
+void scroll1_delete_sprite(void)
+{
+	tile_cache_evict(&scroll1_cache);
+}
+
+
+/******************************************************************************
+	SCROLL2 Sprite Management
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Get sprite number from SCROLL2 texture
+------------------------------------------------------------------------*/
+
+int16_t scroll2_get_sprite(uint32_t key)
+{
+	int16_t idx = tile_cache_lookup(&scroll2_cache, key);
+
+	if (idx >= 0 && tile_cache_touch(&scroll2_cache, idx))
+	{
+#if USE_CACHE
+		if (update_cache) update_cache(key << 7);
+#endif
+	}
+	return idx;
+}
+
+
+/*------------------------------------------------------------------------
+	Keep sprite in SCROLL2 texture without drawing it
+------------------------------------------------------------------------*/
+
+void scroll2_mark_sprite(uint32_t key)
+{
+	int16_t idx = tile_cache_find(&scroll2_cache, key);
+
+	if (idx >= 0 && tile_cache_touch(&scroll2_cache, idx))
+	{
+#if USE_CACHE
+		if (update_cache) update_cache(key << 7);
+#endif
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Register sprite in SCROLL2 texture
+------------------------------------------------------------------------*/
+
+int16_t scroll2_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&scroll2_cache, key);
+}
+
+
+/*------------------------------------------------------------------------
+	Delete expired sprites from SCROLL2 texture
+------------------------------------------------------------------------*/
+
+void scroll2_delete_sprite(void)
+{
+	tile_cache_evict(&scroll2_cache);
+}
+
+
+/******************************************************************************
+	SCROLL3 Sprite Management
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Get sprite number from SCROLL3 texture
+------------------------------------------------------------------------*/
+
+int16_t scroll3_get_sprite(uint32_t key)
+{
+	int16_t idx = tile_cache_lookup(&scroll3_cache, key);
+
+	if (idx >= 0 && tile_cache_touch(&scroll3_cache, idx))
+	{
+#if USE_CACHE
+		if (update_cache) update_cache(key << 9);
+#endif
+	}
+	return idx;
+}
+
+
+/*------------------------------------------------------------------------
+	Keep sprite in SCROLL3 texture without drawing it
+------------------------------------------------------------------------*/
+
+void scroll3_mark_sprite(uint32_t key)
+{
+	int16_t idx = tile_cache_find(&scroll3_cache, key);
+
+	if (idx >= 0 && tile_cache_touch(&scroll3_cache, idx))
+	{
+#if USE_CACHE
+		if (update_cache) update_cache(key << 9);
+#endif
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Register sprite in SCROLL3 texture
+------------------------------------------------------------------------*/
+
+int16_t scroll3_insert_sprite(uint32_t key)
+{
+	return tile_cache_insert(&scroll3_cache, key);
+}
+
+
+/*------------------------------------------------------------------------
+	Delete expired sprites from SCROLL3 texture
+------------------------------------------------------------------------*/
+
+void scroll3_delete_sprite(void)
+{
+	tile_cache_evict(&scroll3_cache);
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+
+	sprite_common.h
+
+	CPS2 Common sprite management declarations
+
+	CPS-2 Graphics System:
+	- 4 compositable layers: SCROLL1 (8x8), SCROLL2 (16x16), SCROLL3 (32x32),
+	  OBJ (16x16 sprites)
+	- OBJ priority is given per sprite (0-7) and may be masked against
+	  the scroll layers (see cps2_objram_latch() in vidhrdw.c)
+
+******************************************************************************/
+
+#ifndef CPS2_SPRITE_COMMON_H
+#define CPS2_SPRITE_COMMON_H
+
+#include "cps2.h"
+
+/******************************************************************************
+	Constants/Macros
+******************************************************************************/
+
+#define MAKE_KEY(code, attr)	(code | ((attr & 0x0f) << 28))
+
+/* OBJECT: 16x16 sprites for characters, projectiles, etc. */
+#define OBJECT_HASH_SIZE		0x800
+#define OBJECT_TEXTURE_SIZE		((BUF_WIDTH/16)*(TEXTURE_HEIGHT/16))
+#define OBJECT_MAX_SPRITES		0x1400
+
+/* SCROLL1: 8x8 tiles (text, status) */
+#define SCROLL1_HASH_SIZE		0x2000
+#define SCROLL1_TEXTURE_SIZE	((BUF_WIDTH/8)*(TEXTURE_HEIGHT/8))
+#define SCROLL1_MAX_SPRITES		((384/8 + 2) * (224/8 + 2))
+
+/* SCROLL2: 16x16 tiles, supports per-line horizontal scrolling */
+#define SCROLL2_HASH_SIZE		0x800
+#define SCROLL2_TEXTURE_SIZE	((BUF_WIDTH/16)*(TEXTURE_HEIGHT/16))
+#define SCROLL2_MAX_SPRITES		((384/16 + 2) * (224/16 + 2))
+
+/* SCROLL3: 32x32 tiles */
+#define SCROLL3_HASH_SIZE		0x200
+#define SCROLL3_TEXTURE_SIZE	((BUF_WIDTH/32)*(TEXTURE_HEIGHT/32))
+#define SCROLL3_MAX_SPRITES		((384/32 + 2) * (224/32 + 2))
+
+/******************************************************************************
+	Shared variables (extern declarations)
+******************************************************************************/
+
+/* OBJECT */
+extern TILE_CACHE object_cache;
+extern uint8_t *tex_object;
+
+/* SCROLL1 */
+extern TILE_CACHE scroll1_cache;
+extern uint8_t *tex_scroll1;
+
+/* SCROLL2 */
+extern TILE_CACHE scroll2_cache;
+extern uint8_t *tex_scroll2;
+
+/* SCROLL3 */
+extern TILE_CACHE scroll3_cache;
+extern uint8_t *tex_scroll3;
+
+/* Scroll2 clipping */
+extern int16_t scroll2_min_y;
+extern int16_t scroll2_max_y;
+extern int16_t scroll2_sy;
+extern int16_t scroll2_ey;
+
+/* Pen usage */
+extern uint8_t *pen_usage;
+
+/* Screen bitmap */
+extern uint16_t *scrbitmap;
+
+/* CLUT */
+extern uint16_t *clut;
+extern uint16_t clut0_num;
+extern uint16_t clut1_num;
+
+/* Color table */
+extern const uint32_t ALIGN_DATA color_table[16];
+
+/******************************************************************************
+	Common function declarations
+******************************************************************************/
+
+/* OBJECT sprite management */
+int16_t object_get_sprite(uint32_t key);
+void object_mark_sprite(uint32_t key);
+int16_t object_insert_sprite(uint32_t key);
+void object_delete_sprite(void);
+
+/* SCROLL1 sprite management */
+int16_t scroll1_get_sprite(uint32_t key);
+void scroll1_mark_sprite(uint32_t key);
+int16_t scroll1_insert_sprite(uint32_t key);
+void scroll1_delete_sprite(void);
+
+/* SCROLL2 sprite management */
+int16_t scroll2_get_sprite(uint32_t key);
+void scroll2_mark_sprite(uint32_t key);
+int16_t scroll2_insert_sprite(uint32_t key);
+void scroll2_delete_sprite(void);
+
+/* SCROLL3 sprite management */
+int16_t scroll3_get_sprite(uint32_t key);
+void scroll3_mark_sprite(uint32_t key);
+int16_t scroll3_insert_sprite(uint32_t key);
+void scroll3_delete_sprite(void);
+
+/* Software rendering functions for SCROLL2 */
+void drawgfx16_16x16(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+void drawgfx16_16x16_flipx(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+void drawgfx16_16x16_flipy(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+void drawgfx16_16x16_flipxy(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+
+void drawgfx16_16x16_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+void drawgfx16_16x16_flipx_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+void drawgfx16_16x16_flipy_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+void drawgfx16_16x16_flipxy_opaque(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+
+/* Function pointer array for software rendering */
+extern void ALIGN_DATA (*drawgfx16[8])(uint32_t *src, uint16_t *dst, uint16_t *pal, int lines);
+
+#endif /* CPS2_SPRITE_COMMON_H */
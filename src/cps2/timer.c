@@ -35,6 +35,7 @@ static float timer_ticks;
 static float timer_left;
 
 static int z80_suspended;
+static int z80_cycles;
 
 
 /******************************************************************************
@@ -104,6 +105,7 @@ void timer_reset(void)
 	base_time     = 0;
 	frame_base    = 0;
 	z80_suspended = 0;
+	z80_cycles    = 0;
 
 	time_slice = 1000000.0 / FPS;
 
@@ -124,6 +126,24 @@ void timer_set(int which, float duration, int param, void (*callback)(int param)
 }
 
 
+/*------------------------------------------------------
+	Get Position in Current Frame (unit: 1/65536 frame)
+------------------------------------------------------*/
+
+int timer_get_frame_offset(void)
+{
+	float time = frame_base;
+	int offset;
+
+	if (z80_cycles)
+		time += (float)(z80_cycles - CZ80.ICount) * (1000000.0 / 8000000.0);
+
+	offset = (int)(time * 65536.0 / time_slice);
+
+	return (offset > 0xffff) ? 0xffff : offset;
+}
+
+
 /*------------------------------------------------------
 	Update CPU
 ------------------------------------------------------*/
@@ -168,7 +188,11 @@ void timer_update_cpu(void)
 		m68000_execute((int)(timer_ticks * (11800000.0 / 1000000.0)));
 
 		if (!z80_suspended)
-			z80_execute((int)(timer_ticks * (8000000.0 / 1000000.0)));
+		{
+			z80_cycles = (int)(timer_ticks * (8000000.0 / 1000000.0));
+			z80_execute(z80_cycles);
+			z80_cycles = 0;
+		}
 
 		frame_base += timer_ticks;
 		timer_left -= timer_ticks;
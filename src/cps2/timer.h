@@ -34,6 +34,7 @@
 
 void timer_reset(void);
 void timer_set(int which, float duration, int param, void (*callback)(int param));
+int timer_get_frame_offset(void);
 void timer_update_cpu(void);
 
 void z80_set_reset_line(int state);
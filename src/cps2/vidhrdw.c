@@ -638,6 +638,14 @@ void cps2_scan_object_callback(void)
   Scroll 1 (8x8 layer)
 ******************************************************************************/
 
+#define DRAW_SCROLL(blit_func, layer)										\
+	if (pen_usage[code])													\
+		blit_func(sx, sy, code, layer[offs + 1]);
+
+#define DRAW_SCROLL_SURFACE(blit_func, layer)								\
+	if (!pen_usage[code]) code = SOFT_TILEMAP_BLANK;						\
+	blit_func(logical_col + x, logical_row + y, code, layer[offs + 1]);
+
 #define scroll1_offset(col, row) (((row) & 0x1f) + (((col) & 0x3f) << 5) + (((row) & 0x20) << 6)) << 1
 
 #define SCAN_SCROLL1(blit_func)												\
@@ -669,8 +677,7 @@ void cps2_scan_object_callback(void)
 			offs = scroll1_offset(logical_col + x, logical_row + y);		\
 			code = 0x20000 + cps_scroll1[offs];								\
 																			\
-			if (pen_usage[code])											\
-				blit_func(sx, sy, code, cps_scroll1[offs + 1]);				\
+			DRAW_SCROLL1(blit_func)											\
 		}																	\
 	}
 
@@ -681,9 +688,19 @@ void cps2_scan_object_callback(void)
 
 static void cps2_render_scroll1(void)
 {
+#if USE_TILEMAP_SURFACE
+#define DRAW_SCROLL1(blit_func)	DRAW_SCROLL_SURFACE(blit_func, cps_scroll1)
+	SCAN_SCROLL1(blit_draw_scroll1_surface)
+#undef DRAW_SCROLL1
+
+	blit_finish_scroll1_surface(cps_scroll1x, cps_scroll1y);
+#else
+#define DRAW_SCROLL1(blit_func)	DRAW_SCROLL(blit_func, cps_scroll1)
 	SCAN_SCROLL1(blit_draw_scroll1)
+#undef DRAW_SCROLL1
 
 	blit_finish_scroll1();
+#endif
 }
 
 
@@ -693,7 +710,9 @@ static void cps2_render_scroll1(void)
 
 void cps2_scan_scroll1_callback(void)
 {
+#define DRAW_SCROLL1(blit_func)	DRAW_SCROLL(blit_func, cps_scroll1)
 	SCAN_SCROLL1(blit_update_scroll1)
+#undef DRAW_SCROLL1
 }
 
 
@@ -742,8 +761,7 @@ void cps2_scan_scroll1_callback(void)
 				offs = scroll2_offset(logical_col + x, logical_row + y);	\
 				code = 0x10000 + cps_scroll2[offs];							\
 																			\
-				if (pen_usage[code])										\
-					blit_func(sx, sy, code, cps_scroll2[offs + 1]);			\
+				DRAW_SCROLL2(blit_func)										\
 			}																\
 		}																	\
 																			\
@@ -759,8 +777,16 @@ static void cps2_render_scroll2(void)
 {
 #define BLIT_SET_CLIP_FUNC		blit_set_clip_scroll2(scroll2[block].start, scroll2[block].end);
 #define BLIT_CHECK_CLIP_FUNC	if (!blit_check_clip_scroll2(sy)) continue;
+#if USE_TILEMAP_SURFACE
+#define BLIT_FINISH_FUNC		blit_finish_scroll2_surface(cps_scroll2x, cps_scroll2y);
+#define DRAW_SCROLL2(blit_func)	DRAW_SCROLL_SURFACE(blit_func, cps_scroll2)
+	SCAN_SCROLL2(blit_draw_scroll2_surface)
+#else
 #define BLIT_FINISH_FUNC		blit_finish_scroll2();
+#define DRAW_SCROLL2(blit_func)	DRAW_SCROLL(blit_func, cps_scroll2)
 	SCAN_SCROLL2(blit_draw_scroll2)
+#endif
+#undef DRAW_SCROLL2
 #undef BLIT_SET_CLIP_FUNC
 #undef BLIT_CHECK_CLIP_FUNC
 #undef BLIT_FINISH_FUNC
@@ -775,7 +801,9 @@ void cps2_scan_scroll2_callback(void)
 #define BLIT_SET_CLIP_FUNC
 #define BLIT_CHECK_CLIP_FUNC
 #define BLIT_FINISH_FUNC
+#define DRAW_SCROLL2(blit_func)	DRAW_SCROLL(blit_func, cps_scroll2)
 	SCAN_SCROLL2(blit_update_scroll2)
+#undef DRAW_SCROLL2
 #undef BLIT_SET_CLIP_FUNC
 #undef BLIT_CHECK_CLIP_FUNC
 #undef BLIT_FINISH_FUNC
@@ -922,8 +950,7 @@ static void cps2_check_scroll2_distort(int distort)
 			}																\
 			code += base;													\
 																			\
-			if (pen_usage[code])											\
-				blit_func(sx, sy, code, cps_scroll3[offs + 1]);				\
+			DRAW_SCROLL3(blit_func)											\
 		}																	\
 	}
 
@@ -934,9 +961,19 @@ static void cps2_check_scroll2_distort(int distort)
 
 static void cps2_render_scroll3(void)
 {
+#if USE_TILEMAP_SURFACE
+#define DRAW_SCROLL3(blit_func)	DRAW_SCROLL_SURFACE(blit_func, cps_scroll3)
+	SCAN_SCROLL3(blit_draw_scroll3_surface)
+#undef DRAW_SCROLL3
+
+	blit_finish_scroll3_surface(cps_scroll3x, cps_scroll3y);
+#else
+#define DRAW_SCROLL3(blit_func)	DRAW_SCROLL(blit_func, cps_scroll3)
 	SCAN_SCROLL3(blit_draw_scroll3)
+#undef DRAW_SCROLL3
 
 	blit_finish_scroll3();
+#endif
 }
 
 
@@ -946,7 +983,9 @@ static void cps2_render_scroll3(void)
 
 void cps2_scan_scroll3_callback(void)
 {
+#define DRAW_SCROLL3(blit_func)	DRAW_SCROLL(blit_func, cps_scroll3)
 	SCAN_SCROLL3(blit_update_scroll3)
+#undef DRAW_SCROLL3
 }
 
 
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "emucfg.h"
 #include "common/audio_driver.h"
 
 #include <SDL.h>
@@ -10,18 +11,70 @@
  * Desktop Audio Driver
  * 
  * Uses SDL2 for audio output. Supports two modes:
- * 1. Main audio (YM2610) via chSRCReserve - uses SDL audio stream for sample rate conversion
+ * 1. Main audio via chSRCReserve - the sound thread writes into a lock-free
+ *    single producer / single consumer ring that the SDL audio callback reads.
+ *    srcOutputBlocking waits until no more than SOUND_LATENCY_MS are queued.
  * 2. MP3 audio via chReserve - direct 44.1kHz stereo output for CDDA playback
  */
 
+#define DEVICE_SAMPLES  512     /* frames per audio callback (~10ms) */
+
 typedef struct desktop_audio {
     SDL_AudioDeviceID device;
     SDL_AudioSpec spec;
-    SDL_AudioStream *stream;
     bool is_mp3_channel;
     uint16_t samples;
+
+    /* SRC channel ring (frames of interleaved stereo, size is a power of 2) */
+    uint32_t *ring;
+    uint32_t ring_size;
+    uint32_t ring_read;         /* advanced by the audio callback */
+    uint32_t ring_write;        /* advanced by the sound thread */
+    uint32_t target;
+    uint32_t underruns;
+    uint32_t overruns;
+    bool started;
+    SDL_sem *consumed;
 } desktop_audio_t;
 
+
+/* SDL audio callback: play queued frames, silence if the ring ran dry */
+static void desktop_ring_callback(void *userdata, Uint8 *stream, int len) {
+    desktop_audio_t *desktop = (desktop_audio_t*)userdata;
+    uint32_t *dst = (uint32_t*)stream;
+    uint32_t frames = len / sizeof(uint32_t);
+    uint32_t read = desktop->ring_read;
+    uint32_t queued = __atomic_load_n(&desktop->ring_write, __ATOMIC_ACQUIRE) - read;
+    uint32_t count = queued < frames ? queued : frames;
+    uint32_t pos = read & (desktop->ring_size - 1);
+    uint32_t first = desktop->ring_size - pos;
+
+    if (first > count) first = count;
+    memcpy(dst, &desktop->ring[pos], first * sizeof(uint32_t));
+    memcpy(dst + first, desktop->ring, (count - first) * sizeof(uint32_t));
+
+    if (count < frames) {
+        memset(dst + count, 0, (frames - count) * sizeof(uint32_t));
+        if (__atomic_load_n(&desktop->started, __ATOMIC_ACQUIRE))
+            __atomic_add_fetch(&desktop->underruns, 1, __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&desktop->ring_read, read + count, __ATOMIC_RELEASE);
+
+    if (SDL_SemValue(desktop->consumed) == 0)
+        SDL_SemPost(desktop->consumed);
+}
+
+static void desktop_ring_free(desktop_audio_t *desktop) {
+    if (desktop->consumed) {
+        SDL_DestroySemaphore(desktop->consumed);
+        desktop->consumed = NULL;
+    }
+
+    free(desktop->ring);
+    desktop->ring = NULL;
+}
+
 static void *desktop_init(void) {
 	desktop_audio_t *desktop = (desktop_audio_t*)calloc(1, sizeof(desktop_audio_t));
     if (SDL_WasInit(SDL_INIT_AUDIO) == 0) {
@@ -33,15 +86,11 @@ static void *desktop_init(void) {
 static void desktop_free(void *data) {
 	desktop_audio_t *desktop = (desktop_audio_t*)data;
     
-    if (desktop->stream) {
-        SDL_FreeAudioStream(desktop->stream);
-        desktop->stream = NULL;
-    }
-    
     if (desktop->device) {
         SDL_CloseAudioDevice(desktop->device);
         desktop->device = 0;
     }
+    desktop_ring_free(desktop);
 	
     free(desktop);
 }
@@ -54,16 +103,39 @@ static bool desktop_chSRCReserve(void *data, uint16_t samples, int32_t frequency
     desktop_audio_t *desktop = (desktop_audio_t*)data;
 
     SDL_AudioSpec desired, obtained;
+    uint32_t size;
+
+    /* hold the target latency plus two writes */
+    desktop->target = (uint32_t)frequency * SOUND_LATENCY_MS / 1000;
+    for (size = 1; size < desktop->target + samples * 2; size <<= 1);
+
+    desktop->ring = (uint32_t*)calloc(size, sizeof(uint32_t));
+    desktop->consumed = SDL_CreateSemaphore(0);
+    if (!desktop->ring || !desktop->consumed) {
+        fprintf(stderr, "Failed to allocate audio ring buffer\n");
+        desktop_ring_free(desktop);
+        return false;
+    }
+    desktop->ring_size = size;
+    desktop->ring_read = 0;
+    desktop->ring_write = 0;
+    desktop->underruns = 0;
+    desktop->overruns = 0;
+    desktop->started = false;
+
     SDL_memset(&desired, 0, sizeof(desired));
     desired.freq = frequency;
     desired.format = AUDIO_S16SYS;
     desired.channels = channels;
-    desired.samples = samples;
-    desired.callback = NULL;
+    desired.samples = DEVICE_SAMPLES;
+    desired.callback = desktop_ring_callback;
+    desired.userdata = desktop;
 
-    desktop->device = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, SDL_AUDIO_ALLOW_ANY_CHANGE);
+    /* keep format and rate: samples are played without a second conversion */
+    desktop->device = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
     if (desktop->device <= 0) {
         fprintf(stderr, "Failed to open audio device: %s\n", SDL_GetError());
+        desktop_ring_free(desktop);
         return false;
     }
 
@@ -71,16 +143,6 @@ static bool desktop_chSRCReserve(void *data, uint16_t samples, int32_t frequency
     desktop->is_mp3_channel = false;
     desktop->samples = samples;
     
-    /* Create an audio stream for sample rate conversion */
-    desktop->stream = SDL_NewAudioStream(AUDIO_S16SYS, channels, frequency,
-                                        obtained.format, obtained.channels, obtained.freq);
-    if (!desktop->stream) {
-        fprintf(stderr, "Failed to create audio stream: %s\n", SDL_GetError());
-        SDL_CloseAudioDevice(desktop->device);
-        desktop->device = 0;
-        return false;
-    }
-    
     SDL_PauseAudioDevice(desktop->device, 0);
     return true;
 }
@@ -106,7 +168,6 @@ static bool desktop_chReserve(void *data, uint16_t samplecount, uint8_t channels
     desktop->spec = obtained;
     desktop->is_mp3_channel = true;
     desktop->samples = samplecount;
-    desktop->stream = NULL;
     
     SDL_PauseAudioDevice(desktop->device, 0);
     
@@ -117,45 +178,46 @@ static bool desktop_chReserve(void *data, uint16_t samplecount, uint8_t channels
 static void desktop_release(void *data) {
     desktop_audio_t *desktop = (desktop_audio_t*)data;
 
-    if (desktop->stream) {
-        SDL_FreeAudioStream(desktop->stream);
-        desktop->stream = NULL;
-    }
-
     if (desktop->device) {
         SDL_CloseAudioDevice(desktop->device);
         desktop->device = 0;
     }
+    desktop_ring_free(desktop);
 }
 
 static void desktop_srcOutputBlocking(void *data, int32_t volume, void *buffer, uint32_t size) {
     desktop_audio_t *desktop = (desktop_audio_t*)data;
 
-    if (!desktop->device || !desktop->stream) {
-        fprintf(stderr, "Audio device or stream not initialized\n");
-        return;
-    }
-    
-    /* Add data to the stream for conversion */
-    if (SDL_AudioStreamPut(desktop->stream, buffer, size) < 0) {
-        fprintf(stderr, "Failed to queue audio stream data: %s\n", SDL_GetError());
+    const uint32_t *src = (const uint32_t*)buffer;
+    uint32_t frames = size / sizeof(uint32_t);
+    uint32_t write = desktop->ring_write;
+    uint32_t space, pos, first;
+
+    if (!desktop->device || !desktop->ring) {
+        fprintf(stderr, "Audio device not initialized\n");
         return;
     }
 
-    int available = SDL_AudioStreamAvailable(desktop->stream);
-    if (available > 0) {
-        void *out_buffer = malloc(available);
-        int len = SDL_AudioStreamGet(desktop->stream, out_buffer, available);
-        if (len > 0) {
-            SDL_QueueAudio(desktop->device, out_buffer, len);
-        }
-        free(out_buffer);
+    /* Block until the callback has played down to the target latency */
+    while (write - __atomic_load_n(&desktop->ring_read, __ATOMIC_ACQUIRE) > desktop->target) {
+        if (SDL_SemWaitTimeout(desktop->consumed, 100) == SDL_MUTEX_TIMEDOUT)
+            break;
     }
 
-    /* Wait if too much audio is queued to prevent runaway buffering */
-    while (SDL_GetQueuedAudioSize(desktop->device) > size * 8) {
-        SDL_Delay(1);
+    space = desktop->ring_size - (write - __atomic_load_n(&desktop->ring_read, __ATOMIC_ACQUIRE));
+    if (frames > space) {
+        __atomic_add_fetch(&desktop->overruns, 1, __ATOMIC_RELAXED);
+        frames = space;
     }
+
+    pos = write & (desktop->ring_size - 1);
+    first = desktop->ring_size - pos;
+    if (first > frames) first = frames;
+    memcpy(&desktop->ring[pos], src, first * sizeof(uint32_t));
+    memcpy(desktop->ring, src + first, (frames - first) * sizeof(uint32_t));
+
+    __atomic_store_n(&desktop->ring_write, write + frames, __ATOMIC_RELEASE);
+    __atomic_store_n(&desktop->started, true, __ATOMIC_RELEASE);
 }
 
 static void desktop_outputPannedBlocking(void *data, int leftvol, int rightvol, void *buffer, uint32_t size) {
@@ -193,6 +255,21 @@ static void desktop_outputPannedBlocking(void *data, int leftvol, int rightvol,
     }
 }
 
+static bool desktop_stats(void *data, audio_stats_t *stats) {
+    desktop_audio_t *desktop = (desktop_audio_t*)data;
+
+    if (!desktop->ring)
+        return false;
+
+    stats->frequency = desktop->spec.freq;
+    stats->queued    = __atomic_load_n(&desktop->ring_write, __ATOMIC_ACQUIRE) - __atomic_load_n(&desktop->ring_read, __ATOMIC_ACQUIRE);
+    stats->target    = desktop->target;
+    stats->capacity  = desktop->ring_size;
+    stats->underruns = __atomic_load_n(&desktop->underruns, __ATOMIC_RELAXED);
+    stats->overruns  = __atomic_load_n(&desktop->overruns, __ATOMIC_RELAXED);
+    return true;
+}
+
 audio_driver_t audio_desktop = {
 	"desktop",
 	desktop_init,
@@ -203,4 +280,5 @@ audio_driver_t audio_desktop = {
 	desktop_srcOutputBlocking,
 	desktop_outputPannedBlocking,
 	desktop_release,
+	desktop_stats,
 };
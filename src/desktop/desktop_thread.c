@@ -8,6 +8,7 @@ typedef struct desktop_thread {
     SDL_Thread *thread;
     SDL_sem *start;
     SDL_sem *end;
+    SDL_sem *wakeup;
     int32_t (*threadFunc)(uint32_t, void *);
 } desktop_thread_t;
 
@@ -37,6 +38,7 @@ static bool desktop_createThread(void *data, const char *name, int32_t (*threadF
     desktop->threadFunc = threadFunc;
     desktop->start = SDL_CreateSemaphore(0);
     desktop->end = SDL_CreateSemaphore(0);
+    desktop->wakeup = SDL_CreateSemaphore(0);
     desktop->thread = SDL_CreateThreadWithStackSize(childThread, name, stackSize, desktop);
 
 	return desktop->thread != NULL;
@@ -49,15 +51,21 @@ static void desktop_startThread(void *data) {
 
 static void desktop_waitThreadEnd(void *data) {
 	desktop_thread_t *desktop = (desktop_thread_t*)data;
-    SDL_SemPost(desktop->end);
+    SDL_SemWait(desktop->end);
 }
 
 static void desktop_wakeupThread(void *data) {
 	desktop_thread_t *desktop = (desktop_thread_t*)data;
+    SDL_SemPost(desktop->wakeup);
 }
 
 static void desktop_deleteThread(void *data) {
 	desktop_thread_t *desktop = (desktop_thread_t*)data;
+    SDL_WaitThread(desktop->thread, NULL);
+    SDL_DestroySemaphore(desktop->start);
+    SDL_DestroySemaphore(desktop->end);
+    SDL_DestroySemaphore(desktop->wakeup);
+    desktop->thread = NULL;
 }
 
 static void desktop_resumeThread(void *data) {
@@ -69,11 +77,29 @@ static void desktop_suspendThread(void *data) {
 }
 
 static void desktop_sleepThread(void *data) {
+	desktop_thread_t *desktop = (desktop_thread_t*)data;
+    SDL_SemWait(desktop->wakeup);
 }
 
 static void desktop_exitThread(void *data, int32_t exitCode) {
 }
 
+static void *desktop_createSema(void) {
+	return SDL_CreateSemaphore(0);
+}
+
+static void desktop_deleteSema(void *sema) {
+	SDL_DestroySemaphore((SDL_sem *)sema);
+}
+
+static void desktop_waitSema(void *sema) {
+	SDL_SemWait((SDL_sem *)sema);
+}
+
+static void desktop_signalSema(void *sema) {
+	SDL_SemPost((SDL_sem *)sema);
+}
+
 thread_driver_t thread_desktop = {
 	"desktop",
 	desktop_init,
@@ -86,5 +112,9 @@ thread_driver_t thread_desktop = {
 	desktop_resumeThread,
 	desktop_suspendThread,
 	desktop_sleepThread,
-	desktop_exitThread
+	desktop_exitThread,
+	desktop_createSema,
+	desktop_deleteSema,
+	desktop_waitSema,
+	desktop_signalSema
 };
@@ -2,10 +2,15 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <time.h>
+#include <errno.h>
 
 #include <timer.h>
 #include "common/ticker_driver.h"
 
+// The OS may wake a sleeping thread late by up to a scheduler tick, so
+// the last part of a wait is spent polling the clock instead.
+#define SPIN_TAIL_US	1500
+
 typedef struct desktop_ticker {
 } desktop_ticker_t;
 
@@ -25,9 +30,25 @@ static u_int64_t desktop_currentUs(void *data) {
     return (start.tv_sec * 1000000) + (start.tv_nsec / 1000);
 }
 
+static void desktop_sleepUntilUs(void *data, uint64_t target) {
+	uint64_t curr = desktop_currentUs(data);
+
+	if (target > curr + SPIN_TAIL_US) {
+		struct timespec ts;
+		uint64_t wait = target - curr - SPIN_TAIL_US;
+
+		ts.tv_sec  = wait / 1000000;
+		ts.tv_nsec = (wait % 1000000) * 1000;
+		while (nanosleep(&ts, &ts) != 0 && errno == EINTR);
+	}
+
+	while (desktop_currentUs(data) < target);
+}
+
 ticker_driver_t ticker_desktop = {
 	"desktop",
 	desktop_init,
 	desktop_free,
 	desktop_currentUs,
+	desktop_sleepUntilUs,
 };
\ No newline at end of file
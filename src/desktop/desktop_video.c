@@ -14,6 +14,10 @@
 #define OUTPUT_WIDTH 640
 #define OUTPUT_HEIGHT 480
 
+// Host color (ARGB8888) of each 15bpp frame color, built once at init so
+// the frame is converted with one lookup per pixel instead of by SDL.
+static uint32_t ALIGN_DATA color_lut[0x8000];
+
 typedef struct desktop_video {
 	SDL_Window* window;
 	SDL_Renderer* renderer;
@@ -23,8 +27,10 @@ typedef struct desktop_video {
     // Base clut starting address
     uint16_t *clut_base;
 
+	// Frame drawn by the software blitter (16bpp)
+	uint16_t *scrbitmap;
+
 	// Original buffers containing clut indexes
-	uint8_t *scrbitmap;
 	uint8_t *tex_spr;
 	uint8_t *tex_spr0;
 	uint8_t *tex_spr1;
@@ -38,6 +44,23 @@ typedef struct desktop_video {
 	SDL_Texture *sdl_texture_tex_fix;
 } desktop_video_t;
 
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+/*--------------------------------------------------------
+	Build 15bpp to host color table
+--------------------------------------------------------*/
+
+static void desktop_init_color_lut(void)
+{
+	uint32_t col;
+
+	for (col = 0; col < 0x8000; col++)
+		color_lut[col] = 0xff000000 | (GETR15(col) << 16) | (GETG15(col) << 8) | GETB15(col);
+}
+
+
 /******************************************************************************
 	Global Functions
 ******************************************************************************/
@@ -91,9 +114,9 @@ static void *desktop_init(void)
 	);
 
 	// Original buffers containing clut indexes
-	size_t scrbitmapSize = BUF_WIDTH * SCR_HEIGHT;
+	size_t scrbitmapSize = BUF_WIDTH * SCR_HEIGHT * sizeof(uint16_t);
 	size_t textureSize = BUF_WIDTH * TEXTURE_HEIGHT;
-	desktop->scrbitmap = (uint8_t*)malloc(scrbitmapSize);
+	desktop->scrbitmap = (uint16_t*)calloc(1, scrbitmapSize);
 	uint8_t *tex_spr = (uint8_t*)malloc(textureSize * 3);
 	desktop->tex_spr = tex_spr;
 	desktop->tex_spr0 = tex_spr;
@@ -102,7 +125,7 @@ static void *desktop_init(void)
 	desktop->tex_fix = (uint8_t*)malloc(textureSize);
 
 	// Create SDL textures
-	desktop->sdl_texture_scrbitmap = SDL_CreateTexture(desktop->renderer, SDL_PIXELFORMAT_ABGR1555, SDL_TEXTUREACCESS_TARGET, BUF_WIDTH, SCR_HEIGHT);
+	desktop->sdl_texture_scrbitmap = SDL_CreateTexture(desktop->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, BUF_WIDTH, SCR_HEIGHT);
 	if (desktop->sdl_texture_scrbitmap == NULL) {
 		printf("Could not create sdl_texture_scrbitmap: %s\n", SDL_GetError());
 		exit(1);
@@ -130,12 +153,15 @@ static void *desktop_init(void)
 		exit(1);
 	}
 
-	SDL_SetTextureBlendMode(desktop->sdl_texture_scrbitmap, desktop->blendMode);
+	// bit 15 of the frame is not alpha, blitted pixels are always opaque
+	SDL_SetTextureBlendMode(desktop->sdl_texture_scrbitmap, SDL_BLENDMODE_NONE);
 	SDL_SetTextureBlendMode(desktop->sdl_texture_tex_spr0, desktop->blendMode);
 	SDL_SetTextureBlendMode(desktop->sdl_texture_tex_spr1, desktop->blendMode);
 	SDL_SetTextureBlendMode(desktop->sdl_texture_tex_spr2, desktop->blendMode);
 	SDL_SetTextureBlendMode(desktop->sdl_texture_tex_fix, desktop->blendMode);
 
+	desktop_init_color_lut();
+
 	ui_init();
 
 	return desktop;
@@ -286,22 +312,91 @@ static void desktop_fillFrame(void *data, void *frame, uint32_t color)
 }
 
 
+/*--------------------------------------------------------
+	Get SDL Texture of Work Buffer
+--------------------------------------------------------*/
+
+static SDL_Texture *desktop_getTexture(void *data, enum WorkBuffer buffer) {
+	desktop_video_t *desktop = (desktop_video_t*)data;
+	switch (buffer) {
+		case SCRBITMAP:
+			return desktop->sdl_texture_scrbitmap;
+		case TEX_SPR0:
+			return desktop->sdl_texture_tex_spr0;
+		case TEX_SPR1:
+			return desktop->sdl_texture_tex_spr1;
+		case TEX_SPR2:
+			return desktop->sdl_texture_tex_spr2;
+		case TEX_FIX:
+			return desktop->sdl_texture_tex_fix;
+		default:
+			return NULL;
+	}
+}
+
+
+/*--------------------------------------------------------
+	Convert Texture for Debug View
+--------------------------------------------------------*/
+
+static void desktop_updateTexture(desktop_video_t *desktop, enum WorkBuffer buffer) {
+	SDL_Texture *texture = desktop_getTexture(desktop, buffer);
+	uint8_t *tex = desktop_workFrame(desktop, buffer);
+	uint8_t *pixels;
+	uint16_t *dst;
+	int x, y, pitch;
+
+	if (!desktop->clut_base)
+		return;
+
+	if (SDL_LockTexture(texture, NULL, (void **)&pixels, &pitch) != 0)
+		return;
+
+	for (y = 0; y < TEXTURE_HEIGHT; y++, tex += BUF_WIDTH, pixels += pitch)
+	{
+		dst = (uint16_t *)pixels;
+		for (x = 0; x < BUF_WIDTH; x++)
+			dst[x] = desktop->clut_base[tex[x]];
+	}
+
+	SDL_UnlockTexture(texture);
+}
+
+
 /*--------------------------------------------------------
 	Copy Rectangular Area
 --------------------------------------------------------*/
 
+static const RECT frame_clip = { 0, 0, BUF_WIDTH, SCR_HEIGHT };
+
+/*--------------------------------------------------------
+	Convert Frame Area to Host Color Texture
+--------------------------------------------------------*/
+
+static void desktop_convertFrame(desktop_video_t *desktop, const SDL_Rect *rect)
+{
+	const uint16_t *src = &desktop->scrbitmap[rect->y * BUF_WIDTH + rect->x];
+	uint8_t *pixels;
+	uint32_t *dst;
+	int x, y, pitch;
+
+	if (SDL_LockTexture(desktop->sdl_texture_scrbitmap, rect, (void **)&pixels, &pitch) != 0)
+		return;
+
+	for (y = 0; y < rect->h; y++, src += BUF_WIDTH, pixels += pitch)
+	{
+		dst = (uint32_t *)pixels;
+		for (x = 0; x < rect->w; x++)
+			dst[x] = color_lut[src[x] & 0x7fff];
+	}
+
+	SDL_UnlockTexture(desktop->sdl_texture_scrbitmap);
+}
+
 static void desktop_startWorkFrame(void *data, uint32_t color) {
-    desktop_video_t *desktop = (desktop_video_t*)data;
-    
-    if (SDL_SetRenderTarget(desktop->renderer, desktop->sdl_texture_scrbitmap) != 0) {
-        printf("Failed to set render target: %s\n", SDL_GetError());
-    }
-
-    uint8_t alpha = color >> 24;
-    uint8_t blue = color >> 16;
-    uint8_t green = color >> 8;
-    uint8_t red = color >> 0;
-    SDL_SetRenderDrawColor(desktop->renderer, red, green, blue, alpha);
+	desktop_video_t *desktop = (desktop_video_t*)data;
+
+	soft_blit_fill(desktop->scrbitmap, &frame_clip, MAKECOL15(GETR32(color), GETG32(color), GETB32(color)));
 }
 
 static void desktop_transferWorkFrame(void *data, RECT *src_rect, RECT *dst_rect)
@@ -320,7 +415,7 @@ static void desktop_transferWorkFrame(void *data, RECT *src_rect, RECT *dst_rect
     src.w = src_rect->right - src_rect->left;
     src.h = src_rect->bottom - src_rect->top;
     
-    SDL_SetRenderTarget(desktop->renderer, NULL);
+    desktop_convertFrame(desktop, &src);
     SDL_RenderCopy(desktop->renderer, desktop->sdl_texture_scrbitmap, &src, &dst);
 
 	if (!desktop->draw_extra_info) {
@@ -348,6 +443,11 @@ static void desktop_transferWorkFrame(void *data, RECT *src_rect, RECT *dst_rect
 	SDL_RenderFillRect(desktop->renderer, &dst_rect_spr2);
 	SDL_RenderFillRect(desktop->renderer, &dst_rect_fix);
 
+	desktop_updateTexture(desktop, TEX_SPR0);
+	desktop_updateTexture(desktop, TEX_SPR1);
+	desktop_updateTexture(desktop, TEX_SPR2);
+	desktop_updateTexture(desktop, TEX_FIX);
+
 	SDL_RenderCopy(desktop->renderer, desktop->sdl_texture_tex_spr0, NULL, &dst_rect_spr0);
 	SDL_RenderCopy(desktop->renderer, desktop->sdl_texture_tex_spr1, NULL, &dst_rect_spr1);
 	SDL_RenderCopy(desktop->renderer, desktop->sdl_texture_tex_spr2, NULL, &dst_rect_spr2);	
@@ -390,81 +490,15 @@ static void *desktop_getNativeObjects(void *data, int index) {
 	return NULL;
 }
 
-static SDL_Texture *desktop_getTexture(void *data, enum WorkBuffer buffer) {
-	desktop_video_t *desktop = (desktop_video_t*)data;
-	switch (buffer) {
-		case SCRBITMAP:
-			return desktop->sdl_texture_scrbitmap;
-		case TEX_SPR0:
-			return desktop->sdl_texture_tex_spr0;
-		case TEX_SPR1:
-			return desktop->sdl_texture_tex_spr1;
-		case TEX_SPR2:
-			return desktop->sdl_texture_tex_spr2;
-		case TEX_FIX:
-			return desktop->sdl_texture_tex_fix;
-		default:
-			return NULL;
-	}
-}
-
-#define MIN(X, Y) (((X) < (Y)) ? (X) : (Y))
+/*--------------------------------------------------------
+	Draw Sprites (software blitter)
+--------------------------------------------------------*/
 
 static void desktop_blitTexture(void *data, enum WorkBuffer buffer, void *clut, uint8_t clut_index, uint32_t vertices_count, void *vertices) {
-	// We need to transform the texutres saved that uses clut into a SDL texture compatible format
-	SDL_Point size;
 	desktop_video_t *desktop = (desktop_video_t *)data;
-	struct Vertex *vertexs = (struct Vertex *)vertices;
-	uint16_t *clut_texture = (uint16_t *)clut;
-	uint8_t *tex_fix = desktop_workFrame(data, buffer);
-	SDL_Texture *texture = desktop_getTexture(data, buffer);
-	SDL_QueryTexture(texture, NULL, NULL, &size.x, &size.y);
-
-	// Lock texture
-	void *pixels;
-	int pitch;
-	SDL_LockTexture(texture, NULL, &pixels, &pitch);
-
-	// Obtain the color from the clut using the index and copy it to the pixels array
-	for (int i = 0; i < size.y; ++i) {
-		for (int j = 0; j < size.x; ++j) {
-			int index = i * size.x + j;
-			uint8_t pixelValue = tex_fix[index];
-			uint16_t color = clut_texture[pixelValue];
-
-			uint16_t *pixel = (uint16_t*)pixels + index;
-			*pixel = color;
-		}
-	}
+	uint8_t *tex = desktop_workFrame(data, buffer);
 
-	// Unlock texture
-	SDL_UnlockTexture(texture);
-
-    SDL_Rect dst_rect, src_rect;
-    SDL_RendererFlip horizontalFlip, verticalFlip;
-	// Render Geometry expect to receive a SDL_Vertex array and it is using triangles
-	// however desktop_blitTexture receives a SDL_Vertex array using 2 vertex per sprite
-	// so we are going to use SDL_RenderCopy to render all the sprites
-	for (int i = 0; i < vertices_count; i += 2) {
-		struct Vertex *vertex1 = &vertexs[i];
-		struct Vertex *vertex2 = &vertexs[i + 1];
-
-        dst_rect.x = vertex1->x;
-        dst_rect.y = vertex1->y;
-        dst_rect.w = abs(vertex2->x - vertex1->x);
-        dst_rect.h = abs(vertex2->y - vertex1->y);
-        
-        src_rect.x = MIN(vertex1->u, vertex2->u);
-        src_rect.y = MIN(vertex1->v, vertex2->v);
-        src_rect.w = abs(vertex2->u - vertex1->u);
-        src_rect.h = abs(vertex2->v - vertex1->v);
-        
-        horizontalFlip = vertex1->u > vertex2->u ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-        verticalFlip = vertex1->v > vertex2->v ? SDL_FLIP_VERTICAL : SDL_FLIP_NONE;
-        
-		// Render the sprite
-        SDL_RenderCopyEx(desktop->renderer, texture, &src_rect, &dst_rect, 0, NULL, horizontalFlip | verticalFlip);
-	}
+	soft_blit_clut8(desktop->scrbitmap, &frame_clip, tex, (uint16_t *)clut, (struct Vertex *)vertices, vertices_count);
 }
 
 static void desktop_uploadMem(void *data, enum WorkBuffer buffer) {
@@ -36,6 +36,78 @@
 
 #define QSOUND_STREAM_48KHz		0	// Setting to 1 may improve audio quality
 
+#ifndef USE_PREDECODE_GFX
+#ifdef DESKTOP
+#define USE_PREDECODE_GFX		1	// Expand sprite ROM to 8bpp at load time (2x ROM size)
+#else
+#define USE_PREDECODE_GFX		0
+#endif
+#endif
+
+#ifndef USE_RASTER_LOG
+#ifdef DESKTOP
+#define USE_RASTER_LOG			1	// MVS: log raster changes and draw all bands at the end of the frame
+#else
+#define USE_RASTER_LOG			0
+#endif
+#endif
+
+#ifndef USE_RENDER_THREAD
+#ifdef DESKTOP
+#define USE_RENDER_THREAD		1	// Compose frame N on a second thread while frame N+1 is emulated
+#else
+#define USE_RENDER_THREAD		0
+#endif
+#endif
+
+#ifndef USE_TILEMAP_SURFACE
+#ifdef DESKTOP
+#define USE_TILEMAP_SURFACE		1	// CPS1/CPS2: keep scroll layers decoded in wrap-around surfaces
+#else
+#define USE_TILEMAP_SURFACE		0
+#endif
+#endif
+
+#ifndef USE_ADPCM_CACHE
+#ifdef DESKTOP
+#define USE_ADPCM_CACHE			1	// YM2610 / OKIM6295: keep decoded ADPCM samples in memory (LRU)
+#else
+#define USE_ADPCM_CACHE			0
+#endif
+#endif
+
+#ifndef SOUND_RESAMPLER_TAPS
+#ifdef DESKTOP
+#define SOUND_RESAMPLER_TAPS	32	// Windowed-sinc taps per output sample (8 = low CPU .. 64 = best, 0 = off)
+#else
+#define SOUND_RESAMPLER_TAPS	0
+#endif
+#endif
+
+#ifndef SOUND_LATENCY_MS
+#ifdef DESKTOP
+#define SOUND_LATENCY_MS		40	// Audio queued ahead of the device before the sound thread blocks
+#else
+#define SOUND_LATENCY_MS		0
+#endif
+#endif
+
+#ifndef SOUND_RATE_CONTROL
+#ifdef DESKTOP
+#define SOUND_RATE_CONTROL		5000	// Max resampling rate change (ppm) holding the audio queue at its target (0 = off)
+#else
+#define SOUND_RATE_CONTROL		0
+#endif
+#endif
+
+#ifndef SOUND_EMU_THREAD
+#ifdef DESKTOP
+#define SOUND_EMU_THREAD		1	// Render sound chips per frame on the emulation thread, the sound thread only feeds the device
+#else
+#define SOUND_EMU_THREAD		0
+#endif
+#endif
+
 
 /******************************************************************************
 	CPS1 Settings
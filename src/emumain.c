@@ -70,6 +70,11 @@ static int rendered_frames_since_last_fps;
 static float game_speed_percent;
 static float frames_per_second;
 
+static uint64_t pacing_error_sum;
+static uint32_t pacing_error_max;
+static uint32_t pacing_waits;
+static uint32_t pacing_misses;
+
 static int snap_no = -1;
 
 static char fatal_error_message[256];
@@ -131,6 +136,28 @@ static void show_fps(void)
 }
 
 
+/*--------------------------------------------------------
+	Frame Pacing Statistics Display
+--------------------------------------------------------*/
+
+static void show_pacing(void)
+{
+	if (pacing_waits)
+	{
+		printf("pacing   wake error %6.1fus avg  %5uus max  waits %4u  missed %4u\n",
+			(float)pacing_error_sum / pacing_waits,
+			pacing_error_max,
+			pacing_waits,
+			pacing_misses);
+	}
+
+	pacing_error_sum = 0;
+	pacing_error_max = 0;
+	pacing_waits = 0;
+	pacing_misses = 0;
+}
+
+
 /*--------------------------------------------------------
 	Battery Low Warning Display
 --------------------------------------------------------*/
@@ -202,6 +229,15 @@ void autoframeskip_reset(void)
 	game_speed_percent = 100;
 	frames_per_second = REFRESH_RATE;
 	frames_displayed = 0;
+	tile_cache_reset_stats();
+
+	pacing_error_sum = 0;
+	pacing_error_max = 0;
+	pacing_waits = 0;
+	pacing_misses = 0;
+#if (EMU_SYSTEM == MVS || EMU_SYSTEM == NCDZ)
+	video_dirty = VIDEO_DIRTY_ALL;
+#endif
 
 	warming_up = 1;
 }
@@ -228,6 +264,9 @@ void update_screen(void)
 	if (show_frames_each_second && (frames_displayed % 60) == 0)
 	{
 		show_fps();
+		show_pacing();
+		tile_cache_report();
+		sound_report();
 	}
 
 	if (!skipped_it)
@@ -274,8 +313,23 @@ void update_screen(void)
 				}
 			}
 
-			if (target > curr) usleep(target - curr);
-			curr = ticker_driver->currentUs(ticker_data);
+			if (target > curr)
+			{
+				uint32_t error;
+
+				ticker_driver->sleepUntilUs(ticker_data, target);
+				curr = ticker_driver->currentUs(ticker_data);
+
+				error = curr - target;
+				pacing_error_sum += error;
+				if (pacing_error_max < error) pacing_error_max = error;
+				pacing_waits++;
+			}
+			else
+			{
+				pacing_misses++;
+				curr = ticker_driver->currentUs(ticker_data);
+			}
 		}
 		if (!flip) video_driver->flipScreen(video_data, 0);
 
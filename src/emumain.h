@@ -187,6 +187,11 @@ extern UI_PALETTE ui_palette[UI_PAL_MAX];
 #include "common/video_driver.h"
 #include "common/ui_text_driver.h"
 #include "common/input_driver.h"
+#include "common/tile_decode.h"
+#include "common/tile_cache.h"
+#include "common/soft_blit.h"
+#include "common/render_thread.h"
+#include "common/resampler.h"
 #ifdef ADHOC
 #include "common/adhoc.h"
 #endif
@@ -38,6 +38,7 @@ COREOBJS = \
 	cps2/inptport.o \
 	cps2/timer.o \
 	cps2/vidhrdw.o \
+	cps2/sprite_common.o \
 	cps2/$(OS)_sprite.o \
 	cps2/eeprom.o \
 	sound/qsound.o
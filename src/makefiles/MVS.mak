@@ -49,6 +49,7 @@ COREOBJS = \
 	mvs/vidhrdw.o \
 	mvs/sprite_common.o \
 	mvs/$(OS)_sprite.o \
+	mvs/displist.o \
 	mvs/pd4990a.o \
 	mvs/neocrypt.o \
 	mvs/biosmenu.o \
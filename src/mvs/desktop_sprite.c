@@ -75,17 +75,12 @@ void blit_set_spr_clear_flag(void)
 
 void blit_reset(void)
 {
-	int i;
-
 	scrbitmap  = (uint16_t *)video_driver->workFrame(video_data, SCRBITMAP);
 	tex_spr[0] = video_driver->workFrame(video_data, TEX_SPR0);
 	tex_spr[1] = video_driver->workFrame(video_data, TEX_SPR1);
 	tex_spr[2] = video_driver->workFrame(video_data, TEX_SPR2);
 	tex_fix    = video_driver->workFrame(video_data, TEX_FIX);
 
-	for (i = 0; i < FIX_TEXTURE_SIZE; i++) fix_data[i].index = i;
-	for (i = 0; i < SPR_TEXTURE_SIZE; i++) spr_data[i].index = i;
-
 	clip_min_y = FIRST_VISIBLE_LINE;
 	clip_max_y = LAST_VISIBLE_LINE;
 
@@ -111,8 +106,8 @@ void blit_start(int start, int end)
 
 	if (start == FIRST_VISIBLE_LINE)
 	{
-		clut = (uint16_t *)&video_palettebank[palette_bank];
-		clut_index = palette_bank;
+		clut = BLIT_PALETTE;
+		clut_index = BLIT_PALETTE_BANK;
 
 		fix_num = 0;
 		spr_disable = 0;
@@ -120,7 +115,7 @@ void blit_start(int start, int end)
 		if (clear_spr_texture) blit_clear_spr_sprite();
 		if (clear_fix_texture) blit_clear_fix_sprite();
 
-		video_driver->startWorkFrame(video_data, CNVCOL15TO32(video_palette[4095]));
+		video_driver->startWorkFrame(video_data, CNVCOL15TO32(BLIT_PALETTE[4095]));
 	}
 }
 
@@ -147,26 +142,20 @@ void blit_draw_fix(int x, int y, uint32_t code, uint16_t attr)
 
 	if ((idx = fix_get_sprite(key)) < 0)
 	{
-		uint32_t col, tile;
-		uint8_t *src, *dst, lines, row, column;
+		uint32_t col;
+		uint8_t *src, *dst, row, column;
 
-		if (fix_texture_num == FIX_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&fix_cache))
 			fix_delete_sprite();
 
 		idx = fix_insert_sprite(key);
-		src = &fix_memory[code << 5];
+		src = &BLIT_FIX_MEMORY[code << 5];
 		col = color_table[attr];
 
 		row = idx / TILE_8x8_PER_LINE;
 		column = idx % TILE_8x8_PER_LINE;
-		for (lines = 0; lines < 8; lines++)
-		{
-			dst = &tex_fix[((row * 8) + lines) * BUF_WIDTH + (column * 8)];
-			tile = *(uint32_t *)(src + 0);
-			*(uint32_t *)(dst +  0) = ((tile >> 0) & 0x0f0f0f0f) | col;
-			*(uint32_t *)(dst +  4) = ((tile >> 4) & 0x0f0f0f0f) | col;
-			src += 4;
-		}
+		dst = &tex_fix[(row * 8) * BUF_WIDTH + (column * 8)];
+		tile_decode_8(dst, BUF_WIDTH, src, col);
 	}
 
 	vertices = &vertices_fix[fix_num];
@@ -211,14 +200,14 @@ void blit_draw_spr(int x, int y, int w, int h, uint32_t code, uint16_t attr)
 
 	if ((idx = spr_get_sprite(key)) < 0)
 	{
-		uint32_t col, tile, offset, gfx3_offset;
-		uint8_t *src, *dst, lines, row, column;
+		uint32_t col, offset, gfx3_offset;
+		uint8_t *src, *dst, row, column;
 
-		if (spr_texture_num == SPR_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&spr_cache))
 		{
 			spr_delete_sprite();
 
-			if (spr_texture_num == SPR_TEXTURE_SIZE - 1)
+			if (tile_cache_full(&spr_cache))
 			{
 				spr_disable = 1;
 				return;
@@ -226,23 +215,23 @@ void blit_draw_spr(int x, int y, int w, int h, uint32_t code, uint16_t attr)
 		}
 
 		idx = spr_insert_sprite(key);
-        gfx3_offset = read_cache ? read_cache(code << 7) : code << 7;
-		src = &memory_region_gfx3[gfx3_offset];
 		col = color_table[(attr >> 8) & 0x0f];
 
 		row = idx / TILE_16x16_PER_LINE;
 		column = idx % TILE_16x16_PER_LINE;
-		for (lines = 0; lines < 16; lines++)
+		offset = (row * 16) * BUF_WIDTH + (column * 16);
+		dst = &tex_spr[0][offset];
+#if USE_PREDECODE_GFX
+		if (spr_decoded)
+		{
+			tile_copy_16(dst, BUF_WIDTH, &spr_decoded[code << 8], col, 16);
+		}
+		else
+#endif
 		{
-			offset = ((row * 16) + lines) * BUF_WIDTH + (column * 16);
-			dst = &tex_spr[0][offset];
-			tile = *(uint32_t *)(src + 0);
-			*(uint32_t *)(dst +  0) = ((tile >> 0) & 0x0f0f0f0f) | col;
-			*(uint32_t *)(dst +  4) = ((tile >> 4) & 0x0f0f0f0f) | col;
-			tile = *(uint32_t *)(src + 4);
-			*(uint32_t *)(dst +  8) = ((tile >> 0) & 0x0f0f0f0f) | col;
-			*(uint32_t *)(dst + 12) = ((tile >> 4) & 0x0f0f0f0f) | col;
-			src += 8;
+			gfx3_offset = read_cache ? read_cache(code << 7) : code << 7;
+			src = &memory_region_gfx3[gfx3_offset];
+			tile_decode_16(dst, BUF_WIDTH, src, col, 16);
 		}
 	}
 
@@ -343,5 +332,5 @@ void blit_draw_spr_line(int x, int y, int zoom_x, int sprite_y, uint32_t code, u
 	if (attr & 0x0002) sprite_y ^= 0x0f;
     gfx3_offset += sprite_y << 3;
 
-	(*drawgfxline[flag])((uint32_t *)&memory_region_gfx3[gfx3_offset], &scrbitmap[dst], &video_palette[(attr >> 8) << 4], zoom_x);
+	(*drawgfxline[flag])((uint32_t *)&memory_region_gfx3[gfx3_offset], &scrbitmap[dst], &BLIT_PALETTE[(attr >> 8) << 4], zoom_x);
 }
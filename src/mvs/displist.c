@@ -0,0 +1,364 @@
+/******************************************************************************
+
+	displist.c
+
+	MVS Display List (render thread)
+
+******************************************************************************/
+
+#include "mvs.h"
+
+#if USE_RENDER_THREAD
+
+#define DISPLIST_INIT_SIZE		0x4000
+#define DISPLIST_PALETTE_SIZE	0x1000
+#define DISPLIST_INIT_PALETTES	4
+
+enum
+{
+	CMD_START = 0,
+	CMD_FINISH,
+	CMD_DRAW_FIX,
+	CMD_FINISH_FIX,
+	CMD_DRAW_SPR,
+	CMD_FINISH_SPR,
+	CMD_DRAW_SPR_LINE,
+	CMD_SET_SPR_CLEAR_FLAG,
+	CMD_SET_FIX_CLEAR_FLAG
+};
+
+typedef struct displist_cmd_t
+{
+	uint8_t  type;
+	uint8_t  opaque;
+	int16_t  x;
+	int16_t  y;
+	uint16_t w;
+	uint16_t h;
+	uint16_t attr;
+	uint32_t code;
+} DISPLIST_CMD;
+
+typedef struct displist_t
+{
+	DISPLIST_CMD *cmd;
+	uint32_t num;
+	uint32_t size;
+
+	uint16_t *palette;
+	uint32_t pal_num;
+	uint32_t pal_size;
+} DISPLIST;
+
+
+/******************************************************************************
+	Global Variables
+******************************************************************************/
+
+uint16_t *displist_palette;
+uint8_t displist_palette_bank;
+uint8_t *displist_fix_memory;
+
+
+/******************************************************************************
+	Local Variables
+******************************************************************************/
+
+static DISPLIST displist[2];
+static int displist_record;
+static volatile int displist_finished;
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Add command to the recording list (NULL if out of memory)
+------------------------------------------------------------------------*/
+
+static DISPLIST_CMD *displist_add(uint8_t type)
+{
+	DISPLIST *list = &displist[displist_record];
+	DISPLIST_CMD *cmd;
+
+	if (list->num == list->size)
+	{
+		uint32_t size = list->size ? list->size << 1 : DISPLIST_INIT_SIZE;
+
+		if ((cmd = realloc(list->cmd, size * sizeof(DISPLIST_CMD))) == NULL)
+			return NULL;
+
+		list->cmd  = cmd;
+		list->size = size;
+	}
+
+	cmd = &list->cmd[list->num++];
+	cmd->type = type;
+
+	return cmd;
+}
+
+
+/*------------------------------------------------------------------------
+	Snapshot active palette bank (reuses the last copy if unchanged)
+------------------------------------------------------------------------*/
+
+static int displist_add_palette(void)
+{
+	DISPLIST *list = &displist[displist_record];
+	uint16_t *pal;
+
+	if (list->pal_num)
+	{
+		pal = &list->palette[(list->pal_num - 1) * DISPLIST_PALETTE_SIZE];
+
+		if (memcmp(pal, video_palette, DISPLIST_PALETTE_SIZE * sizeof(uint16_t)) == 0)
+			return list->pal_num - 1;
+	}
+
+	if (list->pal_num == list->pal_size)
+	{
+		uint32_t size = list->pal_size ? list->pal_size << 1 : DISPLIST_INIT_PALETTES;
+
+		if ((pal = realloc(list->palette, size * DISPLIST_PALETTE_SIZE * sizeof(uint16_t))) == NULL)
+			return -1;
+
+		list->palette  = pal;
+		list->pal_size = size;
+	}
+
+	pal = &list->palette[list->pal_num * DISPLIST_PALETTE_SIZE];
+	memcpy(pal, video_palette, DISPLIST_PALETTE_SIZE * sizeof(uint16_t));
+
+	return list->pal_num++;
+}
+
+
+/******************************************************************************
+	Display list control
+******************************************************************************/
+
+/*------------------------------------------------------------------------
+	Discard recorded commands
+------------------------------------------------------------------------*/
+
+void displist_reset(void)
+{
+	displist_finished = 0;
+	displist[displist_record].num = 0;
+	displist[displist_record].pal_num = 0;
+}
+
+
+/*------------------------------------------------------------------------
+	Free display lists
+------------------------------------------------------------------------*/
+
+void displist_exit(void)
+{
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		free(displist[i].cmd);
+		free(displist[i].palette);
+		memset(&displist[i], 0, sizeof(DISPLIST));
+	}
+	displist_palette = NULL;
+	displist_fix_memory = NULL;
+}
+
+
+/*------------------------------------------------------------------------
+	Hand the recorded frame over to the render thread
+	(the previous frame must have been finished with displist_sync)
+------------------------------------------------------------------------*/
+
+void displist_submit(void)
+{
+	if (!render_thread_active || !displist[displist_record].num)
+		return;
+
+	displist_record ^= 1;
+	displist_reset();
+
+	render_thread_submit();
+}
+
+
+/*------------------------------------------------------------------------
+	Wait for the render thread and transfer the finished frame
+------------------------------------------------------------------------*/
+
+void displist_sync(void)
+{
+	render_thread_sync();
+
+	if (displist_finished)
+	{
+		displist_finished = 0;
+		blit_finish();
+	}
+}
+
+
+/*------------------------------------------------------------------------
+	Replay display list (render thread)
+------------------------------------------------------------------------*/
+
+void displist_execute(void)
+{
+	DISPLIST *list = &displist[displist_record ^ 1];
+	DISPLIST_CMD *cmd = list->cmd;
+	DISPLIST_CMD *end = cmd + list->num;
+
+	for (; cmd < end; cmd++)
+	{
+		switch (cmd->type)
+		{
+		case CMD_START:
+			displist_palette = &list->palette[cmd->code * DISPLIST_PALETTE_SIZE];
+			displist_palette_bank = cmd->attr;
+			blit_start(cmd->x, cmd->y);
+			break;
+
+		case CMD_FINISH:
+			displist_finished = 1;
+			break;
+
+		case CMD_DRAW_FIX:
+			displist_fix_memory = cmd->opaque ? memory_region_gfx2 : memory_region_gfx1;
+			blit_draw_fix(cmd->x, cmd->y, cmd->code, cmd->attr);
+			break;
+
+		case CMD_FINISH_FIX:
+			blit_finish_fix();
+			break;
+
+		case CMD_DRAW_SPR:
+			blit_draw_spr(cmd->x, cmd->y, cmd->w, cmd->h, cmd->code, cmd->attr);
+			break;
+
+		case CMD_FINISH_SPR:
+			blit_finish_spr();
+			break;
+
+		case CMD_DRAW_SPR_LINE:
+			blit_draw_spr_line(cmd->x, cmd->y, cmd->w, cmd->h, cmd->code, cmd->attr, cmd->opaque);
+			break;
+
+		case CMD_SET_SPR_CLEAR_FLAG:
+			blit_set_spr_clear_flag();
+			break;
+
+		case CMD_SET_FIX_CLEAR_FLAG:
+			blit_set_fix_clear_flag();
+			break;
+		}
+	}
+
+	list->num = 0;
+	list->pal_num = 0;
+}
+
+
+/******************************************************************************
+	Recording functions (same arguments as blit_xxx)
+******************************************************************************/
+
+void displist_set_spr_clear_flag(void)
+{
+	displist_add(CMD_SET_SPR_CLEAR_FLAG);
+}
+
+
+void displist_set_fix_clear_flag(void)
+{
+	displist_add(CMD_SET_FIX_CLEAR_FLAG);
+}
+
+
+void displist_start(int start, int end)
+{
+	DISPLIST_CMD *cmd;
+	int pal;
+
+	if ((pal = displist_add_palette()) < 0) return;
+
+	if ((cmd = displist_add(CMD_START)) != NULL)
+	{
+		cmd->x    = start;
+		cmd->y    = end;
+		cmd->code = pal;
+		cmd->attr = palette_bank;
+	}
+}
+
+
+void displist_finish(void)
+{
+	displist_add(CMD_FINISH);
+}
+
+
+void displist_draw_fix(int x, int y, uint32_t code, uint16_t attr)
+{
+	DISPLIST_CMD *cmd;
+
+	if ((cmd = displist_add(CMD_DRAW_FIX)) != NULL)
+	{
+		cmd->x      = x;
+		cmd->y      = y;
+		cmd->code   = code;
+		cmd->attr   = attr;
+		cmd->opaque = fix_bank;
+	}
+}
+
+
+void displist_finish_fix(void)
+{
+	displist_add(CMD_FINISH_FIX);
+}
+
+
+void displist_draw_spr(int x, int y, int w, int h, uint32_t code, uint16_t attr)
+{
+	DISPLIST_CMD *cmd;
+
+	if ((cmd = displist_add(CMD_DRAW_SPR)) != NULL)
+	{
+		cmd->x    = x;
+		cmd->y    = y;
+		cmd->w    = w;
+		cmd->h    = h;
+		cmd->code = code;
+		cmd->attr = attr;
+	}
+}
+
+
+void displist_finish_spr(void)
+{
+	displist_add(CMD_FINISH_SPR);
+}
+
+
+void displist_draw_spr_line(int x, int y, int zoom_x, int sprite_y, uint32_t code, uint16_t attr, uint8_t opaque)
+{
+	DISPLIST_CMD *cmd;
+
+	if ((cmd = displist_add(CMD_DRAW_SPR_LINE)) != NULL)
+	{
+		cmd->x      = x;
+		cmd->y      = y;
+		cmd->w      = zoom_x;
+		cmd->h      = sprite_y;
+		cmd->code   = code;
+		cmd->attr   = attr;
+		cmd->opaque = opaque;
+	}
+}
+
+#endif /* USE_RENDER_THREAD */
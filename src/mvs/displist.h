@@ -0,0 +1,68 @@
+/******************************************************************************
+
+	displist.h
+
+	MVS Display List (render thread)
+
+******************************************************************************/
+
+#ifndef MVS_DISPLIST_H
+#define MVS_DISPLIST_H
+
+/*
+	With the render thread running, the video emulation does not draw:
+	blit_xxx() calls are recorded into a display list together with a
+	copy of the palette bank used by each band (and its number), and replayed on the
+	render thread while the next frame is emulated. FIX commands record
+	the fix bank, and the ROM it selects is looked up when they are
+	replayed, as the emulation may switch it for the next frame.
+
+	Call sites go through BLIT(func)(...), which records when the render
+	thread is active and draws immediately otherwise.
+
+	blit_finish() hands the frame to the video driver, which is not thread
+	safe, so it is not replayed: displist_sync() waits for the render
+	thread and then calls it on the emulation thread.
+*/
+
+#if USE_RENDER_THREAD
+
+extern uint16_t *displist_palette;
+extern uint8_t displist_palette_bank;
+extern uint8_t *displist_fix_memory;
+
+void displist_reset(void);
+void displist_exit(void);
+void displist_submit(void);
+void displist_sync(void);
+void displist_execute(void);
+
+void displist_set_spr_clear_flag(void);
+void displist_set_fix_clear_flag(void);
+
+void displist_start(int start, int end);
+void displist_finish(void);
+
+void displist_draw_fix(int x, int y, uint32_t code, uint16_t attr);
+void displist_finish_fix(void);
+
+void displist_draw_spr(int x, int y, int w, int h, uint32_t code, uint16_t attr);
+void displist_finish_spr(void);
+
+void displist_draw_spr_line(int x, int y, int zoom_x, int sprite_y, uint32_t code, uint16_t attr, uint8_t opaque);
+
+#define BLIT(func)		(render_thread_active ? displist_##func : blit_##func)
+#define BLIT_PALETTE	(render_thread_active ? displist_palette : video_palette)
+#define BLIT_PALETTE_BANK	(render_thread_active ? displist_palette_bank : palette_bank)
+#define BLIT_FIX_MEMORY	(render_thread_active ? displist_fix_memory : fix_memory)
+
+#else
+
+#define BLIT(func)		blit_##func
+#define BLIT_PALETTE	video_palette
+#define BLIT_PALETTE_BANK	palette_bank
+#define BLIT_FIX_MEMORY	fix_memory
+
+#endif
+
+#endif /* MVS_DISPLIST_H */
@@ -519,8 +519,8 @@ static inline void set_main_cpu_vector_table_source(uint8_t data)
 	memcpy(memory_region_cpu1, neogeo_vectors[data], 0x80);
 	main_cpu_vector_table_source = data;
 	display_position_interrupt_counter = 0;
-	blit_set_fix_clear_flag();
-	blit_set_spr_clear_flag();
+	BLIT(set_fix_clear_flag)();
+	BLIT(set_spr_clear_flag)();
 	autoframeskip_reset();
 
 	// hack for PSP
@@ -553,6 +553,7 @@ static inline void neogeo_set_palette_bank(uint8_t data)
 		palette_bank = data;
 
 		video_palette = video_palettebank[data];
+		video_dirty |= VIDEO_DIRTY_PALETTE;
 	}
 }
 
@@ -586,7 +587,26 @@ static inline uint16_t get_videoram_data(void)
 
 static inline void set_videoram_data(uint16_t data)
 {
-	neogeo_videoram[videoram_offset] = data;
+#if USE_RASTER_LOG
+	if (raster_log_active && (videoram_offset < NEOGEO_VRAM_FIX || (videoram_offset >= NEOGEO_VRAM_SCB2 && videoram_offset < NEOGEO_VRAM_SPRLIST)))
+		neogeo_raster_log_write(&neogeo_videoram[videoram_offset]);
+#endif
+
+	if (neogeo_videoram[videoram_offset] != data)
+	{
+		if (videoram_offset < NEOGEO_VRAM_FIX)
+			video_dirty |= VIDEO_DIRTY_SPR;
+		else if (videoram_offset < NEOGEO_VRAM_SCB2)
+			video_dirty |= VIDEO_DIRTY_FIX;
+		else if (videoram_offset < NEOGEO_VRAM_SPRLIST)
+		{
+			/* SCB2-SCB4 changes the sprite chains */
+			video_dirty |= VIDEO_DIRTY_SPR;
+			sprite_chain_dirty = 1;
+		}
+
+		neogeo_videoram[videoram_offset] = data;
+	}
 
 	/* auto increment/decrement the current offset - A15 is NOT effected */
 	videoram_offset = (videoram_offset & 0x8000) | ((videoram_offset + videoram_modulo) & 0x7fff);
@@ -945,7 +965,17 @@ WRITE16_HANDLER( neogeo_paletteram_w )
 	color = COMBINE_DATA(&palettes[palette_bank][offset]);
 
 	if (offset & 0x0f)
-		video_palette[offset] = video_clut16[color & 0x7fff];
+	{
+#if USE_RASTER_LOG
+		if (raster_log_active)
+			neogeo_raster_log_write(&video_palette[offset]);
+#endif
+		if (video_palette[offset] != video_clut16[color & 0x7fff])
+		{
+			video_palette[offset] = video_clut16[color & 0x7fff];
+			video_dirty |= VIDEO_DIRTY_PALETTE;
+		}
+	}
 }
 
 
@@ -1718,10 +1748,16 @@ WRITE16_HANDLER( kof10th_protection_w )
 			uint8_t *srom2 = memory_region_gfx2;
 			uint32_t tile = offset & ~31;
 
+#if USE_RENDER_THREAD
+			// the previous frame may still be decoding fix tiles from the S-ROM
+			render_thread_sync();
+#endif
+
 			srom1[offset] = BITSWAP8(data,7,6,0,4,3,2,1,5);
 			memcpy(&srom2[tile], &srom1[tile], 32);
 			neogeo_decode_fix(&srom2[tile], 32, &gfx_pen_usage[1][tile >> 5]);
-			blit_set_fix_clear_flag();
+			BLIT(set_fix_clear_flag)();
+			video_dirty |= VIDEO_DIRTY_FIX_GFX;
 		}
 	}
 	else
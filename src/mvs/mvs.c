@@ -127,6 +127,11 @@ static int neogeo_init(void)
 
 static void neogeo_reset(void)
 {
+#if USE_RENDER_THREAD
+	displist_sync();
+	displist_reset();
+#endif
+
 	video_driver->clearScreen(video_data);
 
 	timer_reset();
@@ -161,6 +166,8 @@ static void neogeo_exit(void)
 
 	msg_printf(TEXT(PLEASE_WAIT2));
 
+	neogeo_video_exit();
+
 #ifdef ADHOC
 	if (!adhoc_enable)
 #endif
@@ -244,6 +251,10 @@ static void apply_cheat()
 
 static void neogeo_run(void)
 {
+#if USE_RENDER_THREAD
+	render_thread_start(displist_execute);
+#endif
+
 	while (Loop >= LOOP_RESET)
 	{
 		neogeo_reset();
@@ -252,6 +263,9 @@ static void neogeo_run(void)
 		{
 			if (Sleep)
 			{
+#if USE_RENDER_THREAD
+				displist_sync();
+#endif
 				cache_sleep(1);
 
 				do
@@ -266,13 +280,28 @@ static void neogeo_run(void)
 			apply_cheat();//davex
 			
 			timer_update_cpu();
+			sound_queue_frame();
+#if USE_RENDER_THREAD
+			displist_sync();
+#endif
 			update_screen();
 			update_inputport();
+#if USE_RENDER_THREAD
+			displist_submit();
+#endif
 		}
 
+#if USE_RENDER_THREAD
+		displist_sync();
+#endif
 		video_driver->clearScreen(video_data);
 		sound_mute(1);
 	}
+
+#if USE_RENDER_THREAD
+	render_thread_stop();
+	displist_exit();
+#endif
 }
 
 
@@ -20,6 +20,7 @@
 #include "timer.h"
 #include "vidhrdw.h"
 #include "sprite.h"
+#include "displist.h"
 #include "driver.h"
 #include "pd4990a.h"
 #include "biosmenu.h"
@@ -92,17 +92,12 @@ void blit_set_spr_clear_flag(void)
 
 void blit_reset(void)
 {
-	int i;
-
 	scrbitmap  = (uint16_t *)video_driver->workFrame(video_data, SCRBITMAP);
 	tex_spr[0] = video_driver->workFrame(video_data, TEX_SPR0);
 	tex_spr[1] = video_driver->workFrame(video_data, TEX_SPR1);
 	tex_spr[2] = video_driver->workFrame(video_data, TEX_SPR2);
 	tex_fix    = video_driver->workFrame(video_data, TEX_FIX);
 
-	for (i = 0; i < FIX_TEXTURE_SIZE; i++) fix_data[i].index = i;
-	for (i = 0; i < SPR_TEXTURE_SIZE; i++) spr_data[i].index = i;
-
 	clip_min_y = FIRST_VISIBLE_LINE;
 	clip_max_y = LAST_VISIBLE_LINE;
 
@@ -166,7 +161,7 @@ void blit_draw_fix(int x, int y, uint32_t code, uint16_t attr)
 		uint32_t col, tile;
 		uint8_t *src, *dst, lines = 8;
 
-		if (fix_texture_num == FIX_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&fix_cache))
 			fix_delete_sprite();
 
 		idx = fix_insert_sprite(key);
@@ -234,11 +229,11 @@ void blit_draw_spr(int x, int y, int w, int h, uint32_t code, uint16_t attr)
 		uint32_t col, tile, gfx3_offset;
 		uint8_t *src, *dst, lines = 16;
 
-		if (spr_texture_num == SPR_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&spr_cache))
 		{
 			spr_delete_sprite();
 
-			if (spr_texture_num == SPR_TEXTURE_SIZE - 1)
+			if (tile_cache_full(&spr_cache))
 			{
 				spr_disable = 1;
 				return;
@@ -12,17 +12,13 @@
 	Shared variable definitions
 ******************************************************************************/
 
-SPRITE ALIGN_DATA *fix_head[FIX_HASH_SIZE];
-SPRITE ALIGN_DATA fix_data[FIX_TEXTURE_SIZE];
-SPRITE *fix_free_head;
+TILE_CACHE_STORAGE(fix, FIX_TEXTURE_SIZE, FIX_HASH_SIZE);
+TILE_CACHE fix_cache = TILE_CACHE_INIT(fix, FIX_TEXTURE_SIZE, FIX_HASH_SIZE);
 uint16_t fix_num;
-uint16_t fix_texture_num;
 
-SPRITE ALIGN_DATA *spr_head[SPR_HASH_SIZE];
-SPRITE ALIGN_DATA spr_data[SPR_TEXTURE_SIZE];
-SPRITE *spr_free_head;
+TILE_CACHE_STORAGE(spr, SPR_TEXTURE_SIZE, SPR_HASH_SIZE);
+TILE_CACHE spr_cache = TILE_CACHE_INIT(spr, SPR_TEXTURE_SIZE, SPR_HASH_SIZE);
 uint16_t spr_num;
-uint16_t spr_texture_num;
 uint16_t spr_index;
 uint8_t spr_disable;
 
@@ -116,18 +112,7 @@ void ALIGN_DATA (*drawgfxline[8])(uint32_t *src, uint16_t *dst, uint16_t *pal, i
 
 int fix_get_sprite(uint32_t key)
 {
-	SPRITE *p = fix_head[key & FIX_HASH_MASK];
-
-	while (p)
-	{
-		if (p->key == key)
-		{
-			p->used = frames_displayed;
-			return p->index;
-	 	}
-		p = p->next;
-	}
-	return -1;
+	return tile_cache_get(&fix_cache, key);
 }
 
 
@@ -137,31 +122,7 @@ int fix_get_sprite(uint32_t key)
 
 int fix_insert_sprite(uint32_t key)
 {
-	uint16_t hash = key & FIX_HASH_MASK;
-	SPRITE *p = fix_head[hash];
-	SPRITE *q = fix_free_head;
-
-	if (!q) return -1;
-
-	fix_free_head = fix_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
-
-	if (!p)
-	{
-		fix_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
-
-	fix_texture_num++;
-
-	return q->index;
+	return tile_cache_insert(&fix_cache, key);
 }
 
 
@@ -171,42 +132,7 @@ int fix_insert_sprite(uint32_t key)
 
 void fix_delete_sprite(void)
 {
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < FIX_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = fix_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				fix_texture_num--;
-
-				if (!prev_p)
-				{
-					fix_head[i] = p->next;
-					p->next = fix_free_head;
-					fix_free_head = p;
-					p = fix_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = fix_free_head;
-					fix_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
+	tile_cache_evict(&fix_cache);
 }
 
 
@@ -220,22 +146,13 @@ void fix_delete_sprite(void)
 
 int spr_get_sprite(uint32_t key)
 {
-	SPRITE *p = spr_head[key & SPR_HASH_MASK];
+	int idx = tile_cache_lookup(&spr_cache, key);
 
-	while (p)
+	if (idx >= 0 && tile_cache_touch(&spr_cache, idx))
 	{
-		if (p->key == key)
-		{
-			if (p->used != frames_displayed)
-			{
-				if (update_cache) update_cache(key << 7);
-				p->used = frames_displayed;
-			}
-			return p->index;
-		}
-		p = p->next;
+		if (update_cache) update_cache(key << 7);
 	}
-	return -1;
+	return idx;
 }
 
 
@@ -245,31 +162,7 @@ int spr_get_sprite(uint32_t key)
 
 int spr_insert_sprite(uint32_t key)
 {
-	uint16_t hash = key & SPR_HASH_MASK;
-	SPRITE *p = spr_head[hash];
-	SPRITE *q = spr_free_head;
-
-	if (!q) return -1;
-
-	spr_free_head = spr_free_head->next;
-
-	q->next = NULL;
-	q->key  = key;
-	q->used = frames_displayed;
-
-	if (!p)
-	{
-		spr_head[hash] = q;
-	}
-	else
-	{
-		while (p->next) p = p->next;
-		p->next = q;
-	}
-
-	spr_texture_num++;
-
-	return q->index;
+	return tile_cache_insert(&spr_cache, key);
 }
 
 
@@ -279,42 +172,7 @@ int spr_insert_sprite(uint32_t key)
 
 void spr_delete_sprite(void)
 {
-	int i;
-	SPRITE *p, *prev_p;
-
-	for (i = 0; i < SPR_HASH_SIZE; i++)
-	{
-		prev_p = NULL;
-		p = spr_head[i];
-
-		while (p)
-		{
-			if (frames_displayed != p->used)
-			{
-				spr_texture_num--;
-
-				if (!prev_p)
-				{
-					spr_head[i] = p->next;
-					p->next = spr_free_head;
-					spr_free_head = p;
-					p = spr_head[i];
-				}
-				else
-				{
-					prev_p->next = p->next;
-					p->next = spr_free_head;
-					spr_free_head = p;
-					p = prev_p->next;
-				}
-			}
-			else
-			{
-				prev_p = p;
-				p = p->next;
-			}
-		}
-	}
+	tile_cache_evict(&spr_cache);
 }
 
 
@@ -328,17 +186,7 @@ void spr_delete_sprite(void)
 
 void blit_clear_fix_sprite(void)
 {
-	int i;
-
-	for (i = 0; i < FIX_TEXTURE_SIZE - 1; i++)
-		fix_data[i].next = &fix_data[i + 1];
-
-	fix_data[i].next = NULL;
-	fix_free_head = &fix_data[0];
-
-	memset(fix_head, 0, sizeof(SPRITE *) * FIX_HASH_SIZE);
-
-	fix_texture_num = 0;
+	tile_cache_clear(&fix_cache);
 	clear_fix_texture = 0;
 }
 
@@ -349,17 +197,7 @@ void blit_clear_fix_sprite(void)
 
 void blit_clear_spr_sprite(void)
 {
-	int i;
-
-	for (i = 0; i < SPR_TEXTURE_SIZE - 1; i++)
-		spr_data[i].next = &spr_data[i + 1];
-
-	spr_data[i].next = NULL;
-	spr_free_head = &spr_data[0];
-
-	memset(spr_head, 0, sizeof(SPRITE *) * SPR_HASH_SIZE);
-
-	spr_texture_num = 0;
+	tile_cache_clear(&spr_cache);
 	clear_spr_texture = 0;
 }
 
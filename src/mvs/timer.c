@@ -255,6 +255,24 @@ float timer_get_time(void)
 }
 
 
+/*------------------------------------------------------
+	Get position in current frame (unit: 1/65536 frame)
+------------------------------------------------------*/
+
+int timer_get_frame_offset(void)
+{
+	int time = frame_base;
+	int offset;
+
+	if (active_cpu != CPU_NOTACTIVE)
+		time += cpu_elapsed_time(active_cpu);
+
+	offset = (time << 16) / (int)TICKS_PER_FRAME;
+
+	return (offset > 0xffff) ? 0xffff : offset;
+}
+
+
 /*------------------------------------------------------
 	Get current scanline
 ------------------------------------------------------*/
@@ -41,6 +41,7 @@ int timer_enable(int which, int enable);
 void timer_adjust(int which, int duration, int param, void (*callback)(int raram));
 void timer_set(int which, int duration, int param, void (*callback)(int param));
 float timer_get_time(void);
+int timer_get_frame_offset(void);
 int timer_getscanline(void);
 
 extern void (*timer_update_cpu)(void);
@@ -46,6 +46,16 @@ uint8_t *fix_memory;
 int neogeo_fix_bank_type;
 
 uint16_t max_sprite_number;
+int sprite_chain_dirty;
+int video_dirty;
+
+#if USE_PREDECODE_GFX
+uint8_t *spr_decoded;
+#endif
+
+#if USE_RASTER_LOG
+int raster_log_active;
+#endif
 
 
 /******************************************************************************
@@ -58,6 +68,15 @@ static int next_update_first_line;
 
 static uint8_t *spr_pen_usage;
 
+/*
+ * The composed frame stays in the work frame, so it is shown again as is
+ * when nothing it was drawn from changed (video_dirty is set by VRAM,
+ * palette and fix bank writes).
+ */
+static int last_frame_valid;
+static uint8_t last_auto_animation_counter;
+static uint8_t last_auto_animation_disabled;
+
 /*
  * Sprite Control Block pointers (reference: VRAM layout in memory_sizes.h)
  * SCB2: Shrink coefficients - lower byte = vertical ($FF=full), upper nibble = horizontal ($F=full)
@@ -73,8 +92,72 @@ static const uint8_t *skip_fullmode1;
 static const uint8_t *tile_fullmode0;
 static const uint8_t *tile_fullmode1;
 
-static void (*draw_fixed_layer_func[2])(void);
-static void (*draw_fixed_layer)(void);
+#if USE_RASTER_LOG
+/*
+ * Raster log: partial screen updates only record a band boundary. Sprite
+ * VRAM and palette writes made after that are logged with the value they
+ * replaced, and the bands are drawn in one pass at the end of the frame.
+ */
+#define RASTER_LOG_SIZE		0x4000
+#define RASTER_MAX_BANDS	(LAST_VISIBLE_LINE - FIRST_VISIBLE_LINE + 1)
+
+typedef struct
+{
+	uint16_t *addr;
+	uint16_t data;
+} RASTER_WRITE;
+
+typedef struct
+{
+	int16_t  first_line;
+	int16_t  last_line;
+	uint16_t log_end;		/* writes made before this band's boundary */
+	uint8_t  palette_bank;
+	uint8_t  auto_animation_counter;
+} RASTER_BAND;
+
+static RASTER_WRITE raster_log[RASTER_LOG_SIZE];
+static RASTER_BAND raster_band[RASTER_MAX_BANDS];
+static int raster_log_num;
+static int raster_band_num;
+#endif
+
+/*
+ * Fix layer cells: the resolved tile of each cell is kept, and cells are
+ * only resolved again when the fix map changed (VIDEO_DIRTY_FIX). Cells
+ * with visible pixels are kept in a list that is submitted every frame.
+ * Fix tiles are drawn through the palette, so palette writes do not
+ * change the list.
+ *
+ * The list depends on fix_usage, so anything that rewrites the fix
+ * graphics or their pen usage (bank switch, kof10th S-ROM writes) must
+ * set VIDEO_DIRTY_FIX_GFX, or a tile that became visible is never drawn.
+ */
+#define FIX_COLUMNS		((312 - 8) / 8)
+#define FIX_ROWS		((240 - 16) / 8)
+#define FIX_CELLS		(FIX_COLUMNS * FIX_ROWS)
+
+typedef struct
+{
+	uint16_t code;
+	uint16_t attr;
+} FIX_CELL;
+
+typedef struct
+{
+	int16_t  x;
+	int16_t  y;
+	uint16_t code;
+	uint16_t attr;
+} FIX_TILE;
+
+static FIX_CELL fix_cell[FIX_CELLS];
+static FIX_TILE fix_tile[FIX_CELLS];
+static int fix_tile_num;
+static int fix_cell_changed;
+
+static void (*update_fixed_layer_func[2])(void);
+static void (*update_fixed_layer)(void);
 
 
 /******************************************************************************
@@ -90,8 +173,20 @@ static void (*draw_fixed_layer)(void);
 	VRAM layout: $7000-$74FF, each word = palette (4 bits) + tile number (12 bits)
 ------------------------------------------------------*/
 
-static void draw_fixed_layer_type0(void)
+static inline void update_fix_cell(FIX_CELL *cell, uint16_t code, uint16_t attr)
+{
+	if (cell->code != code || cell->attr != attr)
+	{
+		cell->code = code;
+		cell->attr = attr;
+		fix_cell_changed = 1;
+	}
+}
+
+
+static void update_fixed_layer_type0(void)
 {
+	FIX_CELL *cell = fix_cell;
 	uint16_t x, y, code, attr;
 
 	for (x = 8/8; x < 312/8; x++)
@@ -104,17 +199,15 @@ static void draw_fixed_layer_type0(void)
 			attr = code >> 12;
 			code &= 0x0fff;
 
-			if (fix_usage[code])
-				blit_draw_fix((x << 3) + 16, y << 3, code, attr);
+			update_fix_cell(cell++, code, attr);
 		}
 	}
-
-	blit_finish_fix();
 }
 
 
-static void draw_fixed_layer_type1(void)
+static void update_fixed_layer_type1(void)
 {
+	FIX_CELL *cell = fix_cell;
 	uint16_t x, y, code, attr;
 	int garouoffsets[32];
 	int garoubank = 0;
@@ -145,17 +238,15 @@ static void draw_fixed_layer_type1(void)
 
 			code += (garouoffsets[(y - 2) & 31] ^ 3) << 12;
 
-			if (fix_usage[code])
-				blit_draw_fix((x << 3) + 16, y << 3, code, attr);
+			update_fix_cell(cell++, code, attr);
 		}
 	}
-
-	blit_finish_fix();
 }
 
 
-static void draw_fixed_layer_type2(void)
+static void update_fixed_layer_type2(void)
 {
+	FIX_CELL *cell = fix_cell;
 	uint16_t x, y, code, attr;
 
 	for (x = 8/8; x < 312/8; x++)
@@ -171,12 +262,57 @@ static void draw_fixed_layer_type2(void)
 			/* KOF2000+ style fix bankswitching via extension area */
 			code += (((neogeo_videoram[NEOGEO_VRAM_EXT + ((y - 1) & 31) + ((x / 6) << 5)] >> (5 - (x % 6)) * 2) & 3) ^ 3) << 12;
 
-			if (fix_usage[code])
-				blit_draw_fix((x << 3) + 16, y << 3, code, attr);
+			update_fix_cell(cell++, code, attr);
+		}
+	}
+}
+
+
+static void draw_fixed_layer(void)
+{
+	FIX_TILE *tile, *end;
+
+	if (video_dirty & VIDEO_DIRTY_FIX_GFX)
+	{
+		/* fix_usage changed: resolve all cells again */
+		memset(fix_cell, 0xff, sizeof(fix_cell));
+	}
+
+	if (video_dirty & (VIDEO_DIRTY_FIX | VIDEO_DIRTY_FIX_GFX))
+	{
+		update_fixed_layer();
+
+		if (fix_cell_changed)
+		{
+			FIX_CELL *cell = fix_cell;
+			uint16_t x, y;
+
+			fix_cell_changed = 0;
+			fix_tile_num = 0;
+
+			for (x = 8/8; x < 312/8; x++)
+			{
+				for (y = 16/8; y < 240/8; y++, cell++)
+				{
+					if (fix_usage[cell->code])
+					{
+						tile = &fix_tile[fix_tile_num++];
+						tile->x    = (x << 3) + 16;
+						tile->y    = y << 3;
+						tile->code = cell->code;
+						tile->attr = cell->attr;
+					}
+				}
+			}
 		}
 	}
 
-	blit_finish_fix();
+	end = fix_tile + fix_tile_num;
+
+	for (tile = fix_tile; tile < end; tile++)
+		BLIT(draw_fix)(tile->x, tile->y, tile->code, tile->attr);
+
+	BLIT(finish_fix)();
 }
 
 
@@ -202,148 +338,198 @@ typedef struct
 	uint16_t *base;			/* Pointer to sprite's SCB1 data */
 } SPRITE_LIST;
 
-static SPRITE_LIST sprite_list[MAX_SPRITES_PER_LINE];
 
 /*
- * Hardware-accelerated sprite rendering
- * Used for full-screen updates (>15 lines changed)
+ * Sprite chains: a chain is a sprite and the sticky sprites following it.
+ * The list only depends on SCB2-SCB4, so it is rebuilt lazily when those
+ * are written (sprite_chain_dirty) and shared by all bands of a frame
+ * and by both renderers.
  */
-static void draw_sprites_hardware(int min_y, int max_y)
+typedef struct
 {
-	int y = 0;
-	int x = 0;
-	int rows = 0;
-	int zoom_y = 0;
-	int zoom_x = 0;
+	int16_t  y;
+	uint16_t rows;
+	uint16_t zoom_y;
+	uint8_t  fullmode;
+	uint16_t first;			/* first sprite in chain_sprite_list */
+	uint16_t num;
+} SPRITE_CHAIN;
+
+static SPRITE_LIST chain_sprite_list[MAX_SPRITES_PER_SCREEN];
+static SPRITE_CHAIN sprite_chain[MAX_SPRITES_PER_SCREEN];
+static int num_sprite_chains;
+static uint16_t sprite_chain_max;
+
+
+/*------------------------------------------------------
+	Rebuild sprite chain list if SCB2-SCB4 changed
+------------------------------------------------------*/
+
+static void update_sprite_chains(void)
+{
+	SPRITE_CHAIN *chain = NULL;
+	uint16_t sprite_number;
+
+	if (!sprite_chain_dirty && sprite_chain_max == max_sprite_number)
+		return;
 
-	uint16_t sprite_number = 0;
 	uint16_t num_sprites = 0;
-	uint16_t fullmode = 0;
-	uint16_t attr;
-	uint32_t code;
+	int x = 0;
+	int zoom_x = 0;
+	int rows = 0;
 
-	const uint8_t *skip = NULL;
-	const uint8_t *tile = NULL;
+	num_sprite_chains = 0;
+	sprite_chain_max = max_sprite_number;
+	sprite_chain_dirty = 0;
 
-	do
+	for (sprite_number = 0; sprite_number < max_sprite_number; sprite_number++)
 	{
-		for (;sprite_number < max_sprite_number; sprite_number++)
+		uint16_t y_control = sprite_y_control[sprite_number];
+		uint16_t zoom_control = sprite_zoom_control[sprite_number];
+
+		if (y_control & 0x40)
 		{
-			uint16_t y_control = sprite_y_control[sprite_number];
-			uint16_t zoom_control = sprite_zoom_control[sprite_number];
+			if (rows == 0) continue;
 
-			if (y_control & 0x40)
-			{
-				if (rows == 0) continue;
+			x += zoom_x + 1;
+		}
+		else
+		{
+			if ((rows = y_control & 0x3f) == 0) continue;
+
+			chain = &sprite_chain[num_sprite_chains++];
+			chain->y = 0x200 - (y_control >> 7);
+			chain->zoom_y = zoom_control & 0xff;
+			chain->first = num_sprites;
+			chain->num = 0;
 
-				x += zoom_x + 1;
+			x = (sprite_x_control[sprite_number] >> 7) + 16;
+
+			if (rows > 0x20)
+			{
+				chain->rows = 0x200;
+				chain->fullmode = 1;
 			}
 			else
 			{
-				if (num_sprites != 0) break;
+				chain->rows = rows << 4;
+				chain->fullmode = 0;
+			}
+		}
 
-				if ((rows = y_control & 0x3f) == 0) continue;
+		x &= 0x1ff;
 
-				y = 0x200 - (y_control >> 7);
-				x = (sprite_x_control[sprite_number] >> 7) + 16;
-				zoom_y = (zoom_control & 0xff) << 6;
+		zoom_x = (zoom_control >> 8) & 0x0f;
 
-				if (rows > 0x20)
-				{
-					rows = 0x200;
-					fullmode = 1;
-					skip = &skip_fullmode1[zoom_y];
-					tile = &tile_fullmode1[zoom_y];
-				}
-				else
-				{
-					rows <<= 4;
-					fullmode = 0;
-					skip = &skip_fullmode0[zoom_y];
-					tile = &tile_fullmode0[zoom_y];
-				}
-			}
+		if ((x + zoom_x >= 24) && (x < 336))
+		{
+			chain_sprite_list[num_sprites].x = x;
+			chain_sprite_list[num_sprites].zoom_x = zoom_x + 1;
+			chain_sprite_list[num_sprites].base = &neogeo_videoram[sprite_number << 6];
+			num_sprites++;
+			chain->num++;
+		}
+	}
+}
 
-			x &= 0x1ff;
 
-			zoom_x = (zoom_control >> 8) & 0x0f;
+/*
+ * Hardware-accelerated sprite rendering
+ * Used for full-screen updates (>15 lines changed)
+ */
+static void draw_sprites_hardware(int min_y, int max_y)
+{
+	SPRITE_CHAIN *chain = sprite_chain;
+	SPRITE_CHAIN *chain_end;
+	uint16_t attr;
+	uint32_t code;
+	int x;
+
+	update_sprite_chains();
+	chain_end = sprite_chain + num_sprite_chains;
 
-			if ((x + zoom_x >= 24) && (x < 336))
-			{
-				sprite_list[num_sprites].x = x;
-				sprite_list[num_sprites].zoom_x = zoom_x + 1;
-				sprite_list[num_sprites].base = &neogeo_videoram[sprite_number << 6];
-				num_sprites++;
-			}
+	for (; chain < chain_end; chain++)
+	{
+		int y = chain->y;
+		int rows = chain->rows;
+		int zoom_y = chain->zoom_y << 6;
+		uint16_t fullmode = chain->fullmode;
+		uint16_t sprite_line = 0;
+		uint16_t invert = 0;
+		uint16_t sy, yskip;
+		const uint8_t *skip;
+		const uint8_t *tile;
+
+		if (!chain->num) continue;
+
+		if (fullmode)
+		{
+			skip = &skip_fullmode1[zoom_y];
+			tile = &tile_fullmode1[zoom_y];
+		}
+		else
+		{
+			skip = &skip_fullmode0[zoom_y];
+			tile = &tile_fullmode0[zoom_y];
 		}
 
-		if (num_sprites)
+		while (sprite_line < rows)
 		{
-			uint16_t sprite_line = 0;
-			uint16_t invert = 0;
-			uint16_t sy, yskip;
+			sy = (y + sprite_line) & 0x1ff;
+			yskip = *skip;
 
-			while (sprite_line < rows)
+			if (fullmode)
 			{
-				sy = (y + sprite_line) & 0x1ff;
-				yskip = *skip;
-
-				if (fullmode)
+				if (yskip == 0)
 				{
-					if (yskip == 0)
-					{
-						skip = &skip_fullmode1[zoom_y];
-						tile = &tile_fullmode1[zoom_y];
-						yskip = *skip;
-					}
+					skip = &skip_fullmode1[zoom_y];
+					tile = &tile_fullmode1[zoom_y];
+					yskip = *skip;
 				}
-				else if (yskip > 0x10)
-				{
-					yskip = skip_fullmode0[zoom_y + 0x3f];
+			}
+			else if (yskip > 0x10)
+			{
+				yskip = skip_fullmode0[zoom_y + 0x3f];
 
-					if (invert)
-						sy = (sy + (*skip - yskip)) & 0x1ff;
-					else
-						invert = 1;
-				}
+				if (invert)
+					sy = (sy + (*skip - yskip)) & 0x1ff;
+				else
+					invert = 1;
+			}
+
+			if (sy + yskip > min_y && yskip <= max_y)
+			{
+				SPRITE_LIST *sprite = &chain_sprite_list[chain->first];
 
-				if (sy + yskip > min_y && yskip <= max_y)
+				for (x = 0; x < chain->num; x++)
 				{
-					SPRITE_LIST *sprite = sprite_list;
+					attr = sprite->base[*tile + 1];
+					code = sprite->base[*tile + 0] | ((attr << 12) & high_tile_mask);
 
-					for (x = 0; x < num_sprites; x++)
+					if (!auto_animation_disabled)
 					{
-						attr = sprite->base[*tile + 1];
-						code = sprite->base[*tile + 0] | ((attr << 12) & high_tile_mask);
-
-						if (!auto_animation_disabled)
-						{
-							if (attr & 0x0008)
-								code = (code & ~0x07) | (auto_animation_counter & 0x07);
-							else if (attr & 0x0004)
-								code = (code & ~0x03) | (auto_animation_counter & 0x03);
-						}
+						if (attr & 0x0008)
+							code = (code & ~0x07) | (auto_animation_counter & 0x07);
+						else if (attr & 0x0004)
+							code = (code & ~0x03) | (auto_animation_counter & 0x03);
+					}
 
-						code &= sprite_gfx_code_mask;
+					code &= sprite_gfx_code_mask;
 
-						if (spr_pen_usage[code])
-							blit_draw_spr(sprite->x, sy, sprite->zoom_x, yskip, code, attr);
+					if (spr_pen_usage[code])
+						BLIT(draw_spr)(sprite->x, sy, sprite->zoom_x, yskip, code, attr);
 
-						sprite++;
-					}
+					sprite++;
 				}
-
-				sprite_line += *skip;
-				skip++;
-				tile++;
 			}
 
-			num_sprites = 0;
-			rows = 0;
+			sprite_line += *skip;
+			skip++;
+			tile++;
 		}
-	} while (sprite_number < max_sprite_number);
+	}
 
-	blit_finish_spr();
+	BLIT(finish_spr)();
 }
 
 
@@ -358,147 +544,228 @@ static inline int sprite_on_scanline(int scanline, int y, int rows)
 }
 
 
-/*
- * Software sprite rendering (scanline-by-scanline)
- * Used for partial updates (<15 lines) and shrunk sprites
- * This path uses zoom_x_tables for pixel-skip patterns
- */
-static void draw_sprites_software(int min_y, int max_y)
-{
-	int y = 0;
-	int x = 0;
-	int rows = 0;
-	int zoom_y = 0;
-	int zoom_x = 0;
+/*------------------------------------------------------
+	Draw sprite chains on lines min_y - max_y
+------------------------------------------------------*/
 
-	uint16_t sprite_number = 0;
-	uint16_t num_sprites = 0;
-	uint8_t fullmode = 0;
+static void draw_sprite_chains(int min_y, int max_y)
+{
+	SPRITE_CHAIN *chain = sprite_chain;
+	SPRITE_CHAIN *chain_end = sprite_chain + num_sprite_chains;
 	uint16_t attr;
 	uint32_t code;
+	int x;
 
-	do
+	for (; chain < chain_end; chain++)
 	{
-		for (;sprite_number < max_sprite_number; sprite_number++)
+		uint16_t scanline;
+		uint16_t zoom_y = chain->zoom_y;
+		uint8_t *zoom_y_table = memory_region_gfx4 + (zoom_y << 8);
+		uint8_t sprite_y;
+		uint8_t tile;
+		uint8_t sprite_y_and_tile;
+		uint8_t attr_and_code_offs;
+
+		if (!chain->num) continue;
+
+		for (scanline = min_y; scanline <= max_y; scanline++)
 		{
-			uint16_t y_control = sprite_y_control[sprite_number];
-			uint16_t zoom_control = sprite_zoom_control[sprite_number];
+			SPRITE_LIST *sprite = &chain_sprite_list[chain->first];
 
-			if (y_control & 0x40)
+			if (sprite_on_scanline(scanline, chain->y, chain->rows))
 			{
-				if (rows == 0) continue;
+				uint16_t sprite_line = (scanline - chain->y) & 0x1ff;
+				uint16_t zoom_line = sprite_line & 0xff;
+				uint16_t invert = sprite_line & 0x100;
 
-				x += zoom_x + 1;
-			}
-			else
-			{
-				if (num_sprites != 0) break;
+				if (invert)
+					zoom_line ^= 0xff;
+
+				if (chain->fullmode)
+				{
+					zoom_line = zoom_line % ((zoom_y + 1) << 1);
 
-				if ((rows = y_control & 0x3f) == 0) continue;
+					if (zoom_line > zoom_y)
+					{
+						zoom_line = ((zoom_y + 1) << 1) - 1 - zoom_line;
+						invert = !invert;
+					}
+				}
 
-				y = 0x200 - (y_control >> 7);
-				x = (sprite_x_control[sprite_number] >> 7) + 16;
-				zoom_y = zoom_control & 0xff;
+				sprite_y_and_tile = zoom_y_table[zoom_line];
+				sprite_y = sprite_y_and_tile & 0x0f;
+				tile = sprite_y_and_tile >> 4;
 
-				if (rows > 0x20)
+				if (invert)
 				{
-					rows = 0x200;
-					fullmode = 1;
+					sprite_y ^= 0x0f;
+					tile ^= 0x1f;
 				}
-				else
+
+				attr_and_code_offs = tile << 1;
+
+				for (x = 0; x < chain->num; x++)
 				{
-					rows <<= 4;
-					fullmode = 0;
-				}
-			}
+					attr = sprite->base[attr_and_code_offs + 1];
+					code = sprite->base[attr_and_code_offs + 0] | ((attr << 12) & high_tile_mask);
 
-			x &= 0x1ff;
+					if (!auto_animation_disabled)
+					{
+						if (attr & 0x0008)
+							code = (code & ~0x07) | (auto_animation_counter & 0x07);
+						else if (attr & 0x0004)
+							code = (code & ~0x03) | (auto_animation_counter & 0x03);
+					}
 
-			zoom_x = (zoom_control >> 8) & 0x0f;
+					code &= sprite_gfx_code_mask;
 
-			if ((x + zoom_x >= 24) && (x < 336))
-			{
-				sprite_list[num_sprites].x = x;
-				sprite_list[num_sprites].zoom_x = zoom_x + 1;
-				sprite_list[num_sprites].base = &neogeo_videoram[sprite_number << 6];
-				num_sprites++;
+					if (spr_pen_usage[code])
+						BLIT(draw_spr_line)(sprite->x, scanline, sprite->zoom_x, sprite_y, code, attr, spr_pen_usage[code]);
+
+					sprite++;
+				}
 			}
 		}
+	}
+}
 
-		if (num_sprites)
-		{
-			uint16_t scanline;
-			uint8_t *zoom_y_table = memory_region_gfx4 + (zoom_y << 8);
-			uint8_t sprite_y;
-			uint8_t tile;
-			uint8_t sprite_y_and_tile;
-			uint8_t attr_and_code_offs;
-
-			for (scanline = min_y; scanline <= max_y; scanline++)
-			{
-				SPRITE_LIST *sprite = sprite_list;
 
-				if (sprite_on_scanline(scanline, y, rows))
-				{
-					uint16_t sprite_line = (scanline - y) & 0x1ff;
-					uint16_t zoom_line = sprite_line & 0xff;
-					uint16_t invert = sprite_line & 0x100;
+/*
+ * Software sprite rendering (scanline-by-scanline)
+ * Used for partial updates (<15 lines) and shrunk sprites
+ * This path uses zoom_x_tables for pixel-skip patterns
+ */
+static void draw_sprites_software(int min_y, int max_y)
+{
+	update_sprite_chains();
+	draw_sprite_chains(min_y, max_y);
+}
 
-					if (invert)
-						zoom_line ^= 0xff;
 
-					if (fullmode)
-					{
-						zoom_line = zoom_line % ((zoom_y + 1) << 1);
+/*------------------------------------------------------
+	Draw sprites of lines min_y - max_y
+------------------------------------------------------*/
 
-						if (zoom_line > zoom_y)
-						{
-							zoom_line = ((zoom_y + 1) << 1) - 1 - zoom_line;
-							invert = !invert;
-						}
-					}
+static void draw_sprites(int min_y, int max_y)
+{
+	BLIT(start)(min_y, max_y);
 
-					sprite_y_and_tile = zoom_y_table[zoom_line];
-					sprite_y = sprite_y_and_tile & 0x0f;
-					tile = sprite_y_and_tile >> 4;
+	if (max_y - min_y < 15)
+		draw_sprites_software(min_y, max_y);
+	else
+		draw_sprites_hardware(min_y, max_y);
+}
 
-					if (invert)
-					{
-						sprite_y ^= 0x0f;
-						tile ^= 0x1f;
-					}
 
-					attr_and_code_offs = tile << 1;
+#if USE_RASTER_LOG
 
-					for (x = 0; x < num_sprites; x++)
-					{
-						attr = sprite->base[attr_and_code_offs + 1];
-						code = sprite->base[attr_and_code_offs + 0] | ((attr << 12) & high_tile_mask);
+/*------------------------------------------------------
+	Record band boundary
+------------------------------------------------------*/
 
-						if (!auto_animation_disabled)
-						{
-							if (attr & 0x0008)
-								code = (code & ~0x07) | (auto_animation_counter & 0x07);
-							else if (attr & 0x0004)
-								code = (code & ~0x03) | (auto_animation_counter & 0x03);
-						}
+static void raster_log_add_band(int min_y, int max_y)
+{
+	RASTER_BAND *band = &raster_band[raster_band_num++];
 
-						code &= sprite_gfx_code_mask;
+	band->first_line = min_y;
+	band->last_line  = max_y;
+	band->log_end    = raster_log_num;
+	band->palette_bank = palette_bank;
+	band->auto_animation_counter = auto_animation_counter;
 
-						if (spr_pen_usage[code])
-							blit_draw_spr_line(sprite->x, scanline, sprite->zoom_x, sprite_y, code, attr, spr_pen_usage[code]);
+	raster_log_active = 1;
+}
 
-						sprite++;
-					}
-				}
-			}
 
-			num_sprites = 0;
-			rows = 0;
+/*------------------------------------------------------
+	Swap logged writes with VRAM / palette contents
+------------------------------------------------------*/
+
+static inline void raster_log_swap(RASTER_WRITE *w)
+{
+	uint16_t data = *w->addr;
+
+	*w->addr = w->data;
+	w->data = data;
+
+	if (w->addr >= &neogeo_videoram[NEOGEO_VRAM_SCB2] && w->addr < &neogeo_videoram[NEOGEO_VRAM_SPRLIST])
+		sprite_chain_dirty = 1;
+}
+
+
+/*------------------------------------------------------
+	Draw all recorded bands
+
+	Undo the logged writes to get back to the state of the
+	first band, then redo them band by band. Consecutive
+	bands without writes in between are drawn as one.
+------------------------------------------------------*/
+
+static void raster_log_resolve(void)
+{
+	uint8_t bank = palette_bank;
+	uint8_t counter = auto_animation_counter;
+	int i, b, n = 0;
+
+	for (i = raster_log_num - 1; i >= 0; i--)
+		raster_log_swap(&raster_log[i]);
+
+	for (b = 0; b < raster_band_num; b++)
+	{
+		RASTER_BAND *band = &raster_band[b];
+		int last_line = band->last_line;
+
+		for (; n < band->log_end; n++)
+			raster_log_swap(&raster_log[n]);
+
+		while (b + 1 < raster_band_num
+			&& raster_band[b + 1].log_end == band->log_end
+			&& raster_band[b + 1].palette_bank == band->palette_bank
+			&& raster_band[b + 1].auto_animation_counter == band->auto_animation_counter)
+		{
+			last_line = raster_band[++b].last_line;
 		}
-	} while (sprite_number < max_sprite_number);
+
+		palette_bank = band->palette_bank;
+		video_palette = video_palettebank[palette_bank];
+		auto_animation_counter = band->auto_animation_counter;
+
+		draw_sprites(band->first_line, last_line);
+	}
+
+	for (; n < raster_log_num; n++)
+		raster_log_swap(&raster_log[n]);
+
+	palette_bank = bank;
+	video_palette = video_palettebank[bank];
+	auto_animation_counter = counter;
+
+	raster_log_num = 0;
+	raster_band_num = 0;
+	raster_log_active = 0;
+}
+
+
+/*------------------------------------------------------
+	Log write to sprite VRAM / palette (before it happens)
+------------------------------------------------------*/
+
+void neogeo_raster_log_write(uint16_t *addr)
+{
+	if (raster_log_num == RASTER_LOG_SIZE)
+	{
+		// log full: draw what we have, the current state starts a new log
+		raster_log_resolve();
+		return;
+	}
+
+	raster_log[raster_log_num].addr = addr;
+	raster_log[raster_log_num].data = *addr;
+	raster_log_num++;
 }
 
+#endif /* USE_RASTER_LOG */
+
 
 /******************************************************************************
 	MVS Video Drawing Processing
@@ -551,6 +818,11 @@ void neogeo_video_init(void)
 		sprite_gfx_code_mask >>= 1;
 	}
 
+#if USE_PREDECODE_GFX
+	// only when the whole sprite ROM is resident (not using the sprite cache)
+	spr_decoded = read_cache ? NULL : tile_predecode_16(memory_region_gfx3, memory_length_gfx3);
+#endif
+
 	skip_fullmode0 = &memory_region_user3[0x100*0x40*0];
 	tile_fullmode0 = &memory_region_user3[0x100*0x40*1];
 	skip_fullmode1 = &memory_region_user3[0x100*0x40*2];
@@ -576,6 +848,13 @@ void neogeo_video_init(void)
 
 void neogeo_video_exit(void)
 {
+#if USE_PREDECODE_GFX
+	if (spr_decoded)
+	{
+		free(spr_decoded);
+		spr_decoded = NULL;
+	}
+#endif
 }
 
 
@@ -602,13 +881,13 @@ void neogeo_video_reset(void)
 	else
 		max_sprite_number = 0;
 
-	draw_fixed_layer_func[0] = draw_fixed_layer_type0;
+	update_fixed_layer_func[0] = update_fixed_layer_type0;
 
 	switch (neogeo_fix_bank_type)
 	{
-	case 1:  draw_fixed_layer_func[1] = draw_fixed_layer_type1; break;
-	case 2:  draw_fixed_layer_func[1] = draw_fixed_layer_type2; break;
-	default: draw_fixed_layer_func[1] = draw_fixed_layer_type0; break;
+	case 1:  update_fixed_layer_func[1] = update_fixed_layer_type1; break;
+	case 2:  update_fixed_layer_func[1] = update_fixed_layer_type2; break;
+	default: update_fixed_layer_func[1] = update_fixed_layer_type0; break;
 	}
 
 	if (neogeo_bios == ASIA_AES
@@ -619,6 +898,14 @@ void neogeo_video_reset(void)
 		neogeo_set_fixed_layer_source(0);
 
 	spr_pen_usage = gfx_pen_usage[2];
+	sprite_chain_dirty = 1;
+	video_dirty = VIDEO_DIRTY_ALL;
+
+#if USE_RASTER_LOG
+	raster_log_num = 0;
+	raster_band_num = 0;
+	raster_log_active = 0;
+#endif
 
 	blit_reset();
 }
@@ -638,9 +925,10 @@ void neogeo_set_fixed_layer_source(uint8_t data)
 	fix_usage  = gfx_pen_usage[data];
 	fix_memory = data ? memory_region_gfx2 : memory_region_gfx1;
 
-	draw_fixed_layer = draw_fixed_layer_func[data];
+	update_fixed_layer = update_fixed_layer_func[data];
 
-	blit_set_fix_clear_flag();
+	BLIT(set_fix_clear_flag)();
+	video_dirty |= VIDEO_DIRTY_FIX_GFX;
 }
 
 
@@ -648,27 +936,60 @@ void neogeo_set_fixed_layer_source(uint8_t data)
 	Screen Update Processing
 ******************************************************************************/
 
+/*------------------------------------------------------
+	Check if the last frame can be shown again
+------------------------------------------------------*/
+
+static int frame_unchanged(void)
+{
+	if (!last_frame_valid || video_dirty)
+		return 0;
+
+	if (auto_animation_disabled != last_auto_animation_disabled)
+		return 0;
+
+	return auto_animation_disabled || auto_animation_counter == last_auto_animation_counter;
+}
+
+
 /*------------------------------------------------------
 	Screen Update
 ------------------------------------------------------*/
 
 void neogeo_screenrefresh(void)
 {
-	if (next_update_first_line <= LAST_VISIBLE_LINE)
+	int full_frame = (next_update_first_line == FIRST_VISIBLE_LINE);
+
+	if (full_frame && frame_unchanged())
+	{
+		BLIT(finish)();
+		return;
+	}
+
+#if USE_RASTER_LOG
+	if (raster_band_num)
 	{
-		blit_start(next_update_first_line, LAST_VISIBLE_LINE);
+		if (next_update_first_line <= LAST_VISIBLE_LINE)
+			raster_log_add_band(next_update_first_line, LAST_VISIBLE_LINE);
 
-		if (LAST_VISIBLE_LINE - next_update_first_line < 15)
-			draw_sprites_software(next_update_first_line, LAST_VISIBLE_LINE);
-		else
-			draw_sprites_hardware(next_update_first_line, LAST_VISIBLE_LINE);
+		raster_log_resolve();
 	}
+	else
+#endif
+	if (next_update_first_line <= LAST_VISIBLE_LINE)
+		draw_sprites(next_update_first_line, LAST_VISIBLE_LINE);
 
 	draw_fixed_layer();
 
-	blit_finish();
+	BLIT(finish)();
 
 	next_update_first_line = FIRST_VISIBLE_LINE;
+
+	/* frames split by raster effects can not be reused */
+	last_frame_valid = full_frame;
+	last_auto_animation_counter = auto_animation_counter;
+	last_auto_animation_disabled = auto_animation_disabled;
+	video_dirty = 0;
 }
 
 
@@ -685,12 +1006,11 @@ void neogeo_partial_screenrefresh(int current_line)
 			if (current_line > LAST_VISIBLE_LINE)
 				current_line = LAST_VISIBLE_LINE;
 
-			blit_start(next_update_first_line, current_line);
-
-			if (current_line - next_update_first_line < 15)
-				draw_sprites_software(next_update_first_line, current_line);
-			else
-				draw_sprites_hardware(next_update_first_line, current_line);
+#if USE_RASTER_LOG
+			raster_log_add_band(next_update_first_line, current_line);
+#else
+			draw_sprites(next_update_first_line, current_line);
+#endif
 		}
 
 		next_update_first_line = current_line + 1;
@@ -741,6 +1061,8 @@ STATE_LOAD( video )
 	}
 
 	video_palette = video_palettebank[palette_bank];
+	sprite_chain_dirty = 1;
+	video_dirty = VIDEO_DIRTY_ALL;
 
 	neogeo_set_fixed_layer_source(fix_bank);
 }
@@ -18,6 +18,12 @@
 #define PALETTE_BANK_SIZE		(0x2000 / 2)
 #define PALETTE_BANKS			(2)
 
+#define VIDEO_DIRTY_SPR			0x01	/* SCB1-SCB4 */
+#define VIDEO_DIRTY_FIX			0x02	/* fix map, fix bankswitching */
+#define VIDEO_DIRTY_PALETTE		0x04	/* palette RAM, palette bank */
+#define VIDEO_DIRTY_FIX_GFX		0x08	/* fix layer source, fix graphics/pen usage writes */
+#define VIDEO_DIRTY_ALL			0xff
+
 extern uint16_t neogeo_videoram[0x20000 / 2];
 extern uint16_t videoram_read_buffer;
 extern uint16_t videoram_offset;
@@ -38,6 +44,18 @@ extern uint8_t *fix_memory;
 extern int neogeo_fix_bank_type;
 
 extern uint16_t max_sprite_number;
+extern int sprite_chain_dirty;
+extern int video_dirty;
+
+#if USE_PREDECODE_GFX
+extern uint8_t *spr_decoded;
+#endif
+
+#if USE_RASTER_LOG
+extern int raster_log_active;
+
+void neogeo_raster_log_write(uint16_t *addr);
+#endif
 
 void neogeo_video_init(void);
 void neogeo_video_exit(void);
@@ -969,6 +969,8 @@ void neogeo_decode_spr(uint8_t *mem, uint32_t offset, uint32_t length)
 	uint8_t *base  = mem + offset;
 	uint8_t *usage = spr_pen_usage + (offset >> 7);
 
+	video_dirty |= VIDEO_DIRTY_SPR;
+
 	for (tileno = 0; tileno < numtiles; tileno++)
 	{
 		uint8_t swap[128];
@@ -1059,6 +1061,8 @@ void neogeo_decode_fix(uint8_t *mem, uint32_t offset, uint32_t length)
 	uint8_t *usage = &fix_pen_usage[offset >> 6];
 	uint8_t *base  = &mem[offset >> 1];
 
+	video_dirty |= VIDEO_DIRTY_FIX_GFX;
+
 	for (i = 0; i < length; i += 32)
 	{
 		opaque  = 0;
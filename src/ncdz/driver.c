@@ -8,6 +8,7 @@
 
 #include <limits.h>
 #include "ncdz.h"
+#include "common/memory_sizes.h"
 
 void swab(const void *restrict src, void *restrict dest, ssize_t nbytes);
 
@@ -546,6 +547,7 @@ static inline void neogeo_set_palette_bank(uint8_t data)
 		palette_bank = data;
 
 		video_palette = video_palettebank[data];
+		video_dirty |= VIDEO_DIRTY_PALETTE;
 	}
 }
 
@@ -579,7 +581,21 @@ static inline uint16_t get_videoram_data(void)
 
 static inline void set_videoram_data(uint16_t data)
 {
-	neogeo_videoram[videoram_offset] = data;
+	if (neogeo_videoram[videoram_offset] != data)
+	{
+		if (videoram_offset < NEOGEO_VRAM_FIX)
+			video_dirty |= VIDEO_DIRTY_SPR;
+		else if (videoram_offset < NEOGEO_VRAM_SCB2)
+			video_dirty |= VIDEO_DIRTY_FIX;
+		else if (videoram_offset < NEOGEO_VRAM_SPRLIST)
+		{
+			/* SCB2-SCB4 changes the sprite chains */
+			video_dirty |= VIDEO_DIRTY_SPR;
+			sprite_chain_dirty = 1;
+		}
+
+		neogeo_videoram[videoram_offset] = data;
+	}
 
 	/* auto increment/decrement the current offset - A15 is NOT effected */
 	videoram_offset = (videoram_offset & 0x8000) | ((videoram_offset + videoram_modulo) & 0x7fff);
@@ -873,7 +889,11 @@ static inline WRITE16_HANDLER( exmem_type_w )
 
 static inline WRITE16_HANDLER( spr_plane_disable_w )
 {
-	spr_disable = data & 0xff;
+	if (spr_disable != (data & 0xff))
+	{
+		spr_disable = data & 0xff;
+		video_dirty |= VIDEO_DIRTY_SPR;
+	}
 }
 
 
@@ -883,7 +903,11 @@ static inline WRITE16_HANDLER( spr_plane_disable_w )
 
 static inline WRITE16_HANDLER( fix_plane_disable_w )
 {
-	fix_disable = data & 0xff;
+	if (fix_disable != (data & 0xff))
+	{
+		fix_disable = data & 0xff;
+		video_dirty |= VIDEO_DIRTY_FIX;
+	}
 }
 
 
@@ -893,7 +917,11 @@ static inline WRITE16_HANDLER( fix_plane_disable_w )
 
 static inline WRITE16_HANDLER( video_output_enable_w )
 {
-	video_enable = data & 0xff;
+	if (video_enable != (data & 0xff))
+	{
+		video_enable = data & 0xff;
+		video_dirty = VIDEO_DIRTY_ALL;
+	}
 }
 
 
@@ -1133,7 +1161,13 @@ WRITE16_HANDLER( neogeo_paletteram_w )
 	COMBINE_DATA(addr);
 
 	if (offset & 0x0f)
-		video_palette[offset] = video_clut16[*addr & 0x7fff];
+	{
+		if (video_palette[offset] != video_clut16[*addr & 0x7fff])
+		{
+			video_palette[offset] = video_clut16[*addr & 0x7fff];
+			video_dirty |= VIDEO_DIRTY_PALETTE;
+		}
+	}
 }
 
 
@@ -230,6 +230,7 @@ static void neogeo_run(void)
 			
 			apply_cheat();//davex
 			timer_update_cpu();
+			sound_queue_frame();
 
 			neogeo_cdda_check();
 
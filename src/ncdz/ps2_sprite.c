@@ -88,8 +88,6 @@ void blit_set_spr_clear_flag(void)
 
 void blit_reset(void)
 {
-	int i;
-
 	scrbitmap  = (uint16_t *)video_driver->workFrame(video_data, SCRBITMAP);
 	tex_spr[0] = video_driver->workFrame(video_data, TEX_SPR0);
 	tex_spr[1] = video_driver->workFrame(video_data, TEX_SPR1);
@@ -97,9 +95,6 @@ void blit_reset(void)
 	tex_fix    = video_driver->workFrame(video_data, TEX_FIX);
 	tex_fix_changed = false;
 
-	for (i = 0; i < FIX_TEXTURE_SIZE; i++) fix_data[i].index = i;
-	for (i = 0; i < SPR_TEXTURE_SIZE; i++) spr_data[i].index = i;
-
 	clip_min_y = FIRST_VISIBLE_LINE;
 	clip_max_y = LAST_VISIBLE_LINE;
 
@@ -163,13 +158,12 @@ void blit_draw_fix(int x, int y, uint32_t code, uint32_t attr)
 
 	if ((idx = fix_get_sprite(key)) < 0)
 	{
-		uint32_t col, tile;
-		uint8_t *src, *dst, lines, row, column;
-		uint32_t datal, datah;
+		uint32_t col;
+		uint8_t *src, *dst, row, column;
 
 		tex_fix_changed = true;
 
-		if (fix_texture_num == FIX_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&fix_cache))
 			fix_delete_sprite();
 
 		idx = fix_insert_sprite(key);
@@ -178,16 +172,8 @@ void blit_draw_fix(int x, int y, uint32_t code, uint32_t attr)
 
 		row = idx / TILE_8x8_PER_LINE;
 		column = idx % TILE_8x8_PER_LINE;
-		for (lines = 0; lines < 8; lines++)
-		{
-			dst = &tex_fix[((row * 8) + lines) * BUF_WIDTH + (column * 8)];
-			tile = *(uint32_t *)(src + 0);
-			datal = ((tile & 0x0000000f) >>  0) | ((tile & 0x000000f0) <<  4) | ((tile & 0x00000f00) <<  8) | ((tile & 0x0000f000) << 12) | col;
-			datah = ((tile & 0x000f0000) >> 16) | ((tile & 0x00f00000) >> 12) | ((tile & 0x0f000000) >>  8) | ((tile & 0xf0000000) >>  4) | col;
-			*(uint32_t *)(dst +  0) = datal;
-			*(uint32_t *)(dst +  4) = datah;
-			src += 4;
-		}
+		dst = &tex_fix[(row * 8) * BUF_WIDTH + (column * 8)];
+		tile_decode_8_linear(dst, BUF_WIDTH, src, col);
 	}
 
 	vertices = &vertices_fix[fix_num];
@@ -240,30 +226,26 @@ void blit_draw_spr(int x, int y, int w, int h, uint32_t code, uint32_t attr)
 
 	if ((idx = spr_get_sprite(key)) < 0)
 	{
-		uint32_t col, tile, offset;
-		uint8_t *src, *dst, lines, row, column;
+		uint32_t col, offset;
+		uint8_t *src, *dst, row, column;
 
-		if (spr_texture_num == SPR_TEXTURE_SIZE - 1)
+		if (tile_cache_full(&spr_cache))
+		{
 			spr_delete_sprite();
 
+			if (tile_cache_full(&spr_cache))
+				return;
+		}
+
 		src = &memory_region_gfx2[code << 7];
 		idx = spr_insert_sprite(key);
 		col = color_table[(attr >> 8) & 0x0f];
 
 		row = idx / TILE_16x16_PER_LINE;
 		column = idx % TILE_16x16_PER_LINE;
-		for (lines = 0; lines < 16; lines++)
-		{
-			offset = ((row * 16) + lines) * BUF_WIDTH + (column * 16);
-			dst = &tex_spr[0][offset];
-			tile = *(uint32_t *)(src + 0);
-			*(uint32_t *)(dst +  0) = ((tile >> 0) & 0x0f0f0f0f) | col;
-			*(uint32_t *)(dst +  4) = ((tile >> 4) & 0x0f0f0f0f) | col;
-			tile = *(uint32_t *)(src + 4);
-			*(uint32_t *)(dst +  8) = ((tile >> 0) & 0x0f0f0f0f) | col;
-			*(uint32_t *)(dst + 12) = ((tile >> 4) & 0x0f0f0f0f) | col;
-			src += 8;
-		}
+		offset = (row * 16) * BUF_WIDTH + (column * 16);
+		dst = &tex_spr[0][offset];
+		tile_decode_16(dst, BUF_WIDTH, src, col, 16);
 	}
 
 	vertices = &vertices_spr[spr_num];
@@ -23,46 +23,24 @@
 #define MAKE_SPR_KEY(code, attr)	(uint32_t)(code | (((uint32_t)(attr & 0x0f00)) << 20))
 
 #define FIX_TEXTURE_SIZE	((BUF_WIDTH/8)*(TEXTURE_HEIGHT/8))
-#define FIX_HASH_MASK		0x1ff
-#define FIX_HASH_SIZE		0x200
+#define FIX_HASH_SIZE		0x2000
 #define FIX_MAX_SPRITES		((320/8) * (240/8))
 #define TILE_8x8_PER_LINE	(BUF_WIDTH/8)
 #define TILE_16x16_PER_LINE	(BUF_WIDTH/16)
 
 #define SPR_TEXTURE_SIZE	((BUF_WIDTH/16)*((TEXTURE_HEIGHT*3)/16))
-#define SPR_HASH_MASK		0x1ff
-#define SPR_HASH_SIZE		0x200
+#define SPR_HASH_SIZE		0x2000
 #define SPR_MAX_SPRITES		0x3000
 
-/******************************************************************************
-	Structures
-******************************************************************************/
-
-typedef struct sprite_t SPRITE;
-
-struct sprite_t
-{
-	uint32_t key;
-	uint32_t used;
-	int32_t index;
-	SPRITE *next;
-};
-
 /******************************************************************************
 	Shared variables (extern declarations)
 ******************************************************************************/
 
-extern SPRITE ALIGN_DATA *fix_head[FIX_HASH_SIZE];
-extern SPRITE ALIGN_DATA fix_data[FIX_TEXTURE_SIZE];
-extern SPRITE *fix_free_head;
+extern TILE_CACHE fix_cache;
 extern uint16_t fix_num;
-extern uint16_t fix_texture_num;
 
-extern SPRITE ALIGN_DATA *spr_head[SPR_HASH_SIZE];
-extern SPRITE ALIGN_DATA spr_data[SPR_TEXTURE_SIZE];
-extern SPRITE *spr_free_head;
+extern TILE_CACHE spr_cache;
 extern uint16_t spr_num;
-extern uint16_t spr_texture_num;
 extern uint16_t spr_index;
 
 extern int clip_min_y;
@@ -42,6 +42,7 @@ int timer_enable(int which, int enable);
 void timer_adjust(int which, int duration, int param, void (*callback)(int raram));
 void timer_set(int which, int duration, int param, void (*callback)(int param));
 float timer_get_time(void);
+int timer_get_frame_offset(void);
 int timer_getscanline(void);
 
 #define video_get_vpos()	(timer_getscanline() - (NEOGEO_VBEND + (RASTER_COUNTER_RELOAD - NEOGEO_VBSTART)))
@@ -51,6 +51,9 @@ int video_enable;
 int spr_disable;
 int fix_disable;
 
+int sprite_chain_dirty;
+int video_dirty;
+
 
 /******************************************************************************
 	Local Variables
@@ -58,6 +61,44 @@ int fix_disable;
 
 static int next_update_first_line;
 
+/*
+ * The composed frame stays in the work frame, so it is shown again as is
+ * when nothing it was drawn from changed (video_dirty is set by VRAM,
+ * palette, graphics upload and plane enable writes).
+ */
+static int last_frame_valid;
+static uint8_t last_auto_animation_counter;
+static uint8_t last_auto_animation_disabled;
+
+/*
+ * Fix layer cells: cells are only resolved again when the fix map or fix
+ * graphics changed, and cells with visible pixels are kept in a list that
+ * is submitted every frame (palette writes do not change the list).
+ * Every fix graphics write must end with neogeo_decode_fix(), which
+ * updates fix_pen_usage and sets VIDEO_DIRTY_FIX_GFX.
+ */
+#define FIX_COLUMNS		((312 - 8) / 8)
+#define FIX_ROWS		((240 - 16) / 8)
+#define FIX_CELLS		(FIX_COLUMNS * FIX_ROWS)
+
+typedef struct
+{
+	uint16_t code;
+	uint16_t attr;
+} FIX_CELL;
+
+typedef struct
+{
+	int16_t  x;
+	int16_t  y;
+	uint16_t code;
+	uint16_t attr;
+} FIX_TILE;
+
+static FIX_CELL fix_cell[FIX_CELLS];
+static FIX_TILE fix_tile[FIX_CELLS];
+static int fix_tile_num;
+
 /*
  * Sprite Control Block pointers (reference: VRAM layout in memory_sizes.h)
  * SCB2: Shrink coefficients - lower byte = vertical ($FF=full), upper nibble = horizontal ($F=full)
@@ -96,25 +137,72 @@ static void patch_vram_crsword2(void);
 	VRAM layout: $7000-$74FF, each word = palette (4 bits) + tile number (12 bits)
 ------------------------------------------------------*/
 
-static void draw_fix(void)
+static void update_fix(void)
 {
+	FIX_CELL *cell = fix_cell;
+	FIX_TILE *tile;
 	uint16_t x, y, code, attr;
+	int changed = 0;
+
+	if (video_dirty & VIDEO_DIRTY_FIX_GFX)
+	{
+		/* fix_pen_usage changed: resolve all cells again */
+		memset(fix_cell, 0xff, sizeof(fix_cell));
+	}
 
 	for (x = 8/8; x < 312/8; x++)
 	{
 		uint16_t *vram = &neogeo_videoram[NEOGEO_VRAM_FIX + 2 + (x << 5)];
 
-		for (y = 16/8; y < 240/8; y++)
+		for (y = 16/8; y < 240/8; y++, cell++)
 		{
 			code = *vram++;
 			attr = code >> 12;
 			code &= 0x0fff;
 
-			if (fix_pen_usage[code])
-				blit_draw_fix((x << 3) + 16, y << 3, code, attr);
+			if (cell->code != code || cell->attr != attr)
+			{
+				cell->code = code;
+				cell->attr = attr;
+				changed = 1;
+			}
 		}
 	}
 
+	if (!changed) return;
+
+	cell = fix_cell;
+	fix_tile_num = 0;
+
+	for (x = 8/8; x < 312/8; x++)
+	{
+		for (y = 16/8; y < 240/8; y++, cell++)
+		{
+			if (fix_pen_usage[cell->code])
+			{
+				tile = &fix_tile[fix_tile_num++];
+				tile->x    = (x << 3) + 16;
+				tile->y    = y << 3;
+				tile->code = cell->code;
+				tile->attr = cell->attr;
+			}
+		}
+	}
+}
+
+
+static void draw_fix(void)
+{
+	FIX_TILE *tile, *end;
+
+	if (video_dirty & (VIDEO_DIRTY_FIX | VIDEO_DIRTY_FIX_GFX))
+		update_fix();
+
+	end = fix_tile + fix_tile_num;
+
+	for (tile = fix_tile; tile < end; tile++)
+		blit_draw_fix(tile->x, tile->y, tile->code, tile->attr);
+
 	blit_finish_fix();
 }
 
@@ -143,146 +231,197 @@ typedef struct
 	uint16_t *base;			/* Pointer to sprite's SCB1 data */
 } SPRITE_LIST;
 
-static SPRITE_LIST sprite_list[MAX_SPRITES_PER_LINE];
 
 /*
- * Hardware-accelerated sprite rendering
- * Used for full-screen updates (>15 lines changed)
+ * Sprite chains: a chain is a sprite and the sticky sprites following it.
+ * The list only depends on SCB2-SCB4 (and the sprite range), so it is
+ * rebuilt lazily when those are written (sprite_chain_dirty) and shared
+ * by all bands of a frame and by both renderers.
  */
-static void draw_sprites_hardware(uint32_t start, uint32_t end, int min_y, int max_y)
+typedef struct
+{
+	int16_t  y;
+	uint16_t rows;
+	uint16_t zoom_y;
+	uint8_t  fullmode;
+	uint16_t first;			/* first sprite in chain_sprite_list */
+	uint16_t num;
+} SPRITE_CHAIN;
+
+static SPRITE_LIST chain_sprite_list[MAX_SPRITES_PER_SCREEN];
+static SPRITE_CHAIN sprite_chain[MAX_SPRITES_PER_SCREEN];
+static int num_sprite_chains;
+static uint32_t sprite_chain_start;
+static uint32_t sprite_chain_end;
+
+
+/*------------------------------------------------------
+	Rebuild sprite chain list if SCB2-SCB4 changed
+------------------------------------------------------*/
+
+static void update_sprite_chains(uint32_t start, uint32_t end)
 {
-	int y = 0;
+	SPRITE_CHAIN *chain = NULL;
+	uint16_t sprite_number;
+	uint16_t num_sprites = 0;
 	int x = 0;
-	int rows = 0;
-	int zoom_y = 0;
 	int zoom_x = 0;
+	int rows = 0;
 
-	uint16_t sprite_number = start;
-	uint16_t num_sprites = 0;
-	uint16_t fullmode = 0;
-	uint16_t attr;
-	uint32_t code;
+	if (!sprite_chain_dirty && sprite_chain_start == start && sprite_chain_end == end)
+		return;
 
-	const uint8_t *skip = NULL;
-	const uint8_t *tile = NULL;
+	num_sprite_chains = 0;
+	sprite_chain_start = start;
+	sprite_chain_end = end;
+	sprite_chain_dirty = 0;
 
-	do
+	for (sprite_number = start; sprite_number < end; sprite_number++)
 	{
-		for (;sprite_number < end; sprite_number++)
+		uint16_t y_control = sprite_y_control[sprite_number];
+		uint16_t zoom_control = sprite_zoom_control[sprite_number];
+
+		if (y_control & 0x40)
 		{
-			uint16_t y_control = sprite_y_control[sprite_number];
-			uint16_t zoom_control = sprite_zoom_control[sprite_number];
+			if (rows == 0) continue;
 
-			if (y_control & 0x40)
-			{
-				if (rows == 0) continue;
+			x += zoom_x + 1;
+		}
+		else
+		{
+			if ((rows = y_control & 0x3f) == 0) continue;
+
+			chain = &sprite_chain[num_sprite_chains++];
+			chain->y = 0x200 - (y_control >> 7);
+			chain->zoom_y = zoom_control & 0xff;
+			chain->first = num_sprites;
+			chain->num = 0;
+
+			x = (sprite_x_control[sprite_number] >> 7) + 16;
 
-				x += zoom_x + 1;
+			if (rows > 0x20)
+			{
+				chain->rows = 0x200;
+				chain->fullmode = 1;
 			}
 			else
 			{
-				if (num_sprites != 0) break;
+				chain->rows = rows << 4;
+				chain->fullmode = 0;
+			}
+		}
 
-				if ((rows = y_control & 0x3f) == 0) continue;
+		x &= 0x1ff;
 
-				y = 0x200 - (y_control >> 7);
-				x = (sprite_x_control[sprite_number] >> 7) + 16;
-				zoom_y = (zoom_control & 0xff) << 6;
+		zoom_x = (zoom_control >> 8) & 0x0f;
 
-				if (rows > 0x20)
-				{
-					rows = 0x200;
-					fullmode = 1;
-					skip = &skip_fullmode1[zoom_y];
-					tile = &tile_fullmode1[zoom_y];
-				}
-				else
-				{
-					rows <<= 4;
-					fullmode = 0;
-					skip = &skip_fullmode0[zoom_y];
-					tile = &tile_fullmode0[zoom_y];
-				}
-			}
+		if ((x + zoom_x >= 24) && (x < 336))
+		{
+			chain_sprite_list[num_sprites].x = x;
+			chain_sprite_list[num_sprites].zoom_x = zoom_x + 1;
+			chain_sprite_list[num_sprites].base = &neogeo_videoram[sprite_number << 6];
+			num_sprites++;
+			chain->num++;
+		}
+	}
+}
 
-			x &= 0x1ff;
 
-			zoom_x = (zoom_control >> 8) & 0x0f;
+/*
+ * Hardware-accelerated sprite rendering
+ * Used for full-screen updates (>15 lines changed)
+ */
+static void draw_sprites_hardware(uint32_t start, uint32_t end, int min_y, int max_y)
+{
+	SPRITE_CHAIN *chain = sprite_chain;
+	SPRITE_CHAIN *chain_end;
+	uint16_t attr;
+	uint32_t code;
+	int x;
+
+	update_sprite_chains(start, end);
+	chain_end = sprite_chain + num_sprite_chains;
 
-			if ((x + zoom_x >= 24) && (x < 336))
-			{
-				sprite_list[num_sprites].x = x;
-				sprite_list[num_sprites].zoom_x = zoom_x + 1;
-				sprite_list[num_sprites].base = &neogeo_videoram[sprite_number << 6];
-				num_sprites++;
-			}
+	for (; chain < chain_end; chain++)
+	{
+		int y = chain->y;
+		int rows = chain->rows;
+		int zoom_y = chain->zoom_y << 6;
+		uint16_t fullmode = chain->fullmode;
+		uint16_t sprite_line = 0;
+		uint16_t invert = 0;
+		uint16_t sy, yskip;
+		const uint8_t *skip;
+		const uint8_t *tile;
+
+		if (!chain->num) continue;
+
+		if (fullmode)
+		{
+			skip = &skip_fullmode1[zoom_y];
+			tile = &tile_fullmode1[zoom_y];
+		}
+		else
+		{
+			skip = &skip_fullmode0[zoom_y];
+			tile = &tile_fullmode0[zoom_y];
 		}
 
-		if (num_sprites)
+		while (sprite_line < rows)
 		{
-			uint16_t sprite_line = 0;
-			uint16_t invert = 0;
-			uint16_t sy, yskip;
+			sy = (y + sprite_line) & 0x1ff;
+			yskip = *skip;
 
-			while (sprite_line < rows)
+			if (fullmode)
 			{
-				sy = (y + sprite_line) & 0x1ff;
-				yskip = *skip;
-
-				if (fullmode)
+				if (yskip == 0)
 				{
-					if (yskip == 0)
-					{
-						skip = &skip_fullmode1[zoom_y];
-						tile = &tile_fullmode1[zoom_y];
-						yskip = *skip;
-					}
+					skip = &skip_fullmode1[zoom_y];
+					tile = &tile_fullmode1[zoom_y];
+					yskip = *skip;
 				}
-				else if (yskip > 0x10)
-				{
-					yskip = skip_fullmode0[zoom_y + 0x3f];
+			}
+			else if (yskip > 0x10)
+			{
+				yskip = skip_fullmode0[zoom_y + 0x3f];
 
-					if (invert)
-						sy = (sy + (*skip - yskip)) & 0x1ff;
-					else
-						invert = 1;
-				}
+				if (invert)
+					sy = (sy + (*skip - yskip)) & 0x1ff;
+				else
+					invert = 1;
+			}
 
-				if (sy + yskip > min_y && sy <= max_y)
+			if (sy + yskip > min_y && sy <= max_y)
+			{
+				SPRITE_LIST *sprite = &chain_sprite_list[chain->first];
+
+				for (x = 0; x < chain->num; x++)
 				{
-					SPRITE_LIST *sprite = sprite_list;
+					attr = sprite->base[*tile + 1];
+					code = sprite->base[*tile + 0];
 
-					for (x = 0; x < num_sprites; x++)
+					if (!auto_animation_disabled)
 					{
-						attr = sprite->base[*tile + 1];
-						code = sprite->base[*tile + 0];
-
-						if (!auto_animation_disabled)
-						{
-							if (attr & 0x0008)
-								code = (code & ~0x07) | (auto_animation_counter & 0x07);
-							else if (attr & 0x0004)
-								code = (code & ~0x03) | (auto_animation_counter & 0x03);
-						}
+						if (attr & 0x0008)
+							code = (code & ~0x07) | (auto_animation_counter & 0x07);
+						else if (attr & 0x0004)
+							code = (code & ~0x03) | (auto_animation_counter & 0x03);
+					}
 
-						code &= 0x7fff;
+					code &= 0x7fff;
 
-						if (spr_pen_usage[code])
-							blit_draw_spr(sprite->x, sy, sprite->zoom_x, yskip, code, attr);
+					if (spr_pen_usage[code])
+						blit_draw_spr(sprite->x, sy, sprite->zoom_x, yskip, code, attr);
 
-						sprite++;
-					}
+					sprite++;
 				}
-
-				sprite_line += *skip;
-				skip++;
-				tile++;
 			}
 
-			num_sprites = 0;
-			rows = 0;
+			sprite_line += *skip;
+			skip++;
+			tile++;
 		}
-	} while (sprite_number < end);
+	}
 
 	blit_finish_spr();
 }
@@ -299,145 +438,101 @@ static inline int sprite_on_scanline(int scanline, int y, int rows)
 }
 
 
-/*
- * Software sprite rendering (scanline-by-scanline)
- * Used for partial updates (<15 lines) and shrunk sprites
- * This path uses zoom_x_tables for exact pixel-skip patterns
- */
-static void draw_sprites_software(uint32_t start, uint32_t end, int min_y, int max_y)
-{
-	int y = 0;
-	int x = 0;
-	int rows = 0;
-	int zoom_y = 0;
-	int zoom_x = 0;
+/*------------------------------------------------------
+	Draw sprite chains on lines min_y - max_y
+------------------------------------------------------*/
 
-	uint16_t sprite_number = start;
-	uint16_t num_sprites = 0;
-	uint8_t fullmode = 0;
+static void draw_sprite_chains(int min_y, int max_y)
+{
+	SPRITE_CHAIN *chain = sprite_chain;
+	SPRITE_CHAIN *chain_end = sprite_chain + num_sprite_chains;
 	uint16_t attr;
 	uint32_t code;
+	int x;
 
-	do
+	for (; chain < chain_end; chain++)
 	{
-		for (;sprite_number < end; sprite_number++)
-		{
-			uint16_t y_control = sprite_y_control[sprite_number];
-			uint16_t zoom_control = sprite_zoom_control[sprite_number];
-
-			if (y_control & 0x40)
-			{
-				if (rows == 0) continue;
-
-				x += zoom_x + 1;
-			}
-			else
-			{
-				if (num_sprites != 0) break;
-
-				if ((rows = y_control & 0x3f) == 0) continue;
-
-				y = 0x200 - (y_control >> 7);
-				x = (sprite_x_control[sprite_number] >> 7) + 16;
-				zoom_y = zoom_control & 0xff;
-
-				if (rows > 0x20)
-				{
-					rows = 0x200;
-					fullmode = 1;
-				}
-				else
-				{
-					rows <<= 4;
-					fullmode = 0;
-				}
-			}
+		uint16_t scanline;
+		uint16_t zoom_y = chain->zoom_y;
+		uint8_t *zoom_y_table = memory_region_gfx3 + (zoom_y << 8);
+		uint8_t sprite_y;
+		uint8_t tile;
+		uint8_t sprite_y_and_tile;
+		uint8_t attr_and_code_offs;
 
-			x &= 0x1ff;
+		if (!chain->num) continue;
 
-			zoom_x = (zoom_control >> 8) & 0x0f;
+		for (scanline = min_y; scanline <= max_y; scanline++)
+		{
+			SPRITE_LIST *sprite = &chain_sprite_list[chain->first];
 
-			if ((x + zoom_x >= 24) && (x < 336))
+			if (sprite_on_scanline(scanline, chain->y, chain->rows))
 			{
-				sprite_list[num_sprites].x = x;
-				sprite_list[num_sprites].zoom_x = zoom_x + 1;
-				sprite_list[num_sprites].base = &neogeo_videoram[sprite_number << 6];
-				num_sprites++;
-			}
-		}
+				uint16_t sprite_line = (scanline - chain->y) & 0x1ff;
+				uint16_t zoom_line = sprite_line & 0xff;
+				uint16_t invert = sprite_line & 0x100;
 
-		if (num_sprites)
-		{
-			uint16_t scanline;
-			uint8_t *zoom_y_table = memory_region_gfx3 + (zoom_y << 8);
-			uint8_t sprite_y;
-			uint8_t tile;
-			uint8_t sprite_y_and_tile;
-			uint8_t attr_and_code_offs;
-
-			for (scanline = min_y; scanline <= max_y; scanline++)
-			{
-				SPRITE_LIST *sprite = sprite_list;
+				if (invert)
+					zoom_line ^= 0xff;
 
-				if (sprite_on_scanline(scanline, y, rows))
+				if (chain->fullmode)
 				{
-					uint16_t sprite_line = (scanline - y) & 0x1ff;
-					uint16_t zoom_line = sprite_line & 0xff;
-					uint16_t invert = sprite_line & 0x100;
-
-					if (invert)
-						zoom_line ^= 0xff;
+					zoom_line = zoom_line % ((zoom_y + 1) << 1);
 
-					if (fullmode)
+					if (zoom_line > zoom_y)
 					{
-						zoom_line = zoom_line % ((zoom_y + 1) << 1);
-
-						if (zoom_line > zoom_y)
-						{
-							zoom_line = ((zoom_y + 1) << 1) - 1 - zoom_line;
-							invert = !invert;
-						}
+						zoom_line = ((zoom_y + 1) << 1) - 1 - zoom_line;
+						invert = !invert;
 					}
+				}
 
-					sprite_y_and_tile = zoom_y_table[zoom_line];
-					sprite_y = sprite_y_and_tile & 0x0f;
-					tile = sprite_y_and_tile >> 4;
+				sprite_y_and_tile = zoom_y_table[zoom_line];
+				sprite_y = sprite_y_and_tile & 0x0f;
+				tile = sprite_y_and_tile >> 4;
 
-					if (invert)
-					{
-						sprite_y ^= 0x0f;
-						tile ^= 0x1f;
-					}
+				if (invert)
+				{
+					sprite_y ^= 0x0f;
+					tile ^= 0x1f;
+				}
 
-					attr_and_code_offs = tile << 1;
+				attr_and_code_offs = tile << 1;
 
-					for (x = 0; x < num_sprites; x++)
-					{
-						attr = sprite->base[attr_and_code_offs + 1];
-						code = sprite->base[attr_and_code_offs + 0];
+				for (x = 0; x < chain->num; x++)
+				{
+					attr = sprite->base[attr_and_code_offs + 1];
+					code = sprite->base[attr_and_code_offs + 0];
 
-						if (!auto_animation_disabled)
-						{
-							if (attr & 0x0008)
-								code = (code & ~0x07) | (auto_animation_counter & 0x07);
-							else if (attr & 0x0004)
-								code = (code & ~0x03) | (auto_animation_counter & 0x03);
-						}
+					if (!auto_animation_disabled)
+					{
+						if (attr & 0x0008)
+							code = (code & ~0x07) | (auto_animation_counter & 0x07);
+						else if (attr & 0x0004)
+							code = (code & ~0x03) | (auto_animation_counter & 0x03);
+					}
 
-						code &= 0x7fff;
+					code &= 0x7fff;
 
-						if (spr_pen_usage[code])
-							blit_draw_spr_line(sprite->x, scanline, sprite->zoom_x, sprite_y, code, attr, spr_pen_usage[code]);
+					if (spr_pen_usage[code])
+						blit_draw_spr_line(sprite->x, scanline, sprite->zoom_x, sprite_y, code, attr, spr_pen_usage[code]);
 
-						sprite++;
-					}
+					sprite++;
 				}
 			}
-
-			num_sprites = 0;
-			rows = 0;
 		}
-	} while (sprite_number < end);
+	}
+}
+
+
+/*
+ * Software sprite rendering (scanline-by-scanline)
+ * Used for partial updates (<15 lines) and shrunk sprites
+ * This path uses zoom_x_tables for exact pixel-skip patterns
+ */
+static void draw_sprites_software(uint32_t start, uint32_t end, int min_y, int max_y)
+{
+	update_sprite_chains(start, end);
+	draw_sprite_chains(min_y, max_y);
 }
 
 
@@ -549,6 +644,9 @@ void neogeo_video_reset(void)
 	spr_disable = 0;
 	fix_disable = 0;
 
+	sprite_chain_dirty = 1;
+	video_dirty = VIDEO_DIRTY_ALL;
+
 	blit_reset();
 }
 
@@ -557,12 +655,36 @@ void neogeo_video_reset(void)
 	Screen Update Processing
 ******************************************************************************/
 
+/*------------------------------------------------------
+	Check if the last frame can be shown again
+------------------------------------------------------*/
+
+static int frame_unchanged(void)
+{
+	if (!last_frame_valid || video_dirty)
+		return 0;
+
+	if (auto_animation_disabled != last_auto_animation_disabled)
+		return 0;
+
+	return auto_animation_disabled || auto_animation_counter == last_auto_animation_counter;
+}
+
+
 /*------------------------------------------------------
 	Screen Update
 ------------------------------------------------------*/
 
 void neogeo_screenrefresh(void)
 {
+	int full_frame = (next_update_first_line == FIRST_VISIBLE_LINE);
+
+	if (video_enable && full_frame && frame_unchanged())
+	{
+		blit_finish();
+		return;
+	}
+
 	if (video_enable)
 	{
 		if (!spr_disable)
@@ -587,6 +709,12 @@ void neogeo_screenrefresh(void)
 	}
 
 	next_update_first_line = FIRST_VISIBLE_LINE;
+
+	/* frames split by raster effects can not be reused */
+	last_frame_valid = video_enable && full_frame;
+	last_auto_animation_counter = auto_animation_counter;
+	last_auto_animation_disabled = auto_animation_disabled;
+	video_dirty = 0;
 }
 
 
@@ -654,12 +782,10 @@ int neogeo_loading_screenrefresh(int flag, int draw)
 	if (limit)
 	{
 		uint64_t target = prev + CLOCKS_PER_SEC / FPS;
-		uint64_t curr = ticker_driver->currentUs(ticker_data);
 
-		usleep(target - curr);
-		curr = ticker_driver->currentUs(ticker_data);
+		ticker_driver->sleepUntilUs(ticker_data, target);
 
-		prev = curr;
+		prev = ticker_driver->currentUs(ticker_data);
 	}
 
 	pad_update();
@@ -796,6 +922,8 @@ STATE_LOAD( video )
 	}
 
 	video_palette = video_palettebank[palette_bank];
+	sprite_chain_dirty = 1;
+	video_dirty = VIDEO_DIRTY_ALL;
 }
 
 #endif /* SAVE_STATE */
@@ -15,6 +15,12 @@
 #define MAX_SPRITES_PER_SCREEN	(381)
 #define MAX_SPRITES_PER_LINE	(96)
 
+#define VIDEO_DIRTY_SPR			0x01	/* SCB1-SCB4, sprite graphics */
+#define VIDEO_DIRTY_FIX			0x02	/* fix map */
+#define VIDEO_DIRTY_PALETTE		0x04	/* palette RAM, palette bank */
+#define VIDEO_DIRTY_FIX_GFX		0x08	/* fix graphics */
+#define VIDEO_DIRTY_ALL			0xff
+
 extern uint16_t neogeo_videoram[0x20000 / 2];
 extern uint16_t videoram_read_buffer;
 extern uint16_t videoram_offset;
@@ -34,6 +40,9 @@ extern int video_enable;
 extern int spr_disable;
 extern int fix_disable;
 
+extern int sprite_chain_dirty;
+extern int video_dirty;
+
 void neogeo_video_init(void);
 void neogeo_video_exit(void);
 void neogeo_video_reset(void);
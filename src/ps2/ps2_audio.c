@@ -277,6 +277,10 @@ static void ps2_outputPannedBlocking(void *data, int leftvol, int rightvol, void
 	g_mp3_write_pos = write_pos;
 }
 
+static bool ps2_stats(void *data, audio_stats_t *stats) {
+	return false;
+}
+
 audio_driver_t audio_ps2 = {
 	"ps2",
 	ps2_init,
@@ -287,4 +291,5 @@ audio_driver_t audio_ps2 = {
 	ps2_srcOutputBlocking,
 	ps2_outputPannedBlocking,
 	ps2_release,
+	ps2_stats,
 };
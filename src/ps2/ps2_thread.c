@@ -111,6 +111,39 @@ static void ps2_exitThread(void *data, int32_t exitCode) {
 	// We don't need to do anything here as we will call ExitThread in the childThread
 }
 
+static void *ps2_createSema(void) {
+	int32_t *id = (int32_t*)malloc(sizeof(int32_t));
+	ee_sema_t sema;
+
+	if (id == NULL) return NULL;
+
+	sema.init_count = 0;
+	sema.max_count = 0x7fffffff;
+	sema.option = 0;
+	*id = CreateSema(&sema);
+	if (*id < 0) {
+		free(id);
+		return NULL;
+	}
+	return id;
+}
+
+static void ps2_deleteSema(void *sema) {
+	int32_t *id = (int32_t*)sema;
+	DeleteSema(*id);
+	free(id);
+}
+
+static void ps2_waitSema(void *sema) {
+	int32_t *id = (int32_t*)sema;
+	WaitSema(*id);
+}
+
+static void ps2_signalSema(void *sema) {
+	int32_t *id = (int32_t*)sema;
+	SignalSema(*id);
+}
+
 thread_driver_t thread_ps2 = {
 	"ps2",
 	ps2_init,
@@ -123,5 +156,9 @@ thread_driver_t thread_ps2 = {
 	ps2_resumeThread,
 	ps2_suspendThread,
 	ps2_sleepThread,
-	ps2_exitThread
+	ps2_exitThread,
+	ps2_createSema,
+	ps2_deleteSema,
+	ps2_waitSema,
+	ps2_signalSema
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <time.h>
+#include <unistd.h>
 
 #include <timer.h>
 #include "common/ticker_driver.h"
@@ -23,9 +24,17 @@ static u_int64_t ps2_currentUs(void *data) {
     return clock();
 }
 
+static void ps2_sleepUntilUs(void *data, uint64_t target) {
+	uint64_t curr = ps2_currentUs(data);
+
+	if (target > curr)
+		usleep(target - curr);
+}
+
 ticker_driver_t ticker_ps2 = {
 	"ps2",
 	ps2_init,
 	ps2_free,
 	ps2_currentUs,
+	ps2_sleepUntilUs,
 };
\ No newline at end of file
@@ -49,6 +49,10 @@ static void psp_outputPannedBlocking(void *data, int leftvol, int rightvol, void
 	sceAudioOutputPannedBlocking(psp->channel, leftvol, rightvol, buffer);
 }
 
+static bool psp_stats(void *data, audio_stats_t *stats) {
+	return false;
+}
+
 audio_driver_t audio_psp = {
 	"psp",
 	psp_init,
@@ -59,4 +63,5 @@ audio_driver_t audio_psp = {
 	psp_srcOutputBlocking,
 	psp_outputPannedBlocking,
 	psp_release,
+	psp_stats,
 };
\ No newline at end of file
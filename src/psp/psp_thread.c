@@ -61,6 +61,33 @@ static void psp_exitThread(void *data, int32_t exitCode) {
 	sceKernelExitThread(exitCode);
 }
 
+static void *psp_createSema(void) {
+	SceUID *id = (SceUID*)malloc(sizeof(SceUID));
+	if (id == NULL) return NULL;
+	*id = sceKernelCreateSema("Semaphore", 0, 0, 0x7fffffff, NULL);
+	if (*id < 0) {
+		free(id);
+		return NULL;
+	}
+	return id;
+}
+
+static void psp_deleteSema(void *sema) {
+	SceUID *id = (SceUID*)sema;
+	sceKernelDeleteSema(*id);
+	free(id);
+}
+
+static void psp_waitSema(void *sema) {
+	SceUID *id = (SceUID*)sema;
+	sceKernelWaitSema(*id, 1, NULL);
+}
+
+static void psp_signalSema(void *sema) {
+	SceUID *id = (SceUID*)sema;
+	sceKernelSignalSema(*id, 1);
+}
+
 thread_driver_t thread_psp = {
 	"psp",
 	psp_init,
@@ -73,5 +100,9 @@ thread_driver_t thread_psp = {
 	psp_resumeThread,
 	psp_suspendThread,
 	psp_sleepThread,
-	psp_exitThread
+	psp_exitThread,
+	psp_createSema,
+	psp_deleteSema,
+	psp_waitSema,
+	psp_signalSema
 };
\ No newline at end of file
@@ -24,9 +24,17 @@ static uint64_t psp_currentUs(void *data) {
 	return sceKernelGetSystemTimeWide();
 }
 
+static void psp_sleepUntilUs(void *data, uint64_t target) {
+	uint64_t curr = psp_currentUs(data);
+
+	if (target > curr)
+		sceKernelDelayThread(target - curr);
+}
+
 ticker_driver_t ticker_psp = {
 	"psp",
 	psp_init,
 	psp_free,
 	psp_currentUs,
+	psp_sleepUntilUs,
 };
\ No newline at end of file
@@ -26,6 +26,7 @@ void YM2151_sh_start(int type)
 
 void YM2151_sh_stop(void)
 {
+	OKIM6295Exit();
 }
 
 
@@ -54,5 +55,9 @@ WRITE8_HANDLER( YM2151_register_port_w )
 
 WRITE8_HANDLER( YM2151_data_port_w )
 {
-	YM2151WriteReg(lastreg, data);
+	/* timer and irq registers are handled at once, the rest goes to the sound thread */
+	if (lastreg >= 0x10 && lastreg <= 0x14)
+		YM2151WriteReg(lastreg, data);
+	else
+		sound_queue_write(YM2151WriteReg, lastreg, data);
 }
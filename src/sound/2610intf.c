@@ -53,6 +53,7 @@ void YM2610_sh_start(void)
 
 void YM2610_sh_stop(void)
 {
+	YM2610Exit();
 }
 
 
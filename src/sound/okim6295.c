@@ -20,10 +20,25 @@
 #include "emumain.h"
 
 #define OKIM6295_VOICES		4
+#define OKIM6295_BLOCK		256		/* chip samples rendered per pass */
 
 #define FRAC_BIT	12
 #define FRAC_SIZE	(1 << FRAC_BIT)
 
+/* mix and interpolate 4 samples per step (SSE2 / NEON through GCC vectors) */
+#ifndef OKIM6295_SIMD
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define OKIM6295_SIMD 1
+#else
+#define OKIM6295_SIMD 0
+#endif
+#endif
+
+#if OKIM6295_SIMD
+typedef int32_t  OKIM6295_VEC  __attribute__((vector_size(16)));
+typedef uint32_t OKIM6295_UVEC __attribute__((vector_size(16)));
+#endif
+
 typedef struct
 {
 	uint32_t offset;
@@ -34,6 +49,13 @@ typedef struct
 	int data;
 	int volume;
 
+#if USE_ADPCM_CACHE
+	int attach;				/* look up the sample on the next update */
+	int16_t *pcm;			/* decoded sample (NULL = decode from ROM) */
+	uint8_t *pcm_step;		/* decoder step after each nibble */
+	uint32_t pcm_start;		/* nibble offset of pcm[0] */
+#endif
+
 } ADPCMVoice;
 
 typedef struct
@@ -51,6 +73,7 @@ typedef struct
 
 	uint8_t *rom_base;
 	uint8_t *sample_rom[OKIM6295_VOICES];
+	uint32_t rom_size;
 
 } okim6295_t;
 
@@ -61,6 +84,29 @@ static const int32_t ALIGN_DATA index_shift[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
 static okim6295_t ALIGN_DATA OKIM6295;
 static okim6295_t *okim6295 = &OKIM6295;
 
+static int16_t ALIGN_DATA voice_run[OKIM6295_BLOCK];
+
+#if USE_ADPCM_CACHE
+
+/* decoded samples, keyed by ROM offset (a sample always decodes the same from its start) */
+#define OKIM6295_CACHE_ENTRIES	128
+#define OKIM6295_CACHE_BUDGET	(2*1024*1024)	/* bytes of decoded data */
+#define OKIM6295_CACHE_BYTES(n)	((n) * (sizeof(int16_t) + sizeof(uint8_t)))
+
+typedef struct
+{
+	uint32_t start;			/* nibble offset */
+	uint32_t length;		/* length in nibbles */
+	uint32_t stamp;			/* last use */
+	int16_t *pcm;			/* signal after each nibble, followed by the step table */
+} OKIM6295_CACHE;
+
+static OKIM6295_CACHE okim6295_cache[OKIM6295_CACHE_ENTRIES];
+static uint32_t okim6295_cache_size;
+static uint32_t okim6295_cache_stamp;
+
+#endif
+
 
 /**********************************************************************************************
 
@@ -112,6 +158,180 @@ static void OKIM6295_init_tables(void)
 }
 
 
+/**********************************************************************************************
+
+     OKIM6295_decode -- decode nibbles of a voice (steps may be NULL)
+
+***********************************************************************************************/
+
+static void OKIM6295_decode(ADPCMVoice *voice, int16_t *out, uint8_t *steps, int length)
+{
+	int i, nibble, signal;
+
+	for (i = 0; i < length; i++)
+	{
+		/* compute the new amplitude and update the current step */
+		if (voice->offset & 1)
+		{
+			nibble = voice->data & 0x0f;
+		}
+		else
+		{
+			voice->data = okim6295->sample_rom[voice->offset >> 17][(voice->offset >> 1) & 0xffff];
+			nibble = voice->data >> 4;
+		}
+
+		/* clamp to the maximum */
+		signal = voice->signal + diff_lookup[(voice->step << 4) + nibble];
+		if (signal > 2047)
+		{
+			signal = 2047;
+		}
+		else if (signal < -2048)
+		{
+			signal = -2048;
+		}
+		voice->signal = signal;
+
+		/* adjust the step size and clamp */
+		voice->step = voice->step + index_shift[nibble & 7];
+		if (voice->step > 48)
+		{
+			voice->step = 48;
+		}
+		else if (voice->step < 0)
+		{
+			voice->step = 0;
+		}
+
+		out[i] = signal;
+		if (steps) steps[i] = voice->step;
+
+		/* advance sample offset */
+		voice->offset++;
+	}
+
+	voice->sample = voice->signal * voice->volume;
+}
+
+
+#if USE_ADPCM_CACHE
+/**********************************************************************************************
+
+     OKIM6295_cache -- decoded sample cache (sound thread only)
+
+***********************************************************************************************/
+
+static void OKIM6295_cache_free(void)
+{
+	int i;
+
+	for (i = 0; i < OKIM6295_CACHE_ENTRIES; i++)
+		free(okim6295_cache[i].pcm);
+
+	memset(okim6295_cache, 0, sizeof(okim6295_cache));
+	okim6295_cache_size = 0;
+	okim6295_cache_stamp = 0;
+}
+
+static int OKIM6295_cache_in_use(OKIM6295_CACHE *entry)
+{
+	int i;
+
+	for (i = 0; i < OKIM6295_VOICES; i++)
+		if (okim6295->voice[i].pcm == entry->pcm) return 1;
+
+	return 0;
+}
+
+static void OKIM6295_cache_evict(OKIM6295_CACHE *entry)
+{
+	okim6295_cache_size -= OKIM6295_CACHE_BYTES(entry->length);
+	free(entry->pcm);
+	memset(entry, 0, sizeof(OKIM6295_CACHE));
+}
+
+/* drop the least recently used entry that no voice refers to */
+static int OKIM6295_cache_evict_oldest(void)
+{
+	OKIM6295_CACHE *entry, *oldest = NULL;
+
+	for (entry = okim6295_cache; entry < &okim6295_cache[OKIM6295_CACHE_ENTRIES]; entry++)
+	{
+		if (!entry->pcm || OKIM6295_cache_in_use(entry)) continue;
+
+		if (!oldest || okim6295_cache_stamp - entry->stamp > okim6295_cache_stamp - oldest->stamp)
+			oldest = entry;
+	}
+
+	if (!oldest) return 0;
+
+	OKIM6295_cache_evict(oldest);
+	return 1;
+}
+
+/* attach the decoded sample to a voice that has just been keyed on */
+static void OKIM6295_cache_attach(ADPCMVoice *voice)
+{
+	OKIM6295_CACHE *entry, *slot = NULL;
+	ADPCMVoice work;
+	uint32_t start = voice->offset, length = voice->count;
+
+	voice->pcm = NULL;
+
+	if (((start + length - 1) >> 1) >= okim6295->rom_size || OKIM6295_CACHE_BYTES(length) > OKIM6295_CACHE_BUDGET / 4)
+		return;
+
+	okim6295_cache_stamp++;
+
+	for (entry = okim6295_cache; entry < &okim6295_cache[OKIM6295_CACHE_ENTRIES]; entry++)
+	{
+		if (entry->pcm && entry->start == start)
+		{
+			if (entry->length >= length)
+			{
+				entry->stamp = okim6295_cache_stamp;
+				voice->pcm       = entry->pcm;
+				voice->pcm_step  = (uint8_t *)(entry->pcm + entry->length);
+				voice->pcm_start = start;
+				return;
+			}
+
+			/* played longer this time, decode again */
+			if (OKIM6295_cache_in_use(entry)) return;
+			OKIM6295_cache_evict(entry);
+		}
+		if (!entry->pcm && !slot) slot = entry;
+	}
+
+	while (okim6295_cache_size + OKIM6295_CACHE_BYTES(length) > OKIM6295_CACHE_BUDGET || !slot)
+	{
+		if (!OKIM6295_cache_evict_oldest()) return;
+
+		for (slot = okim6295_cache; slot->pcm; slot++) ;
+	}
+
+	if ((slot->pcm = malloc(OKIM6295_CACHE_BYTES(length))) == NULL)
+		return;
+
+	/* decode from the key on state */
+	memset(&work, 0, sizeof(work));
+	work.offset = start;
+	work.signal = -2;
+	OKIM6295_decode(&work, slot->pcm, (uint8_t *)(slot->pcm + length), length);
+
+	slot->start  = start;
+	slot->length = length;
+	slot->stamp  = okim6295_cache_stamp;
+	okim6295_cache_size += OKIM6295_CACHE_BYTES(length);
+
+	voice->pcm       = slot->pcm;
+	voice->pcm_step  = (uint8_t *)(slot->pcm + length);
+	voice->pcm_start = start;
+}
+#endif
+
+
 /**********************************************************************************************
 
      OKIM6295Init -- initialize emulation of an OKIM6295-compatible chip
@@ -123,6 +343,9 @@ void OKIM6295Init(int clock, int pin7)
 	int i;
 	int divisor = pin7 ? 132 : 165;
 
+#if USE_ADPCM_CACHE
+	OKIM6295_cache_free();
+#endif
 	memset(okim6295, 0, sizeof(okim6295_t));
 
 	okim6295->clock = clock;
@@ -135,6 +358,7 @@ void OKIM6295Init(int clock, int pin7)
 	if (memory_region_sound1)
 	{
 		okim6295->rom_base = memory_region_sound1;
+		okim6295->rom_size = memory_length_sound1;
 
 		for (i = 0; i < OKIM6295_VOICES; i++)
 			okim6295->sample_rom[i] = okim6295->rom_base + (i << 16);
@@ -146,6 +370,20 @@ void OKIM6295Init(int clock, int pin7)
 }
 
 
+/**********************************************************************************************
+
+     OKIM6295Exit -- release decoded sample data
+
+***********************************************************************************************/
+
+void OKIM6295Exit(void)
+{
+#if USE_ADPCM_CACHE
+	OKIM6295_cache_free();
+#endif
+}
+
+
 /**********************************************************************************************
 
      OKIM6295Reset -- reset emulation of an OKIM6295-compatible chip
@@ -173,6 +411,93 @@ void OKIM6295_set_samplerate(void)
 }
 
 
+/**********************************************************************************************
+
+     OKIM6295_mix_voice -- add chip samples of one voice
+
+***********************************************************************************************/
+
+static void OKIM6295_mix_voice(int ch, int32_t *mix, int samples)
+{
+	ADPCMVoice *voice = &okim6295->voice[ch];
+	int16_t *run = voice_run;
+	int i = 0, length = samples;
+
+#if USE_ADPCM_CACHE
+	if (voice->attach)
+	{
+		voice->attach = 0;
+		OKIM6295_cache_attach(voice);
+	}
+#endif
+
+	if (voice->count < (uint32_t)length)
+		length = voice->count;
+
+	if (length)
+	{
+#if USE_ADPCM_CACHE
+		if (voice->pcm)
+		{
+			uint32_t pos = voice->offset - voice->pcm_start;
+
+			/* same state as decoding the nibbles */
+			run = voice->pcm + pos;
+			voice->offset += length;
+			voice->signal  = run[length - 1];
+			voice->step    = voice->pcm_step[pos + length - 1];
+			voice->data    = okim6295->rom_base[(voice->offset - 1) >> 1];
+			voice->sample  = voice->signal * voice->volume;
+		}
+		else
+#endif
+			OKIM6295_decode(voice, run, NULL, length);
+
+#if OKIM6295_SIMD
+		for (; i + 4 <= length; i += 4)
+		{
+			OKIM6295_VEC out, in = { run[i], run[i + 1], run[i + 2], run[i + 3] };
+
+			memcpy(&out, &mix[i], sizeof(out));
+			out += (in * voice->volume) >> 4;
+			memcpy(&mix[i], &out, sizeof(out));
+		}
+#endif
+		for (; i < length; i++)
+			mix[i] += (run[i] * voice->volume) >> 4;
+
+		voice->count -= length;
+	}
+
+	/* check for end of sample */
+	if (length < samples)
+	{
+		okim6295->status &= ~(1 << ch);
+		voice->count--;
+	}
+}
+
+
+/**********************************************************************************************
+
+     OKIM6295_render -- render chip samples of all voices
+
+***********************************************************************************************/
+
+static void OKIM6295_render(int32_t *mix, int samples)
+{
+	int i;
+
+	if (!samples) return;
+
+	memset(mix, 0, samples * sizeof(int32_t));
+
+	for (i = 0; i < OKIM6295_VOICES; i++)
+		if (okim6295->status & (1 << i))
+			OKIM6295_mix_voice(i, mix, samples);
+}
+
+
 /**********************************************************************************************
 
      OKIM6295Update -- update the sound chip so that it is in sync with CPU execution
@@ -181,93 +506,72 @@ void OKIM6295_set_samplerate(void)
 
 static void OKIM6295Update(int32_t *buffer, int length)
 {
-	int prev_sample = okim6295->prev_sample;
-	int curr_sample = okim6295->curr_sample;
-	int stream_pos  = okim6295->stream_pos;
-	int i, nibble, signal;
-	int32_t *buf = buffer;
+	int32_t ALIGN_DATA mix[OKIM6295_BLOCK + 2];
+	uint32_t source_step = okim6295->source_step;
 
-	while (length--)
+	while (length > 0)
 	{
-		if (stream_pos >= FRAC_SIZE)
+		uint32_t stream_pos = okim6295->stream_pos;
+		uint32_t pos, last;
+		int i = 0, count = length, samples, curr, prev;
+
+		/* output samples whose chip samples fit in the block */
+		if (stream_pos + (count - 1) * source_step >= ((OKIM6295_BLOCK + 1) << FRAC_BIT))
+			count = (((OKIM6295_BLOCK + 1) << FRAC_BIT) - 1 - stream_pos) / source_step + 1;
+
+		last    = stream_pos + (count - 1) * source_step;
+		samples = last >> FRAC_BIT;
+
+		/* mix[0] = previous, mix[1] = current, then the new chip samples */
+		mix[0] = okim6295->prev_sample;
+		mix[1] = okim6295->curr_sample;
+		OKIM6295_render(&mix[2], samples);
+
+		/* interpolate sample */
+#if OKIM6295_SIMD
+		if (source_step <= FRAC_SIZE && count >= 4)
 		{
-			prev_sample = curr_sample;
+			OKIM6295_UVEC vpos = { stream_pos, stream_pos + source_step, stream_pos + source_step * 2, stream_pos + source_step * 3 };
+			OKIM6295_VEC p, q, out;
 
-			do
+			for (; i + 4 <= count; i += 4)
 			{
-				curr_sample = 0;
+				OKIM6295_UVEC idx = vpos >> FRAC_BIT;
 
-				for (i = 0; i < OKIM6295_VOICES; i++)
-				{
-					if (okim6295->status & (1 << i))
-					{
-						ADPCMVoice *voice = &okim6295->voice[i];
-
-						/* check for end of sample */
-						if (voice->count-- == 0)
-						{
-							okim6295->status &= ~(1 << i);
-							continue;
-						}
-
-						/* compute the new amplitude and update the current step */
-						if (voice->offset & 1)
-						{
-							nibble = voice->data & 0x0f;
-						}
-						else
-						{
-							voice->data = okim6295->sample_rom[voice->offset >> 17][(voice->offset >> 1) & 0xffff];
-							nibble = voice->data >> 4;
-						}
-
-						/* clamp to the maximum */
-						signal = voice->signal + diff_lookup[(voice->step << 4) + nibble];
-						if (signal > 2047)
-						{
-							signal = 2047;
-						}
-						else if (signal < -2048)
-						{
-							signal = -2048;
-						}
-						voice->signal = signal;
-						voice->sample = signal * voice->volume;
-
-						/* adjust the step size and clamp */
-						voice->step = voice->step + index_shift[nibble & 7];
-						if (voice->step > 48)
-						{
-							voice->step = 48;
-						}
-						else if (voice->step < 0)
-						{
-							voice->step = 0;
-						}
-
-						curr_sample += voice->sample >> 4;
-
-						/* advance sample offset */
-						voice->offset++;
-					}
-				}
+				/* at most one chip sample per output sample, so the previous one is mix[idx] */
+				p = (OKIM6295_VEC){ mix[idx[0]], mix[idx[1]], mix[idx[2]], mix[idx[3]] };
+				q = (OKIM6295_VEC){ mix[idx[0] + 1], mix[idx[1] + 1], mix[idx[2] + 1], mix[idx[3] + 1] };
 
-				stream_pos -= FRAC_SIZE;
+				memcpy(&out, &buffer[i], sizeof(out));
+				out += p + (((q - p) * (OKIM6295_VEC)(vpos & (FRAC_SIZE - 1))) >> FRAC_BIT);
+				memcpy(&buffer[i], &out, sizeof(out));
 
-			} while (stream_pos >= FRAC_SIZE);
+				vpos += source_step * 4;
+			}
 		}
+#endif
 
-		/* interpolate sample */
-		signal = prev_sample + (((curr_sample - prev_sample) * stream_pos) >> FRAC_BIT);
+		curr = i ? (stream_pos + (i - 1) * source_step) >> FRAC_BIT : 0;
+		prev = mix[curr];
+
+		for (pos = stream_pos + i * source_step; i < count; i++, pos += source_step)
+		{
+			if ((int)(pos >> FRAC_BIT) != curr)
+			{
+				prev = mix[curr + 1];
+				curr = pos >> FRAC_BIT;
+			}
 
-		*buf++ += signal;
+			buffer[i] += prev + (((mix[curr + 1] - prev) * (int)(pos & (FRAC_SIZE - 1))) >> FRAC_BIT);
+		}
 
-		stream_pos += okim6295->source_step;
-	}
+		okim6295->stream_pos  = (last & (FRAC_SIZE - 1)) + source_step;
+		okim6295->prev_sample = prev;
+		okim6295->curr_sample = mix[samples + 1];
 
-	okim6295->stream_pos  = stream_pos;
-	okim6295->prev_sample = prev_sample;
-	okim6295->curr_sample = curr_sample;
+		buffer += count;
+		length -= count;
+	}
 }
 
 
@@ -315,8 +619,6 @@ WRITE8_HANDLER( OKIM6295_data_w )
 				{
 					if (!(okim6295->status & data))
 					{
-						okim6295->status |= data;
-
 						voice->offset = start << 1;
 						voice->count = (stop - start + 1) << 1;
 						voice->sample = 0;
@@ -325,6 +627,12 @@ WRITE8_HANDLER( OKIM6295_data_w )
 						voice->step   = 0;
 						voice->signal = -2;
 						voice->volume = volume_tables[volume];
+#if USE_ADPCM_CACHE
+						voice->attach = 1;
+#endif
+
+						/* the voice is set up before the sound thread sees it */
+						okim6295->status |= data;
 					}
 				}
 				else
@@ -412,6 +720,10 @@ STATE_LOAD( okim6295 )
 		state_load_long(&voice->step, 1);
 		state_load_long(&voice->data, 1);
 		state_load_long(&voice->volume, 1);
+#if USE_ADPCM_CACHE
+		voice->attach = 0;
+		voice->pcm = NULL;
+#endif
 	}
 
 	state_load_long(&okim6295->clock, 1);
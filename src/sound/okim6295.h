@@ -4,6 +4,7 @@
 #define OKIM6295_H
 
 void OKIM6295Init(int clock, int pin7);
+void OKIM6295Exit(void);
 void OKIM6295Reset(void);
 void OKIM6295_set_samplerate(void);
 
@@ -10,10 +10,24 @@
 
 #define QSOUND_CHANNELS 16
 
+/* mix 4 output samples per step (SSE2 / NEON through GCC vectors) */
+#ifndef QSOUND_SIMD
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define QSOUND_SIMD 1
+#else
+#define QSOUND_SIMD 0
+#endif
+#endif
+
 typedef int8_t  QSOUND_SRC_SAMPLE;
 typedef int16_t QSOUND_SAMPLE;
 typedef int32_t QSOUND_SAMPLE_MIX;
 
+#if QSOUND_SIMD
+typedef int32_t  QSOUND_VEC  __attribute__((vector_size(16)));
+typedef uint32_t QSOUND_UVEC __attribute__((vector_size(16)));
+#endif
+
 
 /******************************************************************************
 	Local Variables/Structures
@@ -59,6 +73,92 @@ static const int ALIGN_DATA qsound_pan_table[33] =
 	Local Functions
 ******************************************************************************/
 
+/*--------------------------------------------------------
+	Samples until the address reaches the end address
+--------------------------------------------------------*/
+
+static int qsound_span(QSOUND_CHANNEL *pC, int length)
+{
+	uint32_t limit, span;
+
+	/* offset (16.16) of the first sample that steps onto the end */
+	limit = (uint32_t)(pC->end > pC->address ? pC->end - pC->address : 1) << 16;
+
+	if ((uint32_t)pC->offset >= limit)
+		return 0;
+	if (!pC->pitch)
+		return length;
+
+	span = (limit - pC->offset - 1) / pC->pitch + 1;
+
+	return (span < (uint32_t)length) ? span : length;
+}
+
+
+/*--------------------------------------------------------
+	Mix samples of a channel (no loop/end inside)
+--------------------------------------------------------*/
+
+static void qsound_mix_span(QSOUND_CHANNEL *pC, QSOUND_SRC_SAMPLE *pST,
+	QSOUND_SAMPLE_MIX *bufL, QSOUND_SAMPLE_MIX *bufR,
+	QSOUND_SAMPLE_MIX lvol, QSOUND_SAMPLE_MIX rvol, int length)
+{
+	QSOUND_SRC_SAMPLE *src = pST + pC->address;
+	uint32_t pitch = pC->pitch;
+	uint32_t pos = pC->offset;
+	uint32_t last = pos + (length - 1) * pitch;
+	int i = 0;
+
+	/* the last sample value is held until the first step */
+	for (; i < length && pos < 0x10000; i++, pos += pitch)
+	{
+		*bufL++ += (pC->lastdt * lvol) >> 6;
+		*bufR++ += (pC->lastdt * rvol) >> 6;
+	}
+
+#if QSOUND_SIMD
+	if (i + 4 <= length)
+	{
+		QSOUND_UVEC vpos = { pos, pos + pitch, pos + pitch * 2, pos + pitch * 3 };
+		QSOUND_VEC dt, outL, outR;
+
+		for (; i + 4 <= length; i += 4)
+		{
+			QSOUND_UVEC idx = vpos >> 16;
+
+			dt = (QSOUND_VEC){ src[idx[0]], src[idx[1]], src[idx[2]], src[idx[3]] };
+
+			memcpy(&outL, bufL, sizeof(outL));
+			memcpy(&outR, bufR, sizeof(outR));
+			outL += (dt * lvol) >> 6;
+			outR += (dt * rvol) >> 6;
+			memcpy(bufL, &outL, sizeof(outL));
+			memcpy(bufR, &outR, sizeof(outR));
+
+			bufL += 4;
+			bufR += 4;
+			vpos += pitch * 4;
+		}
+		pos = vpos[0];
+	}
+#endif
+
+	for (; i < length; i++, pos += pitch)
+	{
+		int dt = src[pos >> 16];
+
+		*bufL++ += (dt * lvol) >> 6;
+		*bufR++ += (dt * rvol) >> 6;
+	}
+
+	/* same state as stepping sample by sample */
+	if (last >= 0x10000)
+		pC->lastdt = src[last >> 16];
+	pC->address += last >> 16;
+	pC->offset   = (last & 0xffff) + pitch;
+}
+
+
 /*--------------------------------------------------------
 	Sound Stream Generation
 --------------------------------------------------------*/
@@ -73,45 +173,133 @@ static void qsound_update(int32_t **buffer, int length)
 
 		if (pC->key)
 		{
-			int i;
+			int i = 0;
 			QSOUND_SRC_SAMPLE *pST  = qsound_sample_rom + pC->bank;
 			QSOUND_SAMPLE_MIX *bufL = buffer[0];
 			QSOUND_SAMPLE_MIX *bufR = buffer[1];
 			QSOUND_SAMPLE_MIX lvol  = (pC->lvol * pC->vol) >> qsound_volume_shift;
 			QSOUND_SAMPLE_MIX rvol  = (pC->rvol * pC->vol) >> qsound_volume_shift;
 
-			for (i = 0; i < length; i++)
+			while (i < length)
 			{
-				int count = (pC->offset) >> 16;
+				int span = qsound_span(pC, length - i);
 
+				if (span)
+				{
+					qsound_mix_span(pC, pST, &bufL[i], &bufR[i], lvol, rvol, span);
+					i += span;
+					continue;
+				}
+
+				/* this sample steps onto the end address */
+				pC->address += pC->offset >> 16;
 				pC->offset &= 0xffff;
 
-				if (count)
+				if (pC->address >= pC->end)
 				{
-					pC->address += count;
-
-					if (pC->address >= pC->end)
+					if (!pC->loop)
 					{
-						if (!pC->loop)
-						{
-							pC->key = 0;
-							break;
-						}
-						pC->address = (pC->end - pC->loop) & 0xffff;
+						pC->key = 0;
+						break;
 					}
-
-					pC->lastdt = pST[pC->address];
+					pC->address = (pC->end - pC->loop) & 0xffff;
 				}
 
-				*bufL++ += (pC->lastdt * lvol) >> 6;
-				*bufR++ += (pC->lastdt * rvol) >> 6;
+				pC->lastdt = pST[pC->address];
+
+				bufL[i] += (pC->lastdt * lvol) >> 6;
+				bufR[i] += (pC->lastdt * rvol) >> 6;
 				pC->offset += pC->pitch;
+				i++;
 			}
 		}
 	}
 }
 
 
+/*--------------------------------------------------------
+	Register Write (sound thread)
+--------------------------------------------------------*/
+
+static void qsound_write_reg(int cmd, int data)
+{
+	int ch, reg;
+
+	if (cmd < 0x80)
+	{
+		ch = cmd >> 3;
+		reg = cmd & 0x07;
+	}
+	else if (cmd < 0x90)
+	{
+		ch = cmd - 0x80;
+		reg = 8;
+	}
+	else
+	{
+		/* Unknown registers */
+		return;
+	}
+
+	switch (reg)
+	{
+	case 0: /* Bank */
+		ch = (ch + 1) & 0x0f;	/* strange ... */
+		qsound_channel[ch].bank = (data & 0x7f) << 16;
+		break;
+
+	case 1: /* start */
+		qsound_channel[ch].address = data;
+		break;
+
+	case 2: /* pitch */
+#if QSOUND_STREAM_48KHz
+		qsound_channel[ch].pitch = data << 3;
+#else
+		qsound_channel[ch].pitch = data << 4;
+#endif
+		if (!data)
+		{
+			/* Key off */
+			qsound_channel[ch].key = 0;
+		}
+		break;
+
+	case 4: /* loop offset */
+		qsound_channel[ch].loop = data;
+		break;
+
+	case 5: /* end */
+		qsound_channel[ch].end = data;
+		break;
+
+	case 6: /* master volume */
+		if (!data)
+		{
+			/* Key off */
+			qsound_channel[ch].key = 0;
+		}
+		else if (!qsound_channel[ch].key)
+		{
+			/* Key on */
+			qsound_channel[ch].key = 1;
+			qsound_channel[ch].offset = 0;
+			qsound_channel[ch].lastdt = 0;
+		}
+		qsound_channel[ch].vol = data;
+		break;
+
+	case 8: /* pan and L/R volume */
+		qsound_channel[ch].pan = data;
+		data = (data - 0x10) & 0x3f;
+		if (data > 32) data = 32;
+		qsound_channel[ch].rvol = qsound_pan_table[data];
+		qsound_channel[ch].lvol = qsound_pan_table[32 - data];
+		break;
+	}
+}
+
+
 /******************************************************************************
 	QSound Interface Functions
 ******************************************************************************/
@@ -227,79 +415,13 @@ WRITE8_HANDLER( qsound_data_l_w )
 
 WRITE8_HANDLER( qsound_cmd_w )
 {
-	int ch, reg;
-
-	if (data < 0x80)
-	{
-		ch = data >> 3;
-		reg = data & 0x07;
-	}
-	else if (data < 0x90)
-	{
-		ch = data - 0x80;
-		reg = 8;
-	}
-	else
-	{
-		/* Unknown registers */
-		return;
-	}
+	sound_queue_write(qsound_write_reg, data, qsound_data);
 
-	switch (reg)
+	if (data >= 0x80 && data < 0x90)
 	{
-	case 0: /* Bank */
-		ch = (ch + 1) & 0x0f;	/* strange ... */
-		qsound_channel[ch].bank = (qsound_data & 0x7f) << 16;
-		break;
-
-	case 1: /* start */
-		qsound_channel[ch].address = qsound_data;
-		break;
-
-	case 2: /* pitch */
-#if QSOUND_STREAM_48KHz
-		qsound_channel[ch].pitch = qsound_data << 3;
-#else
-		qsound_channel[ch].pitch = qsound_data << 4;
-#endif
-		if (!qsound_data)
-		{
-			/* Key off */
-			qsound_channel[ch].key = 0;
-		}
-		break;
-
-	case 4: /* loop offset */
-		qsound_channel[ch].loop = qsound_data;
-		break;
-
-	case 5: /* end */
-		qsound_channel[ch].end = qsound_data;
-		break;
-
-	case 6: /* master volume */
-		if (!qsound_data)
-		{
-			/* Key off */
-			qsound_channel[ch].key = 0;
-		}
-		else if (!qsound_channel[ch].key)
-		{
-			/* Key on */
-			qsound_channel[ch].key = 1;
-			qsound_channel[ch].offset = 0;
-			qsound_channel[ch].lastdt = 0;
-		}
-		qsound_channel[ch].vol = qsound_data;
-		break;
-
-	case 8: /* pan and L/R volume */
-		qsound_channel[ch].pan = qsound_data;
+		/* pan write leaves the adjusted value in the data latch */
 		qsound_data = (qsound_data - 0x10) & 0x3f;
 		if (qsound_data > 32) qsound_data = 32;
-		qsound_channel[ch].rvol = qsound_pan_table[qsound_data];
-		qsound_channel[ch].lvol = qsound_pan_table[32 - qsound_data];
-		break;
 	}
 }
 
@@ -15,12 +15,52 @@
 
 #define LINEAR_INTERPORATION	0
 
-#if (EMU_SYSTEM == CPS2)
+#if (EMU_SYSTEM == CPS2) && !SOUND_RESAMPLER_TAPS
 #define SAFETY	0
 #else
 #define SAFETY	32
 #endif
 
+/*
+	The queue holds the writes of a whole frame even if the Z80 does nothing
+	else: every queued write takes two (YM) or three (QSound) stores of at
+	least 7 cycles, so a frame has at most 67600 / 14 writes with a 4MHz Z80
+	and 134000 / 21 with the 8MHz Z80 of QSound.
+*/
+#define SOUND_QUEUE_SIZE	8192	/* must be a power of 2 */
+#define SOUND_QUEUE_MASK	(SOUND_QUEUE_SIZE - 1)
+#define SOUND_QUEUE_LATENCY	4		/* closed frames kept before they are applied at once */
+
+#define SOUND_UPDATE_STREAM	((EMU_SYSTEM != CPS2) || SOUND_RESAMPLER_TAPS)	/* chip rate stream of variable length */
+
+#if SOUND_EMU_THREAD
+#define SOUND_UPDATE_FRAMES	1		/* emulated frames rendered per update */
+#else
+#define SOUND_UPDATE_FRAMES	2
+#endif
+
+enum
+{
+	STAGE_RENDER = 0,
+	STAGE_CLIP,
+	STAGE_RESAMPLE,
+	STAGE_MAX
+};
+
+
+/******************************************************************************
+	Local Structures
+******************************************************************************/
+
+typedef struct sound_write_t
+{
+	void (*handler)(int reg, int data);
+	uint32_t frame;
+	uint16_t offset;
+	uint16_t reg;
+	uint16_t data;
+} SOUND_WRITE;
+
 
 /******************************************************************************
 	Local Variables
@@ -30,18 +70,175 @@ static int32_t ALIGN_DATA stream_buffer_left[SOUND_BUFFER_SIZE + SAFETY];
 static int32_t ALIGN_DATA stream_buffer_right[SOUND_BUFFER_SIZE + SAFETY];
 static int32_t ALIGN_DATA *stream_buffer[2];
 
-#if (EMU_SYSTEM != CPS2)
+#if SOUND_UPDATE_STREAM
 static float samples_per_update;
 static float samples_left_over;
 static uint32_t samples_this_update;
 #endif
 
+static SOUND_WRITE ALIGN_DATA sound_queue[SOUND_QUEUE_SIZE];
+static uint32_t queue_read;
+static uint32_t queue_write;
+static uint32_t queue_frame;
+static uint32_t render_frame;
+static int queue_active;
+static int queue_frames_per_update;
+
+static uint32_t stage_time[STAGE_MAX];
+static uint32_t stage_updates;
+static uint32_t report_time[STAGE_MAX];
+static uint32_t report_updates;
+
 
 /******************************************************************************
 	Local Functions
 ******************************************************************************/
 
-#if (EMU_SYSTEM != CPS2)
+/*------------------------------------------------------
+	Apply queued writes of closed frames before 'frame'
+	(sound thread)
+------------------------------------------------------*/
+
+static void sound_queue_apply(uint32_t frame)
+{
+	uint32_t read = queue_read;
+	uint32_t write = __atomic_load_n(&queue_write, __ATOMIC_ACQUIRE);
+	SOUND_WRITE *entry;
+
+	while (read != write)
+	{
+		entry = &sound_queue[read & SOUND_QUEUE_MASK];
+
+		if ((int32_t)(entry->frame - frame) >= 0)
+			break;
+
+		(*entry->handler)(entry->reg, entry->data);
+		read++;
+	}
+
+	__atomic_store_n(&queue_read, read, __ATOMIC_RELEASE);
+}
+
+
+/*------------------------------------------------------
+	Render stream, applying queued writes at their
+	position in the emulated frame (sound thread)
+------------------------------------------------------*/
+
+static void sound_queue_render(int32_t **buffer, int length)
+{
+	uint32_t closed = __atomic_load_n(&queue_frame, __ATOMIC_ACQUIRE);
+	uint32_t read = queue_read;
+	uint32_t write = __atomic_load_n(&queue_write, __ATOMIC_ACQUIRE);
+	int32_t *segment[2];
+	SOUND_WRITE *entry;
+	int i, pos, start, end, split;
+
+	if (closed - render_frame > SOUND_QUEUE_LATENCY)
+	{
+		/* emulation is running ahead, drop the timing of older frames */
+		render_frame = closed - SOUND_QUEUE_LATENCY;
+		sound_queue_apply(render_frame);
+		read = queue_read;
+	}
+
+	pos = 0;
+
+	for (i = 0; i < queue_frames_per_update; i++)
+	{
+		start = pos;
+		end   = length * (i + 1) / queue_frames_per_update;
+
+		if (render_frame != closed)
+		{
+			while (read != write)
+			{
+				entry = &sound_queue[read & SOUND_QUEUE_MASK];
+
+				if (entry->frame != render_frame)
+					break;
+
+				split = start + ((entry->offset * (end - start)) >> 16);
+
+				if (split > pos)
+				{
+					segment[0] = buffer[0] + pos;
+					segment[1] = buffer[1] + pos;
+					(*sound->callback)(segment, split - pos);
+					pos = split;
+				}
+
+				(*entry->handler)(entry->reg, entry->data);
+				read++;
+			}
+
+			__atomic_store_n(&queue_read, read, __ATOMIC_RELEASE);
+			render_frame++;
+		}
+
+		if (end > pos)
+		{
+			segment[0] = buffer[0] + pos;
+			segment[1] = buffer[1] + pos;
+			(*sound->callback)(segment, end - pos);
+			pos = end;
+		}
+	}
+}
+
+
+/*------------------------------------------------------
+	Account time spent in a stage (sound thread)
+------------------------------------------------------*/
+
+static uint64_t sound_stage_end(int stage, uint64_t start)
+{
+	uint64_t now = ticker_driver->currentUs(ticker_data);
+
+	stage_time[stage] += (uint32_t)(now - start);
+	return now;
+}
+
+
+#if SOUND_UPDATE_STREAM
+
+#if SOUND_RESAMPLER_TAPS
+/*------------------------------------------------------
+	Chip stream rate
+------------------------------------------------------*/
+
+static int sound_stream_rate(void)
+{
+#if (EMU_SYSTEM == CPS2)
+	return sound->frequency;
+#else
+#if (EMU_SYSTEM == CPS1)
+	if (machine_sound_type == SOUND_QSOUND)
+		return sound->frequency;
+#endif
+	return sound->frequency >> (2 - option_samplerate);
+#endif
+}
+#endif
+
+
+/*------------------------------------------------------
+	Reset stream length per update
+------------------------------------------------------*/
+
+static void sound_set_update_length(void)
+{
+#if SOUND_RESAMPLER_TAPS
+	samples_per_update = ((float)sound_stream_rate() / FPS) * SOUND_UPDATE_FRAMES;
+#else
+	samples_per_update = (((float)sound->frequency / FPS) * 2) / (1 << (2 - option_samplerate));
+#endif
+
+	samples_left_over   = samples_per_update;
+	samples_this_update = (uint32_t)samples_per_update;
+	samples_left_over  -= samples_this_update;
+}
+
 
 /*------------------------------------------------------
 	Clip Samples
@@ -61,6 +258,11 @@ static void clip_stream(int32_t *buffer)
 }
 
 
+#endif
+
+
+#if (EMU_SYSTEM != CPS2) && !SOUND_RESAMPLER_TAPS
+
 /*------------------------------------------------------
 	Resampling
 ------------------------------------------------------*/
@@ -119,19 +321,56 @@ static void resample_stream(int32_t *src, int16_t *dst)
 #endif
 
 
+/*------------------------------------------------------
+	Sound Update (Resampler)
+------------------------------------------------------*/
+
+#if SOUND_RESAMPLER_TAPS
+
+static int sound_update_resample(int16_t *buffer)
+{
+	uint64_t time = ticker_driver->currentUs(ticker_data);
+	int frames;
+
+	sound_queue_render(stream_buffer, samples_this_update);
+	time = sound_stage_end(STAGE_RENDER, time);
+
+	clip_stream(stream_buffer[0]);
+	if (sound->channels == 2)
+		clip_stream(stream_buffer[1]);
+	time = sound_stage_end(STAGE_CLIP, time);
+
+	frames = resampler_process(stream_buffer, samples_this_update, buffer);
+	sound_stage_end(STAGE_RESAMPLE, time);
+
+	memset(stream_buffer[0], 0, samples_this_update * sizeof(int32_t));
+	memset(stream_buffer[1], 0, samples_this_update * sizeof(int32_t));
+
+	samples_left_over  += samples_per_update;
+	samples_this_update = (uint32_t)samples_left_over;
+	samples_left_over  -= samples_this_update;
+
+	__atomic_store_n(&stage_updates, stage_updates + 1, __ATOMIC_RELEASE);
+
+	return frames;
+}
+
+
 /*------------------------------------------------------
 	Sound Update (Stereo)
 ------------------------------------------------------*/
 
-#if (EMU_SYSTEM == CPS1 || EMU_SYSTEM == CPS2)
+#elif (EMU_SYSTEM == CPS1 || EMU_SYSTEM == CPS2)
 
-static void sound_update_stereo(int16_t *buffer)
+static int sound_update_stereo(int16_t *buffer)
 {
+	uint64_t time = ticker_driver->currentUs(ticker_data);
 	uint32_t samples = sound->samples;
 	int32_t *srcL, *srcR, sample;
 	int16_t *dst = buffer;
 
-	(*sound->callback)(stream_buffer, samples);
+	sound_queue_render(stream_buffer, samples);
+	time = sound_stage_end(STAGE_RENDER, time);
 
 	srcL = stream_buffer[0];
 	srcR = stream_buffer[1];
@@ -146,26 +385,40 @@ static void sound_update_stereo(int16_t *buffer)
 		Limit(sample, MAXOUT, MINOUT);
 		*dst++ = sample;
 	}
+	sound_stage_end(STAGE_CLIP, time);
 
 	memset(stream_buffer[0], 0, sound->samples * sizeof(int32_t));
 	memset(stream_buffer[1], 0, sound->samples * sizeof(int32_t));
+
+	__atomic_store_n(&stage_updates, stage_updates + 1, __ATOMIC_RELEASE);
+
+	return sound->samples;
 }
 
 #else
 
-static void sound_update_stereo(int16_t *buffer)
+static int sound_update_stereo(int16_t *buffer)
 {
-	(*sound->callback)(stream_buffer, samples_this_update);
+	uint64_t time = ticker_driver->currentUs(ticker_data);
+
+	sound_queue_render(stream_buffer, samples_this_update);
+	time = sound_stage_end(STAGE_RENDER, time);
 
 	clip_stream(stream_buffer[0]);
 	clip_stream(stream_buffer[1]);
+	time = sound_stage_end(STAGE_CLIP, time);
 
 	resample_stream(stream_buffer[0], &buffer[0]);
 	resample_stream(stream_buffer[1], &buffer[1]);
+	sound_stage_end(STAGE_RESAMPLE, time);
 
 	samples_left_over  += samples_per_update;
 	samples_this_update = (uint32_t)samples_left_over;
 	samples_left_over  -= samples_this_update;
+
+	__atomic_store_n(&stage_updates, stage_updates + 1, __ATOMIC_RELEASE);
+
+	return sound->samples;
 }
 
 #endif
@@ -175,19 +428,28 @@ static void sound_update_stereo(int16_t *buffer)
 	Sound Update (Mono)
 ------------------------------------------------------*/
 
-#if (EMU_SYSTEM == CPS1)
+#if (EMU_SYSTEM == CPS1) && !SOUND_RESAMPLER_TAPS
 
-static void sound_update_mono(int16_t *buffer)
+static int sound_update_mono(int16_t *buffer)
 {
-	(*sound->callback)(stream_buffer, samples_this_update);
+	uint64_t time = ticker_driver->currentUs(ticker_data);
+
+	sound_queue_render(stream_buffer, samples_this_update);
+	time = sound_stage_end(STAGE_RENDER, time);
 
 	clip_stream(stream_buffer[0]);
+	time = sound_stage_end(STAGE_CLIP, time);
 
 	resample_stream(stream_buffer[0], buffer);
+	sound_stage_end(STAGE_RESAMPLE, time);
 
 	samples_left_over  += samples_per_update;
 	samples_this_update = (uint32_t)samples_left_over;
 	samples_left_over  -= samples_this_update;
+
+	__atomic_store_n(&stage_updates, stage_updates + 1, __ATOMIC_RELEASE);
+
+	return sound->samples;
 }
 
 #endif
@@ -202,10 +464,6 @@ static void sound_update_mono(int16_t *buffer)
 ------------------------------------------------------*/
 int sound_init(void)
 {
-#if (EMU_SYSTEM != CPS2)
-	int sample_shift;
-#endif
-
 #if (EMU_SYSTEM == CPS1)
 	if (machine_sound_type == SOUND_QSOUND)
 		qsound_sh_start();
@@ -217,12 +475,16 @@ int sound_init(void)
 	YM2610_sh_start();
 #endif
 
+#if SOUND_RESAMPLER_TAPS
+	sound->update = sound_update_resample;
+#else
 #if (EMU_SYSTEM == CPS1)
 	if (sound->channels == 1)
 		sound->update = sound_update_mono;
 	else
 #endif
 		sound->update = sound_update_stereo;
+#endif
 
 	memset(stream_buffer_left, 0, sizeof(stream_buffer_left));
 	memset(stream_buffer_right, 0, sizeof(stream_buffer_right));
@@ -230,16 +492,41 @@ int sound_init(void)
 	stream_buffer[0] = stream_buffer_left;
 	stream_buffer[1] = stream_buffer_right;
 
-#if (EMU_SYSTEM != CPS2)
-	sample_shift = 2 - option_samplerate;
-	samples_per_update = (((float)sound->frequency / FPS) * 2) / (1 << sample_shift);
+#if SOUND_UPDATE_STREAM
+	sound_set_update_length();
+#endif
 
-	samples_left_over   = samples_per_update;
-	samples_this_update = (uint32_t)samples_per_update;
-	samples_left_over  -= samples_this_update;
+#if SOUND_RESAMPLER_TAPS
+	sound->output_frequency = SOUND_OUTPUT_RATE;
+	sound->output_samples   = (int)(((float)SOUND_OUTPUT_RATE / FPS) * SOUND_UPDATE_FRAMES);
+
+	if (!resampler_init(sound_stream_rate(), SOUND_OUTPUT_RATE, sound->channels, (int)(((float)sound->frequency / FPS) * 2) + 1))
+		return 0;
+#else
+	sound->output_frequency = sound->frequency;
+	sound->output_samples   = sound->samples;
 #endif
 
-	return sound_thread_start();
+	memset(stage_time, 0, sizeof(stage_time));
+	memset(report_time, 0, sizeof(report_time));
+	stage_updates  = 0;
+	report_updates = 0;
+
+	queue_read   = 0;
+	queue_write  = 0;
+	queue_frame  = 0;
+	render_frame = 0;
+
+#if SOUND_EMU_THREAD
+	queue_frames_per_update = SOUND_UPDATE_FRAMES;
+#else
+	queue_frames_per_update = (int)(((float)sound->samples * FPS) / sound->frequency + 0.5);
+	if (queue_frames_per_update < 1) queue_frames_per_update = 1;
+#endif
+
+	queue_active = sound_thread_start();
+
+	return queue_active;
 }
 
 
@@ -261,6 +548,11 @@ void sound_exit(void)
 #endif
 
 	sound_thread_stop();
+	queue_active = 0;
+
+#if SOUND_RESAMPLER_TAPS
+	resampler_exit();
+#endif
 }
 
 
@@ -270,6 +562,9 @@ void sound_exit(void)
 
 void sound_reset(void)
 {
+	/* sound output is disabled while the machine is reset */
+	sound_queue_drain();
+
 #if (EMU_SYSTEM == CPS1)
 	if (machine_sound_type == SOUND_QSOUND)
 		qsound_sh_reset();
@@ -292,8 +587,6 @@ void sound_reset(void)
 #if (EMU_SYSTEM != CPS2)
 void sound_set_samplerate(void)
 {
-	int sample_shift;
-
 #if (EMU_SYSTEM == CPS1)
 	if (machine_sound_type != SOUND_QSOUND)
 		YM2151_set_samplerate();
@@ -301,12 +594,11 @@ void sound_set_samplerate(void)
 	YM2610_set_samplerate();
 #endif
 
-	sample_shift = 2 - option_samplerate;
-	samples_per_update = (((float)sound->frequency / FPS) * 2) / (1 << sample_shift);
+	sound_set_update_length();
 
-	samples_left_over   = samples_per_update;
-	samples_this_update = (uint32_t)samples_per_update;
-	samples_left_over  -= samples_this_update;
+#if SOUND_RESAMPLER_TAPS
+	resampler_set_rate(sound_stream_rate(), SOUND_OUTPUT_RATE);
+#endif
 }
 #endif
 
@@ -322,3 +614,185 @@ void sound_mute(int mute)
 	else
 		sound_thread_enable(option_sound_enable);
 }
+
+
+/*------------------------------------------------------
+	Print time spent in each stage since the last call
+------------------------------------------------------*/
+
+void sound_report(void)
+{
+	uint32_t updates = __atomic_load_n(&stage_updates, __ATOMIC_ACQUIRE);
+	uint32_t time[STAGE_MAX];
+	uint32_t count = updates - report_updates;
+	int i;
+
+	for (i = 0; i < STAGE_MAX; i++)
+	{
+		uint32_t total = stage_time[i];
+
+		time[i] = total - report_time[i];
+		report_time[i] = total;
+	}
+	report_updates = updates;
+
+	if (count)
+	{
+		printf("sound    render %7.1fus  clip %6.1fus  resample %6.1fus  per update (%u updates)\n",
+			(float)time[STAGE_RENDER] / count,
+			(float)time[STAGE_CLIP] / count,
+			(float)time[STAGE_RESAMPLE] / count,
+			count);
+	}
+
+	sound_thread_report();
+}
+
+
+
+/******************************************************************************
+	Sound Register Write Queue
+******************************************************************************/
+
+/*------------------------------------------------------
+	Wait conditions (emulation thread)
+------------------------------------------------------*/
+
+static int sound_queue_space(void)
+{
+	return queue_write - __atomic_load_n(&queue_read, __ATOMIC_ACQUIRE) < SOUND_QUEUE_SIZE;
+}
+
+static int sound_queue_empty(void)
+{
+	return __atomic_load_n(&queue_read, __ATOMIC_ACQUIRE) == queue_write;
+}
+
+
+/*------------------------------------------------------
+	Queue chip register write (emulation thread)
+
+	The write is applied when the frame is rendered, at the
+	same position in the frame as it was made by the CPU.
+------------------------------------------------------*/
+
+void sound_queue_write(void (*handler)(int reg, int data), int reg, int data)
+{
+	uint32_t write = queue_write;
+	SOUND_WRITE *entry;
+
+	if (!queue_active)
+	{
+		(*handler)(reg, data);
+		return;
+	}
+
+	if (!sound_queue_space())
+	{
+#if SOUND_EMU_THREAD
+		/* not reached: the queue holds a whole frame and is emptied when it is closed */
+		(*handler)(reg, data);
+		return;
+#else
+		/* wait for the sound thread to render closed frames, the open one still fits */
+		sound_thread_wakeup();
+		sound_thread_wait(sound_queue_space);
+#endif
+	}
+
+	entry = &sound_queue[write & SOUND_QUEUE_MASK];
+	entry->handler = handler;
+	entry->frame   = queue_frame;
+	entry->offset  = timer_get_frame_offset();
+	entry->reg     = reg;
+	entry->data    = data;
+
+	__atomic_store_n(&queue_write, write + 1, __ATOMIC_RELEASE);
+}
+
+
+/*------------------------------------------------------
+	Close emulated frame (emulation thread)
+
+	With SOUND_EMU_THREAD the frame is rendered here, so
+	the queue is empty again when this returns.
+------------------------------------------------------*/
+
+void sound_queue_frame(void)
+{
+	__atomic_store_n(&queue_frame, queue_frame + 1, __ATOMIC_RELEASE);
+
+	if (queue_active)
+	{
+#if SOUND_EMU_THREAD
+		sound_thread_frame();
+#else
+		sound_thread_wakeup();
+#endif
+	}
+}
+
+
+/*------------------------------------------------------
+	Apply all queued writes without rendering, including
+	those of the open frame, as their timing does not
+	matter without output (rendering thread, while sound
+	output is disabled)
+------------------------------------------------------*/
+
+void sound_queue_flush(void)
+{
+	render_frame = __atomic_load_n(&queue_frame, __ATOMIC_ACQUIRE);
+	sound_queue_apply(render_frame + 1);
+}
+
+
+#if !SOUND_EMU_THREAD
+/*------------------------------------------------------
+	Check if the frames of the next update are closed,
+	or the emulation thread waits for a full queue
+	(sound thread)
+------------------------------------------------------*/
+
+int sound_queue_ready(void)
+{
+	if (__atomic_load_n(&queue_frame, __ATOMIC_ACQUIRE) - render_frame >= (uint32_t)queue_frames_per_update)
+		return 1;
+
+	return __atomic_load_n(&queue_write, __ATOMIC_ACQUIRE) - queue_read >= SOUND_QUEUE_SIZE;
+}
+#endif
+
+
+/*------------------------------------------------------
+	Wait until all queued writes are applied
+	(emulation thread)
+------------------------------------------------------*/
+
+void sound_queue_sync(void)
+{
+	if (!queue_active) return;
+
+	sound_queue_frame();
+	sound_thread_wait(sound_queue_empty);
+}
+
+
+/*------------------------------------------------------
+	Wait until all queued writes are applied without
+	closing the frame (emulation thread, while sound
+	output is disabled)
+------------------------------------------------------*/
+
+void sound_queue_drain(void)
+{
+	if (!queue_active) return;
+
+#if SOUND_EMU_THREAD
+	/* the queue is only used by this thread */
+	sound_queue_flush();
+#else
+	/* the sound thread keeps flushing the queue while output is disabled */
+	sound_thread_wait(sound_queue_empty);
+#endif
+}
@@ -26,5 +26,15 @@ void sound_reset(void);
 void sound_set_samplerate(void);
 #endif
 void sound_mute(int mute);
+void sound_report(void);
+
+void sound_queue_write(void (*handler)(int reg, int data), int reg, int data);
+void sound_queue_frame(void);
+void sound_queue_flush(void);
+#if !SOUND_EMU_THREAD
+int sound_queue_ready(void);
+#endif
+void sound_queue_sync(void);
+void sound_queue_drain(void);
 
 #endif /* SOUND_INTERFACE_H */
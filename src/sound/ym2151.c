@@ -1293,7 +1293,8 @@ static void chan7_calc_noise(void)
 }
 
 
-static void advance_eg(void)
+/* returns the number of samples until the next envelope generator tick */
+static int advance_eg(void)
 {
 	FM_OPM *op;
 	uint32_t i;
@@ -1366,6 +1367,8 @@ static void advance_eg(void)
 			i--;
 		} while (i);
 	}
+
+	return (ym2151->eg_timer_overflow - ym2151->eg_timer + ym2151->eg_timer_add - 1) / ym2151->eg_timer_add;
 }
 
 
@@ -1548,85 +1551,97 @@ static void advance(void)
 
 static void YM2151Update_stereo(int32_t **buffer, int length)
 {
-	int i;
+	int i, j, span;
 	int32_t *bufL = buffer[0];
 	int32_t *bufR = buffer[1];
 	FMSAMPLE_MIX sample;
 
-	for (i = 0; i < length; i++)
+	for (i = 0; i < length; i += span)
 	{
-		advance_eg();
-
-		chan_calc(0);
-		chan_calc(1);
-		chan_calc(2);
-		chan_calc(3);
-		chan_calc(4);
-		chan_calc(5);
-		chan_calc(6);
-		if (ym2151->noise & 0x80)
-			chan7_calc_noise();
-		else
-			chan_calc(7);
-
-		sample  = chanout[0] & ym2151->pan[ 0];
-		sample += chanout[1] & ym2151->pan[ 2];
-		sample += chanout[2] & ym2151->pan[ 4];
-		sample += chanout[3] & ym2151->pan[ 6];
-		sample += chanout[4] & ym2151->pan[ 8];
-		sample += chanout[5] & ym2151->pan[10];
-		sample += chanout[6] & ym2151->pan[12];
-		sample += chanout[7] & ym2151->pan[14];
-		*bufL++ = sample;
-
-		sample  = chanout[0] & ym2151->pan[ 1];
-		sample += chanout[1] & ym2151->pan[ 3];
-		sample += chanout[2] & ym2151->pan[ 5];
-		sample += chanout[3] & ym2151->pan[ 7];
-		sample += chanout[4] & ym2151->pan[ 9];
-		sample += chanout[5] & ym2151->pan[11];
-		sample += chanout[6] & ym2151->pan[13];
-		sample += chanout[7] & ym2151->pan[15];
-		*bufR++ = sample;
-
-		advance();
+		span = advance_eg();
+		if (span > length - i) span = length - i;
+		ym2151->eg_timer += (span - 1) * ym2151->eg_timer_add;
+
+		/* envelope state is constant during the span */
+		for (j = 0; j < span; j++)
+		{
+			chan_calc(0);
+			chan_calc(1);
+			chan_calc(2);
+			chan_calc(3);
+			chan_calc(4);
+			chan_calc(5);
+			chan_calc(6);
+			if (ym2151->noise & 0x80)
+				chan7_calc_noise();
+			else
+				chan_calc(7);
+
+			sample  = chanout[0] & ym2151->pan[ 0];
+			sample += chanout[1] & ym2151->pan[ 2];
+			sample += chanout[2] & ym2151->pan[ 4];
+			sample += chanout[3] & ym2151->pan[ 6];
+			sample += chanout[4] & ym2151->pan[ 8];
+			sample += chanout[5] & ym2151->pan[10];
+			sample += chanout[6] & ym2151->pan[12];
+			sample += chanout[7] & ym2151->pan[14];
+			*bufL++ = sample;
+
+			sample  = chanout[0] & ym2151->pan[ 1];
+			sample += chanout[1] & ym2151->pan[ 3];
+			sample += chanout[2] & ym2151->pan[ 5];
+			sample += chanout[3] & ym2151->pan[ 7];
+			sample += chanout[4] & ym2151->pan[ 9];
+			sample += chanout[5] & ym2151->pan[11];
+			sample += chanout[6] & ym2151->pan[13];
+			sample += chanout[7] & ym2151->pan[15];
+			*bufR++ = sample;
+
+			advance();
+		}
 	}
 }
 
 
 static void YM2151Update_mono(int32_t **buffer, int length)
 {
-	int i;
+	int i, j, span;
 	int32_t *buf = buffer[0];
 	FMSAMPLE_MIX sample;
 
-	for (i = 0; i < length; i++)
+	for (i = 0; i < length; i += span)
 	{
-		advance_eg();
-
-		chan_calc(0);
-		chan_calc(1);
-		chan_calc(2);
-		chan_calc(3);
-		chan_calc(4);
-		chan_calc(5);
-		chan_calc(6);
-		if (ym2151->noise & 0x80)
-			chan7_calc_noise();
-		else
-			chan_calc(7);
-
-		sample  = chanout[0] & ym2151->pan[0];
-		sample += chanout[1] & ym2151->pan[1];
-		sample += chanout[2] & ym2151->pan[2];
-		sample += chanout[3] & ym2151->pan[3];
-		sample += chanout[4] & ym2151->pan[4];
-		sample += chanout[5] & ym2151->pan[5];
-		sample += chanout[6] & ym2151->pan[6];
-		sample += chanout[7] & ym2151->pan[7];
-		*buf++ = sample;
-
-		advance();
+		span = advance_eg();
+		if (span > length - i) span = length - i;
+		ym2151->eg_timer += (span - 1) * ym2151->eg_timer_add;
+
+		/* envelope state is constant during the span */
+		for (j = 0; j < span; j++)
+		{
+			chan_calc(0);
+			chan_calc(1);
+			chan_calc(2);
+			chan_calc(3);
+			chan_calc(4);
+			chan_calc(5);
+			chan_calc(6);
+			if (ym2151->noise & 0x80)
+				chan7_calc_noise();
+			else
+				chan_calc(7);
+
+			sample  = chanout[0] & ym2151->pan[0];
+			sample += chanout[1] & ym2151->pan[1];
+			sample += chanout[2] & ym2151->pan[2];
+			sample += chanout[3] & ym2151->pan[3];
+			sample += chanout[4] & ym2151->pan[4];
+			sample += chanout[5] & ym2151->pan[5];
+			sample += chanout[6] & ym2151->pan[6];
+			sample += chanout[7] & ym2151->pan[7];
+			*buf++ = sample;
+
+			advance();
+		}
 	}
 }
 
@@ -121,6 +121,15 @@
 /* busy flag enulation , The definition of FM_GET_TIME_NOW() is necessary. */
 #define FM_BUSY_FLAG_SUPPORT 1
 
+/* calculate the 4 FM channels in SIMD lanes (SSE2 / NEON through GCC vectors) */
+#ifndef FM_SIMD
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FM_SIMD 1
+#else
+#define FM_SIMD 0
+#endif
+#endif
+
 /*------------------------------------------------------------------------*/
 
 #define FREQ_SH			16  /* 16.16 fixed point (frequency calculations) */
@@ -674,6 +683,13 @@ typedef struct
 	uint8_t		*buf;
 #endif
 
+#if USE_ADPCM_CACHE
+	int16_t		*pcm;			/* decoded sample (NULL = decode from ROM) */
+	uint8_t		*pcm_step;		/* decoder step after each nibble	*/
+	uint32_t		pcm_start;		/* nibble address of pcm[0]	*/
+	uint32_t		pcm_length;		/* sample length in nibbles	*/
+#endif
+
 } ADPCMA;
 
 
@@ -753,6 +769,35 @@ static int32_t	ALIGN_DATA out_delta[4];	/* channel output NONE,LEFT,RIGHT or CEN
 static uint32_t	LFO_AM;			/* runtime LFO calculations helper */
 static int32_t	LFO_PM;			/* runtime LFO calculations helper */
 
+#if FM_SIMD
+typedef int32_t  FM_VEC  __attribute__((vector_size(16)));
+typedef uint32_t FM_UVEC __attribute__((vector_size(16)));
+
+/* 4 channels of operator state, one channel per lane */
+typedef struct
+{
+	FM_CH   *CH[4];			/* channels in lanes */
+	int      pms;			/* some channel uses LFO phase modulation */
+
+	FM_UVEC  phase[4];		/* phase counters (indexed by SLOTx) */
+	FM_UVEC  Incr[4];		/* phase steps */
+	FM_UVEC  vol_out[4];	/* EG output */
+	FM_UVEC  AMmask[4];		/* AM enable flags */
+	FM_UVEC  ams;			/* channel AMS */
+
+	FM_VEC   op1_out[2];	/* op1 output for feedback */
+	FM_VEC   mem_value;		/* delayed sample (MEM) value */
+	FM_VEC   FB;			/* feedback shift */
+	FM_VEC   fb_mask;		/* feedback enabled */
+
+	/* algorithm connections as lane masks */
+	FM_VEC   op1_c1, op1_mem, op1_c2, op1_carrier;
+	FM_VEC   op3_c2, op3_carrier;
+	FM_VEC   op2_mem, op2_carrier;
+	FM_VEC   mem_m2, mem_c2, mem_mem;
+} FM_LANES;
+#endif
+
 
 /* log output level */
 #define LOG_ERR  3      /* ERROR       */
@@ -1366,6 +1411,211 @@ static inline void chan_calc(FM_OPN *OPN, FM_CH *CH)
 	}
 }
 
+#if FM_SIMD
+
+/* load channel state into lanes */
+static void lanes_load(FM_LANES *L, FM_CH **cch)
+{
+	int i, s;
+
+	L->pms = 0;
+
+	for (i = 0; i < 4; i++)
+	{
+		FM_CH *CH = cch[i];
+
+		L->CH[i] = CH;
+		L->pms |= CH->pms;
+
+		for (s = 0; s < 4; s++)
+		{
+			L->phase[s][i]   = CH->SLOT[s].phase;
+			L->Incr[s][i]    = CH->SLOT[s].Incr;
+			L->vol_out[s][i] = CH->SLOT[s].vol_out;
+			L->AMmask[s][i]  = CH->SLOT[s].AMmask;
+		}
+		L->ams[i] = CH->ams;
+
+		L->op1_out[0][i] = CH->op1_out[0];
+		L->op1_out[1][i] = CH->op1_out[1];
+		L->mem_value[i]  = CH->mem_value;
+		L->FB[i]         = CH->FB;
+		L->fb_mask[i]    = CH->FB ? -1 : 0;
+
+		/* algorithm 5 (connect1 == NULL) feeds op1 to c1, mem and c2 */
+		L->op1_c1[i]  = (!CH->connect1 || CH->connect1 == &c1)  ? -1 : 0;
+		L->op1_mem[i] = (!CH->connect1 || CH->connect1 == &mem) ? -1 : 0;
+		L->op1_c2[i]  = (!CH->connect1 || CH->connect1 == &c2)  ? -1 : 0;
+		L->op1_carrier[i] = (CH->connect1 && !L->op1_c1[i] && !L->op1_mem[i] && !L->op1_c2[i]) ? -1 : 0;
+		L->op3_c2[i]  = (CH->connect3 == &c2)  ? -1 : 0;
+		L->op3_carrier[i] = ~L->op3_c2[i];
+		L->op2_mem[i] = (CH->connect2 == &mem) ? -1 : 0;
+		L->op2_carrier[i] = ~L->op2_mem[i];
+		L->mem_m2[i]  = (CH->mem_connect == &m2)  ? -1 : 0;
+		L->mem_c2[i]  = (CH->mem_connect == &c2)  ? -1 : 0;
+		L->mem_mem[i] = (CH->mem_connect == &mem) ? -1 : 0;
+	}
+}
+
+/* store lane state back to the channels */
+static void lanes_store(FM_LANES *L)
+{
+	int i, s;
+
+	for (i = 0; i < 4; i++)
+	{
+		FM_CH *CH = L->CH[i];
+
+		for (s = 0; s < 4; s++)
+			CH->SLOT[s].phase = L->phase[s][i];
+
+		CH->op1_out[0] = L->op1_out[0][i];
+		CH->op1_out[1] = L->op1_out[1][i];
+		CH->mem_value  = L->mem_value[i];
+	}
+}
+
+/* reload EG output after envelope generator update */
+static inline void lanes_load_env(FM_LANES *L)
+{
+	int i, s;
+
+	for (i = 0; i < 4; i++)
+		for (s = 0; s < 4; s++)
+			L->vol_out[s][i] = L->CH[i]->SLOT[s].vol_out;
+}
+
+/* op_calc for 4 lanes (table lookups stay per lane) */
+static inline FM_VEC op_calc_lanes(FM_UVEC phase, FM_UVEC env, FM_VEC pm)
+{
+	FM_VEC idx = ((((FM_VEC)(phase & ~FREQ_MASK)) + pm) >> FREQ_SH) & SIN_MASK;
+	FM_VEC out;
+	uint32_t e;
+	int i;
+
+	for (i = 0; i < 4; i++)
+	{
+		if (env[i] < ENV_QUIET)
+		{
+			e = (env[i] << 3) + sin_tab[idx[i]];
+			out[i] = (e < TL_TAB_LEN) ? tl_tab[e] : 0;
+		}
+		else
+			out[i] = 0;
+	}
+
+	return out;
+}
+
+/* phase increments with LFO phase modulation */
+static inline void lanes_pm_incr(FM_OPN *OPN, FM_LANES *L, FM_UVEC *incr)
+{
+	int i, s;
+
+	for (s = 0; s < 4; s++)
+		incr[s] = L->Incr[s];
+
+	for (i = 0; i < 4; i++)
+	{
+		FM_CH *CH = L->CH[i];
+
+		if (CH->pms)
+		{
+			uint32_t block_fnum = CH->block_fnum;
+
+			uint32_t fnum_lfo = ((block_fnum & 0x7f0) >> 4) * 32 * 8;
+			int32_t lfo_fn_table_index_offset = lfo_pm_table[fnum_lfo + CH->pms + LFO_PM];
+
+			if (lfo_fn_table_index_offset)	/* LFO phase modulation active */
+			{
+				uint8_t  blk;
+				uint32_t fn;
+				int kc, fc;
+
+				block_fnum = block_fnum*2 + lfo_fn_table_index_offset;
+
+				blk = (block_fnum & 0x7000) >> 12;
+				fn  = block_fnum & 0xfff;
+
+				/* keyscale code */
+				kc = (blk << 2) | opn_fktable[fn >> 8];
+				/* phase increment counter */
+				fc = OPN->fn_table[fn] >> (7 - blk);
+
+				for (s = 0; s < 4; s++)
+					incr[s][i] = ((fc + CH->SLOT[s].DT[kc]) * CH->SLOT[s].mul) >> 1;
+			}
+		}
+	}
+}
+
+/* chan_calc for 4 lanes, results go to out[] */
+static inline void chan_calc_lanes(FM_OPN *OPN, FM_LANES *L, FM_VEC *out)
+{
+	FM_UVEC AM = (FM_UVEC){ LFO_AM, LFO_AM, LFO_AM, LFO_AM } >> L->ams;
+	FM_UVEC env1 = L->vol_out[SLOT1] + (AM & L->AMmask[SLOT1]);
+	FM_UVEC env2 = L->vol_out[SLOT2] + (AM & L->AMmask[SLOT2]);
+	FM_UVEC env3 = L->vol_out[SLOT3] + (AM & L->AMmask[SLOT3]);
+	FM_UVEC env4 = L->vol_out[SLOT4] + (AM & L->AMmask[SLOT4]);
+	FM_VEC op1 = L->op1_out[0];
+	FM_VEC fb, r, vm2, vc1, vc2, vmem, vout;
+
+	/* restore delayed sample (MEM) value to m2 or c2 */
+	vm2  = L->mem_value & L->mem_m2;
+	vc2  = L->mem_value & L->mem_c2;
+	vmem = L->mem_value & L->mem_mem;
+
+	vc1   = op1 & L->op1_c1;
+	vmem += op1 & L->op1_mem;
+	vc2  += op1 & L->op1_c2;
+	vout  = op1 & L->op1_carrier;
+
+	/* SLOT 1 */
+	fb = ((L->op1_out[0] + L->op1_out[1]) << L->FB) & L->fb_mask;
+	L->op1_out[0] = L->op1_out[1];
+	L->op1_out[1] = op_calc_lanes(L->phase[SLOT1], env1, fb);
+
+	/* SLOT 3 */
+	r = op_calc_lanes(L->phase[SLOT3], env3, vm2 << 15);
+	vc2  += r & L->op3_c2;
+	vout += r & L->op3_carrier;
+
+	/* SLOT 2 */
+	r = op_calc_lanes(L->phase[SLOT2], env2, vc1 << 15);
+	vmem += r & L->op2_mem;
+	vout += r & L->op2_carrier;
+
+	/* SLOT 4 */
+	vout += op_calc_lanes(L->phase[SLOT4], env4, vc2 << 15);
+
+	/* store current MEM */
+	L->mem_value = vmem;
+
+	/* update phase counters AFTER output calculations */
+	if (L->pms)
+	{
+		FM_UVEC incr[4];
+
+		lanes_pm_incr(OPN, L, incr);
+
+		L->phase[SLOT1] += incr[SLOT1];
+		L->phase[SLOT2] += incr[SLOT2];
+		L->phase[SLOT3] += incr[SLOT3];
+		L->phase[SLOT4] += incr[SLOT4];
+	}
+	else
+	{
+		L->phase[SLOT1] += L->Incr[SLOT1];
+		L->phase[SLOT2] += L->Incr[SLOT2];
+		L->phase[SLOT3] += L->Incr[SLOT3];
+		L->phase[SLOT4] += L->Incr[SLOT4];
+	}
+
+	*out = vout;
+}
+
+#endif /* FM_SIMD */
+
 /* update phase increment and envelope generator */
 static inline void refresh_fc_eg_slot(FM_SLOT *SLOT , int fc , int kc )
 {
@@ -2217,6 +2467,200 @@ static void OPNB_ADPCMA_init_table(void)
 	}
 }
 
+#if USE_ADPCM_CACHE
+
+/* ADPCM-A decode cache : whole samples decoded at key on */
+#define ADPCMA_CACHE_ENTRIES	256
+#define ADPCMA_CACHE_BUDGET		(8*1024*1024)	/* bytes of decoded data */
+#define ADPCMA_CACHE_BYTES(n)	((n) * (sizeof(int16_t) + sizeof(uint8_t)))
+
+typedef struct
+{
+	uint32_t	start;			/* nibble address (0 = unused entry) */
+	uint32_t	length;			/* length in nibbles */
+	uint32_t	stamp;			/* last use */
+	int16_t		*pcm;			/* accumulator after each nibble, followed by the step table */
+} ADPCMA_CACHE;
+
+static ADPCMA_CACHE adpcma_cache[ADPCMA_CACHE_ENTRIES];
+static uint32_t adpcma_cache_size;
+static uint32_t adpcma_cache_stamp;
+
+
+static void adpcma_cache_free(void)
+{
+	int i;
+
+	for (i = 0; i < ADPCMA_CACHE_ENTRIES; i++)
+		free(adpcma_cache[i].pcm);
+
+	memset(adpcma_cache, 0, sizeof(adpcma_cache));
+	adpcma_cache_size = 0;
+	adpcma_cache_stamp = 0;
+}
+
+/* drop the least recently used entry that no channel is playing */
+static int adpcma_cache_evict(void)
+{
+	ADPCMA_CACHE *entry, *oldest = NULL;
+	int c;
+
+	for (entry = adpcma_cache; entry < &adpcma_cache[ADPCMA_CACHE_ENTRIES]; entry++)
+	{
+		if (!entry->pcm) continue;
+
+		for (c = 0; c < 6; c++)
+			if (YM2610.adpcma[c].pcm == entry->pcm) break;
+
+		if (c == 6 && (!oldest || adpcma_cache_stamp - entry->stamp > adpcma_cache_stamp - oldest->stamp))
+			oldest = entry;
+	}
+
+	if (!oldest) return 0;
+
+	adpcma_cache_size -= ADPCMA_CACHE_BYTES(oldest->length);
+	free(oldest->pcm);
+	memset(oldest, 0, sizeof(ADPCMA_CACHE));
+	return 1;
+}
+
+/* find or decode the sample at start..end (NULL = play from ROM) */
+static ADPCMA_CACHE *adpcma_cache_lookup(uint32_t start, uint32_t end)
+{
+	ADPCMA_CACHE *entry, *slot = NULL;
+	uint32_t length, addr, i;
+	int32_t acc = 0, step = 0;
+	uint8_t *steps_out, byte = 0, data;
+
+	start <<= 1;
+	length = ((end << 1) - start) & ((1 << 21) - 1);
+
+	if (!length || ((start + length - 1) >> 1) >= pcmsizeA || ADPCMA_CACHE_BYTES(length) > ADPCMA_CACHE_BUDGET / 4)
+		return NULL;
+
+	adpcma_cache_stamp++;
+
+	for (entry = adpcma_cache; entry < &adpcma_cache[ADPCMA_CACHE_ENTRIES]; entry++)
+	{
+		if (entry->pcm && entry->start == start && entry->length == length)
+		{
+			entry->stamp = adpcma_cache_stamp;
+			return entry;
+		}
+		if (!entry->pcm && !slot) slot = entry;
+	}
+
+	while (adpcma_cache_size + ADPCMA_CACHE_BYTES(length) > ADPCMA_CACHE_BUDGET || !slot)
+	{
+		if (!adpcma_cache_evict()) return NULL;
+
+		for (slot = adpcma_cache; slot->pcm; slot++) ;
+	}
+
+	if ((slot->pcm = malloc(ADPCMA_CACHE_BYTES(length))) == NULL)
+		return NULL;
+
+	/* same decoder as OPNB_ADPCMA_calc_chan */
+	steps_out = (uint8_t *)(slot->pcm + length);
+
+	for (i = 0, addr = start; i < length; i++, addr++)
+	{
+		if (addr & 1)
+			data = byte & 0x0f;
+		else
+		{
+			byte = pcmbufA[addr >> 1];
+			data = (byte >> 4) & 0x0f;
+		}
+
+		acc += jedi_table[step + data];
+
+		/* extend 12-bit signed int */
+		if (acc & 0x800)
+			acc |= ~0xfff;
+		else
+			acc &= 0xfff;
+
+		step += step_inc[data & 7];
+		Limit(step, 48*16, 0*16);
+
+		slot->pcm[i] = acc;
+		steps_out[i] = step >> 4;
+	}
+
+	slot->start  = start;
+	slot->length = length;
+	slot->stamp  = adpcma_cache_stamp;
+	adpcma_cache_size += ADPCMA_CACHE_BYTES(length);
+
+	return slot;
+}
+
+/* bring the ROM decoder state up to the cached playback position */
+static void adpcma_cache_sync(ADPCMA *ch)
+{
+	uint32_t pos = ch->now_addr - ch->pcm_start;
+
+	if (pos)
+	{
+		ch->adpcma_acc  = ch->pcm[pos - 1];
+		ch->adpcma_step = ch->pcm_step[pos - 1] << 4;
+		ch->now_data    = pcmbufA[(ch->now_addr - 1) >> 1];
+	}
+}
+
+static void adpcma_cache_detach(ADPCMA *ch)
+{
+	adpcma_cache_sync(ch);
+	ch->pcm = NULL;
+}
+
+static void adpcma_cache_attach(ADPCMA *ch)
+{
+	ADPCMA_CACHE *entry = adpcma_cache_lookup(ch->start, ch->end);
+
+	if (entry)
+	{
+		ch->pcm        = entry->pcm;
+		ch->pcm_step   = (uint8_t *)(entry->pcm + entry->length);
+		ch->pcm_start  = entry->start;
+		ch->pcm_length = entry->length;
+	}
+}
+
+/* ADPCM A : one channel output from the decoded sample */
+static void OPNB_ADPCMA_calc_chan_cached(ADPCMA *ch)
+{
+	ch->now_step += ch->step;
+	if (ch->now_step >= (1 << ADPCM_SHIFT))
+	{
+		uint32_t pos = ch->now_addr - ch->pcm_start + (ch->now_step >> ADPCM_SHIFT);
+
+		ch->now_step &= (1 << ADPCM_SHIFT) - 1;
+
+		/* the end address is reached before the last nibble of this step */
+		if (pos > ch->pcm_length)
+		{
+			ch->now_addr = ch->pcm_start + ch->pcm_length;
+			adpcma_cache_detach(ch);
+			ch->flag = 0;
+			YM2610.adpcm_arrivedEndAddress |= ch->flagMask;
+			return;
+		}
+
+		ch->now_addr   = ch->pcm_start + pos;
+		ch->adpcma_acc = ch->pcm[pos - 1];
+
+		/* calc pcm * volume data */
+		ch->adpcma_out = ((ch->adpcma_acc * ch->vol_mul) >> ch->vol_shift) & ~3;	/* multiply, shift and mask out 2 LSB bits */
+	}
+
+	/* output for work of output channels (out_adpcma[OPNxxxx]) */
+	*ch->pan += ch->adpcma_out;
+}
+
+#endif /* USE_ADPCM_CACHE */
+
 /* ADPCM A (Non control type) : calculate one channel output */
 #if (EMU_SYSTEM == MVS) && !defined(LARGE_MEMORY)
 static void OPNB_ADPCMA_calc_chan_static(int c, ADPCMA *ch)
@@ -2227,6 +2671,14 @@ static void OPNB_ADPCMA_calc_chan(int c, ADPCMA *ch)
 	uint32_t step;
 	uint8_t  data;
 
+#if USE_ADPCM_CACHE
+	if (ch->pcm)
+	{
+		OPNB_ADPCMA_calc_chan_cached(ch);
+		return;
+	}
+#endif
+
 	ch->now_step += ch->step;
 	if (ch->now_step >= (1 << ADPCM_SHIFT))
 	{
@@ -2364,6 +2816,10 @@ static void OPNB_ADPCMA_write(int r, int v)
 			{
 				if ((v >> c) & 1)
 				{
+#if USE_ADPCM_CACHE
+					if (adpcma[c].pcm)
+						adpcma_cache_detach(&adpcma[c]);
+#endif
 					/**** start adpcm ****/
 					adpcma[c].step        = (uint32_t)((float)(1 << ADPCM_SHIFT) * ((float)YM2610.OPN.ST.freqbase) / 3.0);
 					adpcma[c].now_addr    = adpcma[c].start << 1;
@@ -2380,6 +2836,10 @@ static void OPNB_ADPCMA_write(int r, int v)
 #else
 					if (pcmbufA == NULL || adpcma[c].start >= pcmsizeA)
 						adpcma[c].flag = 0;
+#endif
+#if USE_ADPCM_CACHE
+					if (adpcma[c].flag && pcmbufA)
+						adpcma_cache_attach(&adpcma[c]);
 #endif
 				}
 			}
@@ -2388,8 +2848,16 @@ static void OPNB_ADPCMA_write(int r, int v)
 		{
 			/* KEY OFF */
 			for (c = 0; c < 6; c++)
+			{
 				if ((v >> c) & 1)
+				{
+#if USE_ADPCM_CACHE
+					if (adpcma[c].pcm)
+						adpcma_cache_detach(&adpcma[c]);
+#endif
 					adpcma[c].flag = 0;
+				}
+			}
 		}
 		break;
 
@@ -2460,6 +2928,11 @@ static void OPNB_ADPCMA_write(int r, int v)
 
 		case 0x120:
 		case 0x128:
+#if USE_ADPCM_CACHE
+			/* the cached sample no longer matches, keep playing from ROM */
+			if (adpcma[c].pcm)
+				adpcma_cache_detach(&adpcma[c]);
+#endif
 			adpcma[c].end  = ((YM2610.regs[0x128 + c] << 8) | YM2610.regs[0x120 + c]) << ADPCMA_ADDRESS_SHIFT;
 			adpcma[c].end += (1 << ADPCMA_ADDRESS_SHIFT) - 1;
 			if ( pcmsizeA > 0x1000000 )	// Support expanded VROM
@@ -2798,10 +3271,14 @@ static void OPNB_ADPCMB_write(ADPCMB *adpcmb, int r, int v)
 static void YM2610Update(int32_t **buffer, int length)
 {
 	FM_OPN *OPN = &YM2610.OPN;
-	int i, j, outn;
+	int i, j, ch, span, outn;
 	int32_t *bufL, *bufR;
 	FMSAMPLE_MIX lt, rt;
 	FM_CH *cch[6];
+#if FM_SIMD
+	FM_LANES lanes;
+	FM_VEC fm;
+#endif
 
 	bufL = buffer[0];
 	bufR = buffer[1];
@@ -2833,26 +3310,13 @@ static void YM2610Update(int32_t **buffer, int length)
 	/* calc SSG count */
 	outn = SSG_calc_count(length);
 
-	/* buffering */
-	for (i = 0; i < length; i++)
-	{
-		advance_lfo(OPN);
-
-		/* clear output acc. */
-		out_adpcma[OUTD_LEFT] = out_adpcma[OUTD_RIGHT]= out_adpcma[OUTD_CENTER] = 0;
-#if (EMU_SYSTEM == MVS)
-		out_delta[OUTD_LEFT] = out_delta[OUTD_RIGHT]= out_delta[OUTD_CENTER] = 0;
+#if FM_SIMD
+	lanes_load(&lanes, cch);
 #endif
 
-		/* clear outputs */
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-		out_fm[4] = 0;
-		out_fm[5] = 0;
-
-		/* clear outputs SSG */
-		out_ssg = 0;
-
+	/* buffering */
+	for (i = 0; i < length; i += span)
+	{
 		/* advance envelope generator */
 		OPN->eg_timer += OPN->eg_timer_add;
 		while (OPN->eg_timer >= OPN->eg_timer_overflow)
@@ -2864,55 +3328,96 @@ static void YM2610Update(int32_t **buffer, int length)
 			advance_eg_channel(OPN, &cch[1]->SLOT[SLOT1]);
 			advance_eg_channel(OPN, &cch[2]->SLOT[SLOT1]);
 			advance_eg_channel(OPN, &cch[3]->SLOT[SLOT1]);
+#if FM_SIMD
+			lanes_load_env(&lanes);
+#endif
 		}
 
-		/* calculate FM */
-		chan_calc(OPN, cch[0]);	/*remapped to 1*/
-		chan_calc(OPN, cch[1]);	/*remapped to 2*/
-		chan_calc(OPN, cch[2]);	/*remapped to 4*/
-		chan_calc(OPN, cch[3]);	/*remapped to 5*/
+		/* samples until the next envelope generator tick */
+		span = (OPN->eg_timer_overflow - OPN->eg_timer + OPN->eg_timer_add - 1) / OPN->eg_timer_add;
+		if (span > length - i) span = length - i;
+		OPN->eg_timer += (span - 1) * OPN->eg_timer_add;
 
-		/* calculate SSG */
-		outn = SSG_CALC(outn);
+		/* envelope state is constant during the span */
+		for (j = 0; j < span; j++)
+		{
+			advance_lfo(OPN);
 
+			/* clear output acc. */
+			out_adpcma[OUTD_LEFT] = out_adpcma[OUTD_RIGHT]= out_adpcma[OUTD_CENTER] = 0;
 #if (EMU_SYSTEM == MVS)
-		/* deltaT ADPCM */
-		if (YM2610.adpcmb.portstate & 0x80)
-			OPNB_ADPCMB_calc(&YM2610.adpcmb);
+			out_delta[OUTD_LEFT] = out_delta[OUTD_RIGHT]= out_delta[OUTD_CENTER] = 0;
 #endif
 
-		for (j = 0; j < 6; j++)
-		{
-			/* ADPCM */
-			if (YM2610.adpcma[j].flag)
-				OPNB_ADPCMA_calc_chan(j, &YM2610.adpcma[j]);
-		}
+			/* clear outputs */
+			out_fm[1] = 0;
+			out_fm[2] = 0;
+			out_fm[4] = 0;
+			out_fm[5] = 0;
+
+			/* clear outputs SSG */
+			out_ssg = 0;
+
+			/* calculate FM */
+#if FM_SIMD
+			chan_calc_lanes(OPN, &lanes, &fm);
+			out_fm[1] = fm[0];
+			out_fm[2] = fm[1];
+			out_fm[4] = fm[2];
+			out_fm[5] = fm[3];
+#else
+			chan_calc(OPN, cch[0]);	/*remapped to 1*/
+			chan_calc(OPN, cch[1]);	/*remapped to 2*/
+			chan_calc(OPN, cch[2]);	/*remapped to 4*/
+			chan_calc(OPN, cch[3]);	/*remapped to 5*/
+#endif
+
+			/* calculate SSG */
+			outn = SSG_CALC(outn);
 
-		/* buffering */
-		lt =  out_adpcma[OUTD_LEFT]  + out_adpcma[OUTD_CENTER];
-		rt =  out_adpcma[OUTD_RIGHT] + out_adpcma[OUTD_CENTER];
+#if (EMU_SYSTEM == MVS)
+			/* deltaT ADPCM */
+			if (YM2610.adpcmb.portstate & 0x80)
+				OPNB_ADPCMB_calc(&YM2610.adpcmb);
+#endif
+
+			for (ch = 0; ch < 6; ch++)
+			{
+				/* ADPCM */
+				if (YM2610.adpcma[ch].flag)
+					OPNB_ADPCMA_calc_chan(ch, &YM2610.adpcma[ch]);
+			}
+
+			/* buffering */
+			lt =  out_adpcma[OUTD_LEFT]  + out_adpcma[OUTD_CENTER];
+			rt =  out_adpcma[OUTD_RIGHT] + out_adpcma[OUTD_CENTER];
 
 #if (EMU_SYSTEM == MVS)
-		lt += (out_delta[OUTD_LEFT]  + out_delta[OUTD_CENTER]) >> 9;
-		rt += (out_delta[OUTD_RIGHT] + out_delta[OUTD_CENTER]) >> 9;
+			lt += (out_delta[OUTD_LEFT]  + out_delta[OUTD_CENTER]) >> 9;
+			rt += (out_delta[OUTD_RIGHT] + out_delta[OUTD_CENTER]) >> 9;
 #endif
 
-		lt += out_ssg;
-		rt += out_ssg;
+			lt += out_ssg;
+			rt += out_ssg;
 
-		lt += (out_fm[1] >> 1) & OPN->pan[2];	/* the shift right was verified on real chip */
-		rt += (out_fm[1] >> 1) & OPN->pan[3];
-		lt += (out_fm[2] >> 1) & OPN->pan[4];
-		rt += (out_fm[2] >> 1) & OPN->pan[5];
+			lt += (out_fm[1] >> 1) & OPN->pan[2];	/* the shift right was verified on real chip */
+			rt += (out_fm[1] >> 1) & OPN->pan[3];
+			lt += (out_fm[2] >> 1) & OPN->pan[4];
+			rt += (out_fm[2] >> 1) & OPN->pan[5];
 
-		lt += (out_fm[4] >> 1) & OPN->pan[8];
-		rt += (out_fm[4] >> 1) & OPN->pan[9];
-		lt += (out_fm[5] >> 1) & OPN->pan[10];
-		rt += (out_fm[5] >> 1) & OPN->pan[11];
+			lt += (out_fm[4] >> 1) & OPN->pan[8];
+			rt += (out_fm[4] >> 1) & OPN->pan[9];
+			lt += (out_fm[5] >> 1) & OPN->pan[10];
+			rt += (out_fm[5] >> 1) & OPN->pan[11];
 
-		*bufL++ = lt;
-		*bufR++ = rt;
+			*bufL++ = lt;
+			*bufR++ = rt;
+		}
 	}
+
+#if FM_SIMD
+	lanes_store(&lanes);
+#endif
 }
 
 
@@ -2929,6 +3434,9 @@ void YM2610Init(int clock, void *pcmroma, int pcmsizea,
 	sound->callback  = YM2610Update;
 
 	/* clear */
+#if USE_ADPCM_CACHE
+	adpcma_cache_free();
+#endif
 	memset(&YM2610, 0, sizeof(YM2610));
 	memset(&SSG, 0, sizeof(SSG));
 
@@ -2984,6 +3492,14 @@ void YM2610Init(int clock, void *pcmroma, int pcmsizea,
 	YM2610Reset();
 }
 
+/* release decoded sample data */
+void YM2610Exit(void)
+{
+#if USE_ADPCM_CACHE
+	adpcma_cache_free();
+#endif
+}
+
 /* reset one of chip */
 void YM2610Reset(void)
 {
@@ -3035,6 +3551,9 @@ void YM2610Reset(void)
 		YM2610.adpcma[i].adpcma_acc  = 0;
 		YM2610.adpcma[i].adpcma_step = 0;
 		YM2610.adpcma[i].adpcma_out  = 0;
+#if USE_ADPCM_CACHE
+		YM2610.adpcma[i].pcm         = NULL;
+#endif
 #if (EMU_SYSTEM == MVS) && !defined(LARGE_MEMORY)
 		if (pcm_cache_enable)
 		{
@@ -3102,6 +3621,40 @@ void YM2610_set_samplerate(void)
 }
 
 
+/* YM2610 register write (sound thread) */
+/* r = register */
+/* v = value    */
+static void YM2610WriteReg(int r, int v)
+{
+	switch (r & 0x1f0)
+	{
+	case 0x000:	/* SSG section */
+		SSG_write(r, v);
+		break;
+
+#if (EMU_SYSTEM == MVS)
+	case 0x010:	/* DeltaT ADPCM */
+		OPNB_ADPCMB_write(&YM2610.adpcmb, r, v);
+		break;
+#endif
+
+	case 0x020:	/* Mode Register */
+		OPNWriteMode(&YM2610.OPN, r, v);
+		break;
+
+	case 0x100:	/* 100-12f : ADPCM A section */
+	case 0x110:
+	case 0x120:
+		OPNB_ADPCMA_write(r, v);
+		break;
+
+	default:	/* OPN section */
+		OPNWriteReg(&YM2610.OPN, r, v);
+		break;
+	}
+}
+
+
 /* YM2610 write */
 /* a = address */
 /* v = value   */
@@ -3131,7 +3684,7 @@ int YM2610Write(int a, uint8_t v)
 		{
 		case 0x00:	/* SSG section */
 			/* Write data to SSG emulator */
-			SSG_write(addr, v);
+			sound_queue_write(YM2610WriteReg, addr, v);
 			break;
 
 		case 0x10: /* DeltaT ADPCM */
@@ -3148,7 +3701,7 @@ int YM2610Write(int a, uint8_t v)
 			case 0x19:	/* delta-n L */
 			case 0x1a:	/* delta-n H */
 			case 0x1b:	/* volume */
-				OPNB_ADPCMB_write(&YM2610.adpcmb, addr, v);
+				sound_queue_write(YM2610WriteReg, addr, v);
 				break;
 #endif
 
@@ -3171,12 +3724,16 @@ int YM2610Write(int a, uint8_t v)
 			break;
 
 		case 0x20:	/* Mode Register */
-			OPNWriteMode(OPN, addr, v);
+			/* timer registers are handled at once so that timer irqs stay in time */
+			if (addr >= 0x24 && addr <= 0x27)
+				OPNWriteMode(OPN, addr, v);
+			else
+				sound_queue_write(YM2610WriteReg, addr, v);
 			break;
 
 		default:	/* OPN section */
 			/* write register */
-			OPNWriteReg(OPN, addr, v);
+			sound_queue_write(YM2610WriteReg, addr, v);
 			break;
 		}
 		break;
@@ -3193,11 +3750,7 @@ int YM2610Write(int a, uint8_t v)
 		YM2610UpdateRequest();
 		addr = YM2610.OPN.ST.address | 0x100;
 		YM2610.regs[addr] = v;
-		if (addr < 0x130)
-			/* 100-12f : ADPCM A section */
-			OPNB_ADPCMA_write(addr, v);
-		else
-			OPNWriteReg(OPN, addr, v);
+		sound_queue_write(YM2610WriteReg, addr, v);
 		break;
 	}
 
@@ -3305,6 +3858,10 @@ STATE_SAVE( ym2610 )
 
 	for (ch = 0; ch < 6; ch++)
 	{
+#if USE_ADPCM_CACHE
+		if (YM2610.adpcma[ch].pcm)
+			adpcma_cache_sync(&YM2610.adpcma[ch]);
+#endif
 		state_save_byte(&YM2610.adpcma[ch].flag, 1);
 		state_save_byte(&YM2610.adpcma[ch].now_data, 1);
 		state_save_long(&YM2610.adpcma[ch].now_addr, 1);
@@ -3375,6 +3932,9 @@ STATE_LOAD( ym2610 )
 		state_load_long(&YM2610.adpcma[ch].adpcma_acc, 1);
 		state_load_long(&YM2610.adpcma[ch].adpcma_step, 1);
 		state_load_long(&YM2610.adpcma[ch].adpcma_out, 1);
+#if USE_ADPCM_CACHE
+		YM2610.adpcma[ch].pcm = NULL;
+#endif
 	}
 
 #if (EMU_SYSTEM == MVS)
@@ -27,6 +27,7 @@ void YM2610Init(int baseclock, void *pcmroma, int pcmsizea,
 				FM_TIMERHANDLER TimerHandler,
 				FM_IRQHANDLER IRQHandler);
 
+void YM2610Exit(void);
 void YM2610Reset(void);
 int YM2610Write(int addr, uint8_t value);
 uint8_t YM2610Read(int addr);
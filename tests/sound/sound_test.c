@@ -0,0 +1,133 @@
+/******************************************************************************
+
+	sound_test.c
+
+	Sound core bit-exactness tests
+
+******************************************************************************/
+
+#include "sound_test.h"
+
+#define TEST_BUFFER_SIZE	4096
+
+
+/******************************************************************************
+	Emulator globals used by the sound chips
+******************************************************************************/
+
+static struct sound_t sound_info;
+
+struct sound_t *sound = &sound_info;
+int option_samplerate = 2;
+int machine_sound_type;
+
+
+/*--------------------------------------------------------
+	Apply register writes at once (no sound thread)
+--------------------------------------------------------*/
+
+void sound_queue_write(void (*handler)(int reg, int data), int reg, int data)
+{
+	handler(reg, data);
+}
+
+
+/******************************************************************************
+	Local Variables
+******************************************************************************/
+
+static int32_t ALIGN_DATA buffer_left[TEST_BUFFER_SIZE];
+static int32_t ALIGN_DATA buffer_right[TEST_BUFFER_SIZE];
+
+static uint32_t random_state = 1;
+static uint64_t hash = 14695981039346656037ULL;	/* FNV-1a */
+static uint32_t samples;
+static uint32_t nonzero;
+
+
+/******************************************************************************
+	Global Functions
+******************************************************************************/
+
+/*--------------------------------------------------------
+	Pseudo random numbers (same sequence on every host)
+--------------------------------------------------------*/
+
+void sound_test_seed(uint32_t seed)
+{
+	random_state = seed;
+}
+
+
+uint32_t sound_test_random(void)
+{
+	random_state = random_state * 1103515245 + 12345;
+	return random_state >> 8;
+}
+
+
+void sound_test_fill(uint8_t *buf, uint32_t length)
+{
+	uint32_t i;
+
+	for (i = 0; i < length; i++)
+		buf[i] = sound_test_random();
+}
+
+
+/*--------------------------------------------------------
+	Add a value (e.g. a status register) to the hash
+--------------------------------------------------------*/
+
+void sound_test_hash(uint32_t value)
+{
+	hash = (hash ^ value) * 1099511628211ULL;
+}
+
+
+/*--------------------------------------------------------
+	Render a block and add it to the hash
+--------------------------------------------------------*/
+
+void sound_test_render(int length)
+{
+	int32_t *buffer[2] = { buffer_left, buffer_right };
+	int i, ch;
+
+	if (length > TEST_BUFFER_SIZE) length = TEST_BUFFER_SIZE;
+
+	memset(buffer_left, 0, sizeof(buffer_left));
+	memset(buffer_right, 0, sizeof(buffer_right));
+
+	sound->callback(buffer, length);
+
+	for (i = 0; i < length; i++)
+	{
+		for (ch = 0; ch < sound->channels; ch++)
+		{
+			sound_test_hash(buffer[ch][i]);
+			nonzero += buffer[ch][i] != 0;
+		}
+	}
+	samples += length;
+}
+
+
+/*--------------------------------------------------------
+	Print the hash and compare it with the expected one
+--------------------------------------------------------*/
+
+int sound_test_finish(const char *expected)
+{
+	char result[17];
+
+	sprintf(result, "%016llx", (unsigned long long)hash);
+	printf("%s (%u samples, %u non-zero)\n", result, samples, nonzero);
+
+	if (expected && strcmp(result, expected) != 0)
+	{
+		printf("expected %s\n", expected);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,30 @@
+/******************************************************************************
+
+	sound_test.h
+
+	Sound core bit-exactness tests
+
+******************************************************************************/
+
+#ifndef SOUND_TEST_H
+#define SOUND_TEST_H
+
+#include "emumain.h"
+
+/*
+	Each test drives one sound chip with a pseudo random register stream,
+	renders blocks of random length through sound->callback and hashes the
+	samples. The expected hash (from the command line) was recorded
+	from the chip before it was optimized, so every build variant (SIMD on
+	or off, ADPCM cache on or off) has to reproduce the original output.
+	Without an expected hash the test only prints the result.
+*/
+
+void sound_test_seed(uint32_t seed);
+uint32_t sound_test_random(void);
+void sound_test_fill(uint8_t *buf, uint32_t length);
+void sound_test_hash(uint32_t value);
+void sound_test_render(int length);
+int sound_test_finish(const char *expected);
+
+#endif /* SOUND_TEST_H */
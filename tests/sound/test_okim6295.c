@@ -0,0 +1,140 @@
+/******************************************************************************
+
+	test_okim6295.c
+
+	OKIM6295 bit-exactness test (mixed by the CPS1 YM2151 callback)
+
+******************************************************************************/
+
+#include "sound_test.h"
+#include "sound/ym2151.h"
+#include "sound/okim6295.h"
+
+#define SAMPLE_ROM_SIZE	0x40000
+#define ITERATIONS		5000
+
+
+/******************************************************************************
+	Emulator functions used by the YM2151 and OKIM6295
+******************************************************************************/
+
+uint8_t *memory_region_sound1;
+uint32_t memory_length_sound1 = SAMPLE_ROM_SIZE;
+
+
+int timer_enable(int which, int enable)
+{
+	return 0;
+}
+
+
+void timer_adjust(int which, float duration, int param, void (*callback)(int raram))
+{
+}
+
+
+/******************************************************************************
+	Local Variables
+******************************************************************************/
+
+static uint8_t sample_rom[SAMPLE_ROM_SIZE];
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+static void irq_handler(int irq)
+{
+}
+
+
+/*--------------------------------------------------------
+	Sample table: mostly short samples, the upper half
+	shares a few start addresses (cached decode reuse)
+--------------------------------------------------------*/
+
+static void build_sample_table(void)
+{
+	uint8_t *entry;
+	int i, start, length;
+
+	sound_test_fill(sample_rom, SAMPLE_ROM_SIZE);
+
+	for (i = 1; i < 128; i++)
+	{
+		start  = 0x400 + sound_test_random() % 0x3e000;
+		length = sound_test_random() % ((sound_test_random() & 3) ? 0x400 : 0x1800);
+
+		if (i > 64) start = 0x400 + (i & 7) * 0x1000;
+		if (start + length > SAMPLE_ROM_SIZE - 1) length = SAMPLE_ROM_SIZE - 1 - start;
+
+		entry = &sample_rom[i * 8];
+		entry[0] = start >> 16;
+		entry[1] = start >> 8;
+		entry[2] = start;
+		entry[3] = (start + length) >> 16;
+		entry[4] = (start + length) >> 8;
+		entry[5] = start + length;
+	}
+}
+
+
+static void write_command(void)
+{
+	int k = sound_test_random() % 8;
+	int data;
+
+	if (k < 5)
+	{
+		/* start a sample on one voice */
+		OKIM6295_data_w(0, 0x80 | (1 + sound_test_random() % 127));
+		OKIM6295_data_w(0, ((1 << (sound_test_random() % 4)) << 4) | (sound_test_random() & 15));
+	}
+	else if (k < 6)
+	{
+		/* stop voices */
+		OKIM6295_data_w(0, (sound_test_random() & 15) << 3);
+	}
+	else if (k == 7 && (sound_test_random() & 31) == 0)
+	{
+		OKIM6295_set_pin7_w(0, sound_test_random() & 1);
+	}
+}
+
+
+/******************************************************************************
+	Main
+******************************************************************************/
+
+int main(int argc, char **argv)
+{
+	int i, n;
+
+	if (argc > 1)
+		option_samplerate = atoi(argv[1]);
+
+	sound_test_seed(4);
+	build_sample_table();
+
+	memory_region_sound1 = sample_rom;
+	machine_sound_type = SOUND_YM2151_CPS1;
+
+	YM2151Init(3579545, irq_handler);
+	OKIM6295Init(1000000, 1);
+	YM2151Reset();
+	OKIM6295Reset();
+
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		n = sound_test_random() % 3;
+
+		while (n--)
+			write_command();
+
+		sound_test_render(1 + sound_test_random() % ((sound_test_random() & 1) ? 3000 : 200));
+		sound_test_hash(OKIM6295_status_r(0));
+	}
+
+	return sound_test_finish(argc > 2 ? argv[2] : NULL);
+}
@@ -0,0 +1,108 @@
+/******************************************************************************
+
+	test_qsound.c
+
+	QSound bit-exactness test
+
+******************************************************************************/
+
+#include "sound_test.h"
+#include "sound/qsound.h"
+
+#define SAMPLE_ROM_SIZE	0x800000
+#define ITERATIONS		20000
+
+
+/******************************************************************************
+	Emulator globals used by the QSound
+******************************************************************************/
+
+static struct driver_t test_driver = { .name = "test" };
+
+struct driver_t *driver = &test_driver;
+uint8_t *memory_region_sound1;
+uint32_t memory_length_sound1 = SAMPLE_ROM_SIZE;
+
+
+/******************************************************************************
+	Local Variables
+******************************************************************************/
+
+static uint8_t sample_rom[SAMPLE_ROM_SIZE];
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+/*--------------------------------------------------------
+	Channel registers: short samples and loops, so the
+	end address is crossed inside most blocks
+--------------------------------------------------------*/
+
+static void write_reg(void)
+{
+	int ch = sound_test_random() % 16;
+	int reg = sound_test_random() % 8;
+	int data = sound_test_random() & 0xffff;
+	int cmd;
+
+	switch (reg)
+	{
+	case 2:	/* pitch */
+		if (sound_test_random() & 1) data &= 0x3fff;
+		if ((sound_test_random() & 3) == 0) data = sound_test_random() % 0x40;
+		break;
+
+	case 4:	/* loop offset */
+		if (sound_test_random() & 1) data = sound_test_random() % 0x200;
+		break;
+
+	case 5:	/* end */
+		if (sound_test_random() & 1) data = sound_test_random() & 0xfff;
+		break;
+	}
+
+	if ((sound_test_random() & 7) == 0)
+	{
+		cmd = 0x80 + ch;	/* pan */
+		data = sound_test_random() & 0x3f;
+	}
+	else
+	{
+		cmd = (ch << 3) + reg;
+	}
+
+	qsound_data_h_w(0, data >> 8);
+	qsound_data_l_w(0, data & 0xff);
+	qsound_cmd_w(0, cmd);
+}
+
+
+/******************************************************************************
+	Main
+******************************************************************************/
+
+int main(int argc, char **argv)
+{
+	int i, n;
+
+	sound_test_seed(3);
+	sound_test_fill(sample_rom, SAMPLE_ROM_SIZE);
+	memory_region_sound1 = sample_rom;
+
+	qsound_sh_start();
+	qsound_sh_reset();
+
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		n = sound_test_random() % 8;
+
+		while (n--)
+			write_reg();
+
+		sound_test_render(1 + sound_test_random() % 1000);
+	}
+
+	return sound_test_finish(argc > 1 ? argv[1] : NULL);
+}
@@ -0,0 +1,107 @@
+/******************************************************************************
+
+	test_ym2151.c
+
+	YM2151 bit-exactness test
+
+******************************************************************************/
+
+#include "sound_test.h"
+#include "sound/ym2151.h"
+
+#define ITERATIONS		3000
+
+
+/******************************************************************************
+	Emulator functions used by the YM2151 (and the OKIM6295 it includes)
+******************************************************************************/
+
+uint8_t *memory_region_sound1 = NULL;
+uint32_t memory_length_sound1 = 0;
+
+
+int timer_enable(int which, int enable)
+{
+	return 0;
+}
+
+
+void timer_adjust(int which, float duration, int param, void (*callback)(int raram))
+{
+}
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+static void irq_handler(int irq)
+{
+}
+
+
+static void write_reg(void)
+{
+	int reg, data = sound_test_random() & 0xff;
+
+	switch (sound_test_random() % 16)
+	{
+	case 0: case 1: case 2:
+		YM2151WriteReg(0x08, data & 0x7f);			/* key on/off */
+		return;
+
+	case 3:
+		reg = 0x18 + (sound_test_random() & 3);		/* LFO, PMD/AMD, waveform */
+		if (reg == 0x1a) reg = 0x0f;				/* noise */
+		break;
+
+	case 4:
+		reg = 0x01;
+		data &= 0x02;								/* LFO reset */
+		break;
+
+	case 5: case 6:
+		reg = 0x20 + (sound_test_random() & 0x1f);	/* RL/FB/CONNECT, KC, KF, PMS/AMS */
+		break;
+
+	default:
+		reg = 0x40 + sound_test_random() % 0xc0;	/* operators */
+		if ((reg & 0xe0) == 0x60 && (sound_test_random() & 1))
+			data &= 0x1f;							/* keep TL audible */
+		break;
+	}
+
+	YM2151WriteReg(reg, data);
+}
+
+
+/******************************************************************************
+	Main
+******************************************************************************/
+
+int main(int argc, char **argv)
+{
+	int i, n;
+
+	if (argc > 1 && !strcmp(argv[1], "stereo"))
+		machine_sound_type = SOUND_YM2151_STEREO;
+	else
+		machine_sound_type = SOUND_YM2151_MONO;
+
+	sound_test_seed(2);
+
+	YM2151Init(3579545, irq_handler);
+	YM2151Reset();
+
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		n = sound_test_random() % 6;
+
+		while (n--)
+			write_reg();
+
+		sound_test_render(1 + sound_test_random() % 700);
+	}
+
+	return sound_test_finish(argc > 2 ? argv[2] : NULL);
+}
@@ -0,0 +1,204 @@
+/******************************************************************************
+
+	test_ym2610.c
+
+	YM2610 bit-exactness test (FM, ADPCM-A and ADPCM-B)
+
+******************************************************************************/
+
+#include "sound_test.h"
+#include "sound/ym2610.h"
+
+#define PCM_ROM_SIZE	0x100000
+#define ITERATIONS		3000
+
+
+/******************************************************************************
+	Emulator functions used by the YM2610
+******************************************************************************/
+
+int pcm_cache_enable = 0;
+
+uint8_t *pcm_cache_read(uint16_t new_block)
+{
+	return NULL;
+}
+
+
+float timer_get_time(void)
+{
+	return 0;
+}
+
+
+/******************************************************************************
+	Local Variables
+******************************************************************************/
+
+static uint8_t pcm_rom[PCM_ROM_SIZE];
+static int adpcma_start[6];
+
+
+/******************************************************************************
+	Local Functions
+******************************************************************************/
+
+static void timer_handler(int channel, int count, double step_time)
+{
+}
+
+
+static void irq_handler(int irq)
+{
+}
+
+
+static void write_reg(int port, int reg, int data)
+{
+	YM2610Write(port << 1, reg);
+	YM2610Write((port << 1) | 1, data);
+}
+
+
+/*--------------------------------------------------------
+	ADPCM-A: short samples that often end right after
+	they start, so the end of sample path is covered
+--------------------------------------------------------*/
+
+static void write_adpcma(void)
+{
+	int ch = sound_test_random() % 6;
+	int start, end;
+
+	switch (sound_test_random() % 16)
+	{
+	case 0: case 1: case 2:
+		start = sound_test_random() % 0x0f00;
+		adpcma_start[ch] = start;
+		write_reg(1, 0x10 + ch, start & 0xff);
+		write_reg(1, 0x18 + ch, start >> 8);
+		break;
+
+	case 3: case 4: case 5: case 6:
+		if ((sound_test_random() & 15) == 0)
+			end = sound_test_random() % 0x1000;
+		else
+			end = adpcma_start[ch] + sound_test_random() % 6;
+		write_reg(1, 0x20 + ch, end & 0xff);
+		write_reg(1, 0x28 + ch, end >> 8);
+		break;
+
+	case 7: case 8:
+		write_reg(1, 0x08 + ch, sound_test_random() & 0xdf);
+		break;
+
+	case 9:
+		write_reg(1, 0x01, sound_test_random() & 0x3f);
+		break;
+
+	case 10: case 11: case 12: case 13:
+		write_reg(1, 0x00, sound_test_random() & 0x3f);
+		break;
+
+	default:
+		write_reg(1, 0x00, 0x80 | (sound_test_random() & 0x3f));
+		break;
+	}
+}
+
+
+static void write_adpcmb(void)
+{
+	int start = sound_test_random() % 0x0f00;
+	int end = start + sound_test_random() % 0x40;
+
+	switch (sound_test_random() % 6)
+	{
+	case 0:
+		write_reg(0, 0x12, start & 0xff);
+		write_reg(0, 0x13, start >> 8);
+		write_reg(0, 0x14, end & 0xff);
+		write_reg(0, 0x15, end >> 8);
+		break;
+
+	case 1:
+		write_reg(0, 0x19, sound_test_random() & 0xff);
+		write_reg(0, 0x1a, sound_test_random() & 0xff);
+		break;
+
+	case 2:
+		write_reg(0, 0x1b, sound_test_random() & 0xff);
+		break;
+
+	case 3:
+		write_reg(0, 0x11, sound_test_random() & 0xc0);
+		break;
+
+	case 4:
+		write_reg(0, 0x10, 0x80 | (sound_test_random() & 0x10));
+		break;
+
+	default:
+		write_reg(0, 0x10, 0x01);
+		break;
+	}
+}
+
+
+static void write_fm(void)
+{
+	int port = sound_test_random() & 1;
+	int reg = 0x30 + sound_test_random() % 0x90;
+	int data = sound_test_random() & 0xff;
+
+	/* keep the total level audible half of the time */
+	if (reg >= 0x40 && reg < 0x50 && (sound_test_random() & 1))
+		data &= 0x1f;
+
+	write_reg(port, reg, data);
+}
+
+
+/******************************************************************************
+	Main
+******************************************************************************/
+
+int main(int argc, char **argv)
+{
+	int i, n, k;
+
+	sound_test_seed(1);
+	sound_test_fill(pcm_rom, PCM_ROM_SIZE);
+
+	YM2610Init(8000000, pcm_rom, PCM_ROM_SIZE, pcm_rom, PCM_ROM_SIZE, timer_handler, irq_handler);
+	YM2610Reset();
+
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		n = sound_test_random() % 6;
+
+		while (n--)
+		{
+			k = sound_test_random() % 32;
+
+			if (k < 4)
+				write_reg(0, 0x28, sound_test_random() & 0xf7);	/* key on/off */
+			else if (k < 6)
+				write_reg(0, 0x22, sound_test_random() & 0x0f);	/* LFO */
+			else if (k < 7)
+				write_reg(0, 0x27, sound_test_random() & 0x40);	/* CSM / channel 3 mode */
+			else if (k < 8)
+				write_reg(0, 0xa8 + sound_test_random() % 3, sound_test_random());
+			else if (k < 16)
+				write_adpcma();
+			else if (k < 18)
+				write_adpcmb();
+			else
+				write_fm();
+		}
+
+		sound_test_render(1 + sound_test_random() % 700);
+	}
+
+	return sound_test_finish(argc > 1 ? argv[1] : NULL);
+}